@@ -7,117 +7,572 @@
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <signal.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/tracker.h"
 #include "../inc/logger.h"
 #include "../inc/enums.h"
+#include "../inc/scheduler.h"
+
+// MACRO DEFINITION
+#define DEFAULT_INTERVAL 1000
+#define DEFAULT_SEGMENT_KB 4096
+#define DEFAULT_SEGMENTS 4
+#define OUTPUTS 8
+#define ADDRESS_SIZE 16
+
+// STRUCTURE FOR HOLDING SINKS GIVEN BY -o OPTION, PATH IS NULL FOR STANDARD OUTPUT
+typedef struct Outputs {
+    char const* paths[OUTPUTS];
+    int formats[OUTPUTS];
+    int count;
+    char padding[4];
+} Outputs;
+
+// STRUCTURE FOR HOLDING AN ADDRESS GIVEN BY -m OPTION, PORT IS 0 WHEN NO METRICS ARE SERVED
+typedef struct Endpoint {
+    char address[ADDRESS_SIZE];
+    uint16_t port;
+    char padding[6];
+} Endpoint;
 
 // PROTOTYPE FUNCTIONS DECLARATIONS
 void handle_signal(int const);
+static int parse_options(int const, char* const[], long* const, int* const, int* const, int* const, Outputs* const, Endpoint* const, char const** const);
+static int parse_output(char const* const, Outputs* const);
+static int parse_endpoint(char const* const, Endpoint* const);
+static int daemonize(char const* const, int* const);
+static void undaemonize(char const* const, int const, int const);
+static void release_tracker(void);
 
 // GLOBAL VARIABLES DECLARATIONS
 static Tracker* tracker;
+static FILE* console;
+static volatile sig_atomic_t signaled;
+
+// NAMES OF LOG LEVELS ACCEPTED BY -l OPTION, IN LOG_LEVEL_* ORDER
+static char const* const LEVEL_NAMES[] = { "trace", "debug", "info", "warn", "error", "off" };
+
+// NAMES OF SINK FORMATS ACCEPTED BY -o OPTION, IN SINK_* ORDER
+static char const* const FORMAT_NAMES[] = { "json", "csv", "binary" };
 
 /*
     METHOD: handle_signal
     ARGUMENTS: 
         signum - id of a received signal
-    PURPOSE: invocation of behaviour reserved for sigterm and sigint signal
+    PURPOSE: invocation of behaviour reserved for sigterm and sigint signal,
+        only async-signal-safe calls, so logging is left to main
     RETURN: nothing
 */
 void handle_signal(
     int const signum
 ) {
-    Logger_log("MAIN", "HANDLE SIGNAL STARTED");
-
     if (
         signum == SIGINT || 
         signum == SIGTERM
     ) {
-        printf("\n");
-        Tracker_terminate(tracker);
+        signaled = signum;
+        Tracker_signal(tracker);
     }
+}
+
+/*
+    METHOD: release_tracker
+    ARGUMENTS: none
+    PURPOSE: destruction of tracker once signal handler can no longer 
+        reach it, its pointer is cleared while signals are blocked, 
+        so a late signal finds no tracker instead of a freed one
+    RETURN: nothing
+*/
+static void release_tracker(
+    void
+) {
+    Tracker* released;
+    sigset_t signals;
+    sigset_t previous;
+
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+
+    pthread_sigmask(SIG_BLOCK, &signals, &previous);
+
+    released = tracker;
+    tracker = NULL;
 
-    Logger_log("MAIN", "HANDLE SIGNAL STARTED");
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    Tracker_destroy(released);
+}
+
+/*
+    METHOD: parse_options
+    ARGUMENTS:
+        argc - number of programme's arguments
+        argv - programme's arguments
+        interval - sampling interval in milliseconds, set by -i option
+        mode - tracker mode, TRACKER_EVENT when -e option is given,
+            TRACKER_HEADLESS when -H or -D option is given
+        level - lowest log level written, set by -l option
+        layout - printer layout, PRINTER_HEATMAP when -d option is given,
+            PRINTER_NONE when a sink writes to standard output
+        outputs - sinks given by -o options
+        endpoint - address metrics are served on, given by -m option
+        pidfile - pidfile given by -D option, NULL when it is not a daemon
+    PURPOSE: reading of command line options, log rotation 
+        set by -s and -k options is handed to logger at once
+    RETURN: enums integer value
+*/
+static int parse_options(
+    int const argc,
+    char* const argv[],
+    long* const interval,
+    int* const mode,
+    int* const level,
+    int* const layout,
+    Outputs* const outputs,
+    Endpoint* const endpoint,
+    char const** const pidfile
+) {
+    char* end;
+    long segment_kb;
+    long segments;
+    bool headless;
+    int option;
+
+    *interval = DEFAULT_INTERVAL;
+    *mode = TRACKER_THREADED;
+    *level = LOG_LEVEL;
+    *layout = PRINTER_BARS;
+    outputs -> count = 0;
+    endpoint -> port = 0;
+    *pidfile = NULL;
+    headless = false;
+    segment_kb = DEFAULT_SEGMENT_KB;
+    segments = DEFAULT_SEGMENTS;
+
+    while ((option = getopt(argc, argv, "i:edl:s:k:o:m:HD:")) != -1) {
+        switch (option) {
+            case 'i':
+                *interval = strtol(optarg, &end, 10);
+
+                if (
+                    *end != '\0' || 
+                    *interval < SCHEDULER_MIN_INTERVAL || 
+                    *interval > SCHEDULER_MAX_INTERVAL
+                ) { return ERR_PARAMS; }
+                break;
+            case 'e':
+                *mode = TRACKER_EVENT;
+                break;
+            case 'd':
+                *layout = PRINTER_HEATMAP;
+                break;
+            case 'l':
+                *level = -1;
+
+                for (int i = LOG_LEVEL_TRACE; i <= LOG_LEVEL_OFF; i++) {
+                    if (strcmp(optarg, LEVEL_NAMES[i]) == 0) { *level = i; }
+                }
+
+                if (*level < 0) { return ERR_PARAMS; }
+                break;
+            case 's':
+                segment_kb = strtol(optarg, &end, 10);
+
+                if (*end != '\0' || segment_kb < 1 || segment_kb > 1024 * 1024) { return ERR_PARAMS; }
+                break;
+            case 'k':
+                segments = strtol(optarg, &end, 10);
+
+                if (*end != '\0') { return ERR_PARAMS; }
+                break;
+            case 'o':
+                if (parse_output(optarg, outputs) != OK) { return ERR_PARAMS; }
+                break;
+            case 'm':
+                if (parse_endpoint(optarg, endpoint) != OK) { return ERR_PARAMS; }
+                break;
+            case 'H':
+                headless = true;
+                break;
+            case 'D':
+                headless = true;
+                *pidfile = optarg;
+                break;
+            default:
+                return ERR_PARAMS;
+        }
+    }
+
+    // FRAMES WOULD BE MIXED INTO RECORDS OF A SINK WRITING TO STANDARD OUTPUT,
+    // WHICH A DAEMON POINTS TO /DEV/NULL, A HEADLESS ONE HAS ONLY ITS SINKS
+    for (int i = 0; i < outputs -> count; i++) {
+        if (outputs -> paths[i] == NULL && *pidfile != NULL) { return ERR_PARAMS; }
+        if (outputs -> paths[i] == NULL) { *layout = PRINTER_NONE; }
+    }
+
+    // A HEADLESS ONE WITHOUT SINKS IS ONLY WORTH RUNNING WHEN IT IS SCRAPED
+    if (headless && outputs -> count == 0 && endpoint -> port == 0) { return ERR_PARAMS; }
+
+    if (headless) {
+        *mode = TRACKER_HEADLESS;
+        *layout = PRINTER_NONE;
+    }
+
+    return Logger_setRotation((size_t) segment_kb * 1024, (int) (segments > 99 ? 0 : segments));
+}
+
+/*
+    METHOD: parse_output
+    ARGUMENTS:
+        option - argument of -o option, FORMAT or FORMAT:PATH,
+            standard output when there is no PATH or it is -
+        outputs - where a sink is saved
+    PURPOSE: reading of a sink given by -o option
+    RETURN: enums integer value
+*/
+static int parse_output(
+    char const* const option,
+    Outputs* const outputs
+) {
+    char const* separator;
+    size_t length;
+    int format;
+
+    if (outputs -> count == OUTPUTS) { return ERR_PARAMS; }
+
+    separator = strchr(option, ':');
+    length = separator == NULL ? strlen(option) : (size_t) (separator - option);
+    format = -1;
+
+    for (int i = SINK_JSON; i <= SINK_BINARY; i++) {
+        if (strlen(FORMAT_NAMES[i]) == length && strncmp(option, FORMAT_NAMES[i], length) == 0) { format = i; }
+    }
+
+    if (format < 0 || (separator != NULL && separator[1] == '\0')) { return ERR_PARAMS; }
+
+    outputs -> formats[outputs -> count] = format;
+    outputs -> paths[outputs -> count] = separator == NULL || strcmp(separator + 1, "-") == 0 ? NULL : separator + 1;
+    outputs -> count++;
+
+    return OK;
+}
+
+/*
+    METHOD: parse_endpoint
+    ARGUMENTS:
+        option - argument of -m option, ADDRESS:PORT, 
+            a local IPv4 address and a port from 1 to 65535
+        endpoint - where an address and a port are saved
+    PURPOSE: reading of an address metrics are served on,
+        an address itself is checked when it is bound
+    RETURN: enums integer value
+*/
+static int parse_endpoint(
+    char const* const option,
+    Endpoint* const endpoint
+) {
+    char const* separator;
+    char* end;
+    long port;
+
+    separator = strrchr(option, ':');
+
+    if (separator == NULL || separator == option || (size_t) (separator - option) >= ADDRESS_SIZE) { return ERR_PARAMS; }
+
+    port = strtol(separator + 1, &end, 10);
+
+    if (separator[1] == '\0' || *end != '\0' || port < 1 || port > UINT16_MAX) { return ERR_PARAMS; }
+
+    memcpy(endpoint -> address, option, (size_t) (separator - option));
+    endpoint -> address[separator - option] = '\0';
+    endpoint -> port = (uint16_t) port;
+
+    return OK;
+}
+
+/*
+    METHOD: daemonize
+    ARGUMENTS:
+        pidfile - a file id of a daemon is written to
+        ready - where a pipe is saved, a byte written to it tells 
+            the starting process the daemon runs, closing it that it failed
+    PURPOSE: detaching of the programme from its controlling terminal,
+        forked twice so it is not a session leader and never gets one 
+        back, its pidfile is locked while it runs, so a second daemon 
+        refuses to start, standard streams point to /dev/null, working 
+        directory is kept so logs and sinks of relative paths stay put,
+        starting process waits for a byte and exits with 0 only then
+    RETURN: descriptor of a locked pidfile, -1 when it was not possible
+*/
+static int daemonize(
+    char const* const pidfile,
+    int* const ready
+) {
+    char text[24];
+    char byte;
+    pid_t pid;
+    int pipes[2];
+    int length;
+    int null;
+    int fd;
+
+    if (pipe(pipes) != 0) { return -1; }
+
+    pid = fork();
+
+    if (pid < 0) { 
+        close(pipes[0]);
+        close(pipes[1]);
+        return -1; 
+    }
+
+    if (pid > 0) {
+        close(pipes[1]);
+        _exit(read(pipes[0], &byte, 1) == 1 ? 0 : 1);
+    }
+
+    close(pipes[0]);
+
+    if (setsid() < 0) { return -1; }
+
+    signal(SIGHUP, SIG_IGN);
+
+    pid = fork();
+
+    if (pid < 0) { return -1; }
+    if (pid > 0) { _exit(0); }
+
+    umask(022);
+
+    fd = open(pidfile, O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+
+    if (fd < 0) { return -1; }
+
+    length = snprintf(text, sizeof(text), "%ld\n", (long) getpid());
+
+    if (
+        flock(fd, LOCK_EX | LOCK_NB) != 0 || 
+        ftruncate(fd, 0) != 0 || 
+        write(fd, text, (size_t) length) != length
+    ) {
+        fprintf(stderr, "[MAIN]: PIDFILE %s IS LOCKED OR NOT WRITABLE\n", pidfile);
+        close(fd);
+        return -1;
+    }
+
+    null = open("/dev/null", O_RDWR);
+
+    if (
+        null < 0 || 
+        dup2(null, STDIN_FILENO) < 0 || 
+        dup2(null, STDOUT_FILENO) < 0 || 
+        dup2(null, STDERR_FILENO) < 0
+    ) {
+        undaemonize(pidfile, fd, -1);
+        return -1;
+    }
+
+    if (null > STDERR_FILENO) { close(null); }
+
+    *ready = pipes[1];
+
+    return fd;
+}
+
+/*
+    METHOD: undaemonize
+    ARGUMENTS:
+        pidfile - a pidfile of a daemon, NULL when it is not a daemon
+        fd - a descriptor of a locked pidfile
+        ready - a pipe of a starting process, -1 once it was told
+    PURPOSE: removal of a pidfile of a daemon which is finishing,
+        a starting process still waiting learns the daemon failed
+    RETURN: nothing
+*/
+static void undaemonize(
+    char const* const pidfile,
+    int const fd,
+    int const ready
+) {
+    if (pidfile == NULL) { return; }
+    if (ready >= 0) { close(ready); }
+
+    unlink(pidfile);
+    close(fd);
 }
 
 /*
     METHOD: main
-    ARGUMENTS: none
+    ARGUMENTS:
+        argc - number of programme's arguments
+        argv - programme's arguments
     PURPOSE: invocation of behaviour expected from Tracker and Logger objects
     RETURN: an integer number describing correction 
         of this function's execution
 */
 int main(
-    void
+    int argc,
+    char* argv[]
 ) {
-    printf("STARTING PROGRAMME...\n");
+    long interval;
+    int mode;
+    int level;
+    int layout;
+    int result;
+    int pidfd;
+    int ready;
+    Outputs outputs;
+    Endpoint endpoint;
+    struct sigaction action;
+    sigset_t previous;
+    char const* pidfile;
+
+    if (parse_options(argc, argv, &interval, &mode, &level, &layout, &outputs, &endpoint, &pidfile) != OK) {
+        printf(
+            "USAGE: %s [-i INTERVAL_MS (%d-%d)] [-e] [-d] [-l trace|debug|info|warn|error|off] [-s SEGMENT_KB] [-k SEGMENTS (1-99)] [-o json|csv|binary[:PATH]]... [-m ADDRESS:PORT] [-H] [-D PIDFILE]\n", 
+            argv[0], SCHEDULER_MIN_INTERVAL, SCHEDULER_MAX_INTERVAL
+        );
+        return -1;
+    }
+
+    pidfd = -1;
+    ready = -1;
+
+    // DETACHED BEFORE ANY THREAD EXISTS, AS ONLY A FORKING THREAD SURVIVES A FORK
+    if (pidfile != NULL && (pidfd = daemonize(pidfile, &ready)) < 0) { return -1; }
+
+    // STANDARD OUTPUT BELONGS TO RECORDS WHEN NO FRAMES ARE DRAWN
+    console = layout == PRINTER_NONE ? stderr : stdout;
+
+    Logger_setLevel(level);
+
+    fprintf(console, "STARTING PROGRAMME...\n");
 
-    signal(SIGINT, handle_signal);
-    signal(SIGTERM, handle_signal);
+    // OTHER SIGNAL IS BLOCKED WHILE ONE IS HANDLED, INTERRUPTED CALLS ARE RESTARTED
+    action = (struct sigaction) { .sa_handler = handle_signal, .sa_flags = SA_RESTART };
+    sigemptyset(&(action.sa_mask));
+    sigaddset(&(action.sa_mask), SIGINT);
+    sigaddset(&(action.sa_mask), SIGTERM);
+
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
 
     if (Logger_init() != OK) {
-        printf("[MAIN]: ERROR WHEN CREATING LOGGER\n");
+        fprintf(console, "[MAIN]: ERROR WHEN CREATING LOGGER\n");
+        undaemonize(pidfile, pidfd, ready);
         return -1;
     }
 
-    if (Logger_start() != OK) {
-        printf("[MAIN]: ERROR WHEN STARTING LOGGER\n");
+    // EVENT LOOP WRITES LOGS ITSELF, WITHOUT A LOGGER THREAD, WHICH IS STARTED WITH SIGNALS BLOCKED, 
+    // AS IT OUTLIVES TRACKER AND ITS HANDLER WOULD RACE WITH RELEASE_TRACKER
+    pthread_sigmask(SIG_BLOCK, &(action.sa_mask), &previous);
+    result = mode == TRACKER_THREADED ? Logger_start() : OK;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    if (result != OK) {
+        fprintf(console, "[MAIN]: ERROR WHEN STARTING LOGGER\n");
         Logger_destroy();
+        undaemonize(pidfile, pidfd, ready);
         return -1;
     }
 
-    Logger_log("MAIN", "PROGRAMME STARTED");
+    LOG_INFO("MAIN", "PROGRAMME STARTED");
 
-    tracker = Tracker_init();
+    tracker = Tracker_init(interval, mode);
 
     if (tracker == NULL) { 
-        Logger_log("MAIN", "ERROR WHEN CREATING TRACKER");
+        LOG_ERROR("MAIN", "ERROR WHEN CREATING TRACKER");
         Logger_terminate();
 
         if (Logger_join() != OK) {
-            printf("[MAIN]: ERROR WHEN JOINING LOGGER\n");
+            fprintf(console, "[MAIN]: ERROR WHEN JOINING LOGGER\n");
         }
 
         Logger_destroy();
+        undaemonize(pidfile, pidfd, ready);
 
         return -1; 
     }
 
-    if (Tracker_start(tracker) != OK) { 
-        Logger_log("MAIN", "ERROR WHEN STARTING TRACKER");
+    result = mode == TRACKER_HEADLESS ? OK : Tracker_setLayout(tracker, layout);
+
+    for (int i = 0; i < outputs.count && result == OK; i++) {
+        result = Tracker_addSink(tracker, outputs.formats[i], outputs.paths[i]);
+    }
+
+    if (result == OK && endpoint.port != 0) {
+        result = Tracker_serveMetrics(tracker, endpoint.address, endpoint.port);
+
+        if (result != OK) { fprintf(console, "[MAIN]: COULD NOT SERVE METRICS ON %s:%u\n", endpoint.address, endpoint.port); }
+    }
+
+    // EVERY SINK IS OPEN AND METRICS ARE LISTENED FOR, SO A STARTING PROCESS OF A DAEMON CAN REPORT SUCCESS
+    if (result == OK && ready >= 0) {
+        if (write(ready, "", 1) != 1) { LOG_WARN("MAIN", "STARTING PROCESS NOT TOLD"); }
 
-        Tracker_destroy(tracker);
+        close(ready);
+        ready = -1;
+    }
+
+    // A SIGNAL BEFORE TRACKER EXISTED FOUND NOTHING TO STOP, SO IT IS NOT STARTED AT ALL,
+    // ONE AFTER THIS CHECK LEAVES IT TERMINATED, SO START REFUSES IT, BOTH ARE A NORMAL STOP
+    if (result == OK && signaled == 0) { 
+        result = Tracker_start(tracker); 
+
+        if (result != OK && signaled != 0) { result = OK; }
+    }
+
+    if (result != OK) { 
+        LOG_ERROR("MAIN", "ERROR WHEN STARTING TRACKER");
+
+        release_tracker();
 
         Logger_terminate();
 
         if (Logger_join() != OK) {
-            printf("[MAIN]: ERROR WHEN JOINING LOGGER\n");
+            fprintf(console, "[MAIN]: ERROR WHEN JOINING LOGGER\n");
         }
 
         Logger_destroy();
+        undaemonize(pidfile, pidfd, ready);
 
         return -1; 
     }
 
-    Tracker_destroy(tracker);
+    if (signaled != 0) {
+        fprintf(console, "\n");
+        LOG_INFO("MAIN", "SIGNAL %d RECEIVED", (int) signaled);
+    }
+
+    release_tracker();
 
-    printf("LOGGING REMAINING LOGS...\n");
+    fprintf(console, "LOGGING REMAINING LOGS...\n");
 
-    Logger_log("MAIN", "PROGRAMME FINISHED");
+    LOG_INFO("MAIN", "PROGRAMME FINISHED");
     Logger_terminate();
 
     if (Logger_join() != OK) {
-        printf("[MAIN]: ERROR WHEN JOINING LOGGER\n");
+        fprintf(console, "[MAIN]: ERROR WHEN JOINING LOGGER\n");
         Logger_destroy();
+        undaemonize(pidfile, pidfd, ready);
         return -1;
     }
 
     Logger_destroy();
+    undaemonize(pidfile, pidfd, ready);
 
-    printf("PROGRAMME FINISHED !\n");
+    fprintf(console, "PROGRAMME FINISHED !\n");
     
     return 0;
 }
@@ -0,0 +1,200 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute_bench.c                       
+    PURPOSE: benchmarking compute module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <string.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "compute_bench.h"
+#include "reader_bench.h"
+#include "../inc/compute.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define ROWS 257
+#define SAMPLES 16
+#define ITERATIONS 20000
+
+// STRUCTURE FOR HOLDING ONE CORE'S COUNTERS, LAYOUT USED BEFORE COLUMNS
+typedef struct RowStats {
+    uint64_t counters[COLUMNS];
+} RowStats;
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_computeRows(RowStats const* const, RowStats* const, uint64_t* const, uint64_t* const, float* const);
+static void bench_computeKernel(uint64_t const* const, int const, char const* const, float const* const);
+
+/*
+    METHOD: bench_computeRows
+    ARGUMENTS:
+        rows - counters stored one core structure after another
+        previous - counters of previous sample
+        total_prev - totals of previous sample
+        idle_prev - idle times of previous sample
+        percentages - usage percentage of every row followed 
+            by a block of every counter's percentage
+    PURPOSE: percentages counted over array of structures, 
+        as analyzer did it before columns
+    RETURN: nothing
+*/
+static void bench_computeRows(
+    RowStats const* const rows,
+    RowStats* const previous,
+    uint64_t* const total_prev,
+    uint64_t* const idle_prev,
+    float* const percentages
+) {
+    uint64_t idle;
+    uint64_t total;
+    uint64_t idled;
+    uint64_t delta;
+
+    for (size_t row = 0; row < ROWS; row++) {
+        idle = rows[row].counters[COLUMN_IDLE] + rows[row].counters[COLUMN_IOWAIT];
+        total = idle 
+            + rows[row].counters[COLUMN_USER] 
+            + rows[row].counters[COLUMN_NICE] 
+            + rows[row].counters[COLUMN_SYSTEM]
+            + rows[row].counters[COLUMN_IRQ] 
+            + rows[row].counters[COLUMN_SOFTIRQ] 
+            + rows[row].counters[COLUMN_STEAL];
+
+        idled = idle - idle_prev[row];
+        delta = total - total_prev[row];
+        percentages[row] = delta != 0 ? (float) (delta - idled) / (float) delta * 100.0f : 0.0f;
+
+        for (size_t column = 0; column < COLUMNS; column++) {
+            percentages[(column + 1) * ROWS + row] = delta != 0 
+                ? (float) (rows[row].counters[column] - previous[row].counters[column]) / (float) delta * 100.0f 
+                : 0.0f;
+        }
+
+        previous[row] = rows[row];
+
+        total_prev[row] = total;
+        idle_prev[row] = idle;
+    }
+}
+
+/*
+    METHOD: bench_computeKernel
+    ARGUMENTS:
+        columns - consecutive samples of counters stored as columns
+        type - kernel to be measured
+        label - name printed next to the result
+        expected - percentages of array of structures layout
+    PURPOSE: measuring mean time of one sample through a given kernel
+        and checking its results against array of structures layout
+    RETURN: nothing
+*/
+static void bench_computeKernel(
+    uint64_t const* const columns,
+    int const type,
+    char const* const label,
+    float const* const expected
+) {
+    ComputeKernel kernel;
+    uint64_t prev[COMPUTE_PREV_BLOCKS * ROWS];
+    float percentages[COMPUTE_OUT_BLOCKS * ROWS];
+    uint64_t start;
+    uint64_t elapsed;
+
+    kernel = Compute_kernel(type);
+
+    if (kernel == NULL) {
+        printf("%-40s NOT SUPPORTED\n", label);
+        return;
+    }
+
+    start = bench_now();
+
+    // SAMPLES ARE REPLAYED, FIRST ONE OF EVERY ROUND IS A NEW BASELINE
+    for (int i = 0; i < ITERATIONS; i++) {
+        if (i % SAMPLES == 0) {
+            Compute_baseline(columns, ROWS, ROWS, prev);
+            continue;
+        }
+
+        kernel(&columns[(size_t) (i % SAMPLES) * COLUMNS * ROWS], ROWS, ROWS, prev, percentages);
+    }
+
+    elapsed = bench_now() - start;
+
+    printf("%-40s %10.1f ns/sample %s\n", label, (double) elapsed / ITERATIONS, 
+        memcmp(percentages, expected, sizeof(percentages)) == 0 ? "" : "MISMATCH");
+}
+
+/*
+    METHOD: bench_compute
+    ARGUMENTS: none
+    PURPOSE: comparison of array of structures scalar loop with columns 
+        through scalar, SSE2 and AVX2 kernels, usage and every counter's 
+        percentage for 256 cores
+        over a few samples of a busy machine, small enough for cache
+    RETURN: nothing
+*/
+void bench_compute(
+    void
+) {
+    RowStats* rows;
+    RowStats previous[ROWS];
+    uint64_t* columns;
+    uint64_t total_prev[ROWS];
+    uint64_t idle_prev[ROWS];
+    float expected[COMPUTE_OUT_BLOCKS * ROWS];
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t value;
+
+    printf("Starting compute benchmark...\n");
+
+    rows = malloc(sizeof(RowStats) * ROWS * SAMPLES);
+    columns = malloc(sizeof(uint64_t) * COLUMNS * ROWS * SAMPLES);
+
+    if (rows == NULL || columns == NULL) {
+        printf("%-40s SETUP FAILED\n", "compute");
+        free(rows);
+        free(columns);
+        return;
+    }
+
+    for (size_t sample = 0; sample < SAMPLES; sample++) {
+        for (size_t row = 0; row < ROWS; row++) {
+            for (size_t column = 0; column < COLUMNS; column++) {
+                value = 1000000u + row * 977u + column * 131u + sample * ((row * 7u + column * 13u) % 50u);
+
+                rows[sample * ROWS + row].counters[column] = value;
+                columns[(sample * COLUMNS + column) * ROWS + row] = value;
+            }
+        }
+    }
+
+    memset(previous, 0, sizeof(previous));
+    memset(total_prev, 0, sizeof(total_prev));
+    memset(idle_prev, 0, sizeof(idle_prev));
+
+    start = bench_now();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        bench_computeRows(&rows[(size_t) (i % SAMPLES) * ROWS], previous, total_prev, idle_prev, expected);
+    }
+
+    elapsed = bench_now() - start;
+
+    printf("%-40s %10.1f ns/sample\n", "256 cpu structures scalar", (double) elapsed / ITERATIONS);
+
+    bench_computeKernel(columns, COMPUTE_SCALAR, "256 cpu columns scalar", expected);
+    bench_computeKernel(columns, COMPUTE_SSE2, "256 cpu columns SSE2", expected);
+    bench_computeKernel(columns, COMPUTE_AVX2, "256 cpu columns AVX2", expected);
+
+    free(rows);
+    free(columns);
+
+    printf("Compute benchmark finished !\n");
+}
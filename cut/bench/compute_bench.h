@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute_bench.h                       
+    PURPOSE: interface for compute benchmark module 
+*/
+
+#ifndef COMPUTE_BENCH
+#define COMPUTE_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_compute(void);
+
+#endif 
@@ -0,0 +1,269 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: log_bench.c                       
+    PURPOSE: benchmarking cpu time per tick of tracker with every 
+        compiled in log written against one with logging turned off,
+        building with LOG_LEVEL=TRACE shows what hot path logs cost,
+        and time a single log call takes its caller, deferred binary 
+        records against messages formatted by a caller
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <inttypes.h>      
+#include <pthread.h>      
+#include <unistd.h>      
+#include <fcntl.h>      
+#include <sys/stat.h>      
+#include <sys/resource.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "log_bench.h"
+#include "../inc/tracker.h"
+#include "../inc/logger.h"
+#include "../inc/buffer.h"
+#include "../inc/scheduler.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define INTERVAL 10
+#define TICKS 200
+#define BURST 256
+#define BURSTS 100
+#define MESSAGE_SIZE 256
+#define FORMATTED_CAPACITY 100
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* bench_logsRunner(void* const);
+static void bench_logsLevel(int const, char const* const);
+static void bench_logsDeferred(void);
+static void* bench_logsWriter(void* const);
+static void bench_logsFormatted(void);
+
+// NAMES OF LOG LEVELS, IN LOG_LEVEL_* ORDER
+static char const* const LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+
+/*
+    METHOD: bench_logsRunner
+    ARGUMENTS:
+        args - a tracker to be run
+    PURPOSE: thread running a tracker until it gets terminated
+    RETURN: NULL
+*/
+static void* bench_logsRunner(
+    void* const args
+) {
+    Tracker_start((Tracker*) args);
+
+    return NULL;
+}
+
+/*
+    METHOD: bench_logsLevel
+    ARGUMENTS:
+        level - lowest log level written at runtime
+        label - name printed next to the result
+    PURPOSE: measuring cpu time per tick of an event loop tracker,
+        which formats and writes its logs on its own thread
+    RETURN: nothing
+*/
+static void bench_logsLevel(
+    int const level,
+    char const* const label
+) {
+    Tracker* tracker;
+    pthread_t thread;
+    struct rusage before;
+    struct rusage after;
+    double cpu;
+    int out;
+    int null;
+
+    Logger_setLevel(level);
+
+    tracker = Tracker_init(INTERVAL, TRACKER_EVENT);
+
+    if (tracker == NULL) {
+        printf("%-10s SETUP FAILED\n", label);
+        return;
+    }
+
+    // FRAMES ARE NOT PART OF THE RESULT
+    fflush(stdout);
+    out = dup(STDOUT_FILENO);
+    null = open("/dev/null", O_WRONLY);
+    dup2(null, STDOUT_FILENO);
+
+    getrusage(RUSAGE_SELF, &before);
+
+    if (pthread_create(&thread, NULL, bench_logsRunner, tracker) == 0) {
+        usleep(INTERVAL * TICKS * 1000);
+        Tracker_terminate(tracker);
+        pthread_join(thread, NULL);
+    }
+
+    getrusage(RUSAGE_SELF, &after);
+
+    Tracker_destroy(tracker);
+
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+    close(null);
+
+    cpu = (double) (after.ru_utime.tv_sec - before.ru_utime.tv_sec + after.ru_stime.tv_sec - before.ru_stime.tv_sec) * 1e6
+        + (double) (after.ru_utime.tv_usec - before.ru_utime.tv_usec + after.ru_stime.tv_usec - before.ru_stime.tv_usec);
+
+    printf("%-10s %10.1f us cpu/tick\n", label, cpu / TICKS);
+}
+
+/*
+    METHOD: bench_logsDeferred
+    ARGUMENTS: none
+    PURPOSE: measuring time a caller spends in a single log call, 
+        with logger thread formatting and writing records, bursts 
+        are spaced so logger drains them between, as it does normally
+    RETURN: nothing
+*/
+static void bench_logsDeferred(
+    void
+) {
+    uint64_t spent;
+    uint64_t start;
+
+    Logger_setLevel(LOG_LEVEL_TRACE);
+
+    if (Logger_init() != OK || Logger_start() != OK) {
+        printf("%-10s SETUP FAILED\n", "deferred");
+        return;
+    }
+
+    spent = 0;
+
+    for (int burst = 0; burst < BURSTS; burst++) {
+        start = Scheduler_now();
+
+        for (uint64_t i = 0; i < BURST; i++) {
+            LOG_ERROR("BENCH", "RECORD %" PRIu64 " OF BURST %d", i, burst);
+        }
+
+        spent += Scheduler_now() - start;
+
+        usleep(12000);
+    }
+
+    Logger_terminate();
+    Logger_join();
+    Logger_destroy();
+
+    printf("%-10s %10.1f ns/call\n", "deferred", (double) spent / (BURSTS * BURST));
+}
+
+/*
+    METHOD: bench_logsWriter
+    ARGUMENTS:
+        args - a buffer of formatted messages
+    PURPOSE: writer of formatted messages, as logger thread 
+        did before records were deferred
+    RETURN: NULL
+*/
+static void* bench_logsWriter(
+    void* const args
+) {
+    static char messages[MESSAGE_SIZE * 32];
+    FILE* file;
+    size_t popped;
+
+    file = fopen("/dev/null", "w");
+
+    while (Buffer_popN((Buffer*) args, messages, 32, &popped) == OK) {
+        for (size_t i = 0; i < popped; i++) { fprintf(file, "%s\n", messages + i * MESSAGE_SIZE); }
+
+        fflush(file);
+    }
+
+    fclose(file);
+
+    return NULL;
+}
+
+/*
+    METHOD: bench_logsFormatted
+    ARGUMENTS: none
+    PURPOSE: measuring time a caller spends in a single log call 
+        formatted by a caller into a fixed size message and pushed 
+        through a shared buffer, as logger did before
+    RETURN: nothing
+*/
+static void bench_logsFormatted(
+    void
+) {
+    char info[MESSAGE_SIZE / 2];
+    char message[MESSAGE_SIZE];
+    Buffer* buffer;
+    pthread_t thread;
+    uint64_t spent;
+    uint64_t start;
+
+    buffer = Buffer_init(MESSAGE_SIZE, FORMATTED_CAPACITY, BUFFER_MPMC);
+
+    if (buffer == NULL || pthread_create(&thread, NULL, bench_logsWriter, buffer) != 0) {
+        printf("%-10s SETUP FAILED\n", "formatted");
+        Buffer_destroy(buffer);
+        return;
+    }
+
+    spent = 0;
+
+    for (int burst = 0; burst < BURSTS; burst++) {
+        start = Scheduler_now();
+
+        for (uint64_t i = 0; i < BURST; i++) {
+            snprintf(info, sizeof(info), "RECORD %" PRIu64 " OF BURST %d", i, burst);
+            snprintf(message, sizeof(message), "[%s]: %s", "BENCH", info);
+            Buffer_push(buffer, message);
+        }
+
+        spent += Scheduler_now() - start;
+
+        usleep(12000);
+    }
+
+    Buffer_close(buffer);
+    pthread_join(thread, NULL);
+    Buffer_destroy(buffer);
+
+    printf("%-10s %10.1f ns/call\n", "formatted", (double) spent / (BURSTS * BURST));
+}
+
+/*
+    METHOD: bench_logs
+    ARGUMENTS: none
+    PURPOSE: comparison of every compiled in log written 
+        against none, at the shortest interval
+    RETURN: nothing
+*/
+void bench_logs(
+    void
+) {
+    printf("Starting log benchmark, compiled from level %s...\n", LEVEL_NAMES[LOG_LEVEL]);
+
+    mkdir("logs", 0755);
+
+    if (Logger_init() != OK) {
+        printf("LOGGER UNAVAILABLE\n");
+        return;
+    }
+
+    bench_logsLevel(LOG_LEVEL, "compiled");
+    bench_logsLevel(LOG_LEVEL_OFF, "off");
+
+    Logger_join();
+    Logger_destroy();
+
+    bench_logsDeferred();
+    bench_logsFormatted();
+
+    printf("Log benchmark finished !\n");
+}
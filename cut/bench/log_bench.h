@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: log_bench.h                       
+    PURPOSE: interface for log level benchmark module 
+*/
+
+#ifndef LOG_BENCH
+#define LOG_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_logs(void);
+
+#endif 
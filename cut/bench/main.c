@@ -0,0 +1,41 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: main.c                       
+    PURPOSE: running benchmarks of tracker modules
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "reader_bench.h"
+#include "compute_bench.h"
+#include "scaling_bench.h"
+#include "mode_bench.h"
+#include "log_bench.h"
+#include "render_bench.h"
+#include "sink_bench.h"
+#include "metrics_bench.h"
+
+/*
+    METHOD: main
+    ARGUMENTS: none
+    PURPOSE: invocation of all benchmarks
+    RETURN: an integer number describing correction 
+        of this function's execution
+*/
+int main(
+    void
+) {
+
+    bench_reader();
+    bench_compute();
+    bench_scaling();
+    bench_modes();
+    bench_logs();
+    bench_render();
+    bench_sinks();
+    bench_metrics();
+
+    return 0;
+}
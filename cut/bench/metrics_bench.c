@@ -0,0 +1,192 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics_bench.c                       
+    PURPOSE: benchmarking cost of publishing a record of 128 cores 
+        for scrapes, paid by analyzer on every sample, and of a whole
+        scrape of /metrics over a loopback connection
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <string.h>      
+#include <unistd.h>      
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "metrics_bench.h"
+#include "../inc/metrics.h"
+#include "../inc/scheduler.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define PROC 128
+#define PUBLISHES 100000
+#define SCRAPES 2000
+#define RESPONSE_SIZE (256u << 10)
+#define GET "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n"
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_metricsFill(ConvertedStats* const);
+static size_t bench_metricsScrape(Metrics* const, struct sockaddr_in const* const, char* const);
+
+/*
+    METHOD: bench_metricsFill
+    ARGUMENTS:
+        stats - a record of PROC cores to be filled
+    PURPOSE: filling of a record with usage of a busy machine, 
+        every core online
+    RETURN: nothing
+*/
+static void bench_metricsFill(
+    ConvertedStats* const stats
+) {
+    uint32_t seed;
+    uint16_t* ids;
+    float usage;
+
+    seed = 1;
+
+    stats -> timestamp = Scheduler_now();
+    stats -> count = PROC;
+
+    ids = CONVERTED_IDS(stats);
+
+    for (size_t row = 0; row <= PROC; row++) {
+        seed = seed * 1664525u + 1013904223u;
+        usage = (float) (seed >> 8) / (float) (1u << 24) * 100.0f;
+
+        stats -> percentages[row] = usage;
+
+        for (int column = 0; column < COLUMNS; column++) {
+            CONVERTED_COLUMN(stats, column)[row] = column == COLUMN_IDLE ? 100.0f - usage : usage / 9.0f;
+        }
+
+        ids[row] = row == 0 ? 0 : (uint16_t) (row - 1);
+    }
+}
+
+/*
+    METHOD: bench_metricsScrape
+    ARGUMENTS:
+        metrics - a Metrics object served on a calling thread
+        server - an address it listens on
+        output - where a response is saved, RESPONSE_SIZE bytes long
+    PURPOSE: a single scrape, connection, request and reading of 
+        a response until it is closed, served between reads
+    RETURN: length of a response, 0 when it failed
+*/
+static size_t bench_metricsScrape(
+    Metrics* const metrics,
+    struct sockaddr_in const* const server,
+    char* const output
+) {
+    ssize_t received;
+    size_t length;
+    int fd;
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0) { return 0; }
+
+    if (
+        connect(fd, (struct sockaddr const*) server, sizeof(*server)) != 0 ||
+        send(fd, GET, sizeof(GET) - 1, MSG_NOSIGNAL) != sizeof(GET) - 1
+    ) {
+        close(fd);
+        return 0;
+    }
+
+    length = 0;
+
+    for (;;) {
+        received = recv(fd, output + length, RESPONSE_SIZE - length, MSG_DONTWAIT);
+
+        if (received == 0) { break; }
+
+        if (received > 0) {
+            length += (size_t) received;
+            continue;
+        }
+
+        if (Metrics_serve(metrics, 10) != OK) { break; }
+    }
+
+    close(fd);
+
+    return length;
+}
+
+/*
+    METHOD: bench_metrics
+    ARGUMENTS: none
+    PURPOSE: measuring time of a publish, which analyzer pays for every
+        sample whether it is scraped or not, and of a scrape, which 
+        renders a record of PROC cores and counters of a buffer
+    RETURN: nothing
+*/
+void bench_metrics(
+    void
+) {
+    struct sockaddr_in server;
+    ConvertedStats* stats;
+    Metrics* metrics;
+    Buffer* buffer;
+    uint64_t publishes;
+    uint64_t scrapes;
+    uint64_t start;
+    size_t bytes;
+    char* output;
+
+    printf("Starting metrics benchmark...\n");
+
+    stats = (ConvertedStats*) malloc(CONVERTED_SIZE(PROC));
+    output = (char*) malloc(RESPONSE_SIZE);
+    buffer = Buffer_init(sizeof(ConvertedStats*), 32, BUFFER_OVERWRITE);
+    metrics = Metrics_init("127.0.0.1", 0, PROC);
+
+    if (
+        stats == NULL || 
+        output == NULL || 
+        buffer == NULL || 
+        metrics == NULL || 
+        Metrics_watchBuffer(metrics, "bench", buffer) != OK
+    ) {
+        printf("METRICS SETUP FAILED\n");
+        goto err_setup;
+    }
+
+    bench_metricsFill(stats);
+
+    server = (struct sockaddr_in) { .sin_family = AF_INET, .sin_port = htons(Metrics_port(metrics)) };
+    inet_pton(AF_INET, "127.0.0.1", &(server.sin_addr));
+
+    start = Scheduler_now();
+
+    for (int i = 0; i < PUBLISHES; i++) { Metrics_publish(metrics, stats); }
+
+    publishes = Scheduler_now() - start;
+
+    bytes = 0;
+    start = Scheduler_now();
+
+    for (int i = 0; i < SCRAPES; i++) { bytes += bench_metricsScrape(metrics, &server, output); }
+
+    scrapes = Scheduler_now() - start;
+
+    printf("%-22s %10.0f ns/record\n", "publish", (double) publishes / PUBLISHES);
+    printf("%-22s %10.0f ns/scrape %10.0f bytes/scrape\n", "scrape over loopback", 
+        (double) scrapes / SCRAPES, (double) bytes / SCRAPES);
+
+    err_setup:
+        Metrics_destroy(metrics);
+        Buffer_destroy(buffer);
+        free(output);
+        free(stats);
+
+    printf("Metrics benchmark finished !\n");
+}
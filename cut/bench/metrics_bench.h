@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics_bench.h                       
+    PURPOSE: interface for metrics benchmark module 
+*/
+
+#ifndef METRICS_BENCH
+#define METRICS_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_metrics(void);
+
+#endif 
@@ -0,0 +1,121 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: mode_bench.c                       
+    PURPOSE: benchmarking context switches and cpu time of tracker 
+        running a thread per stage against one running an event loop
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <pthread.h>      
+#include <unistd.h>      
+#include <fcntl.h>      
+#include <sys/resource.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "mode_bench.h"
+#include "../inc/tracker.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define INTERVAL 10
+#define TICKS 200
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* bench_modesRunner(void* const);
+static void bench_modesMode(int const, char const* const);
+
+/*
+    METHOD: bench_modesRunner
+    ARGUMENTS:
+        args - a tracker to be run
+    PURPOSE: thread running a tracker until it gets terminated
+    RETURN: NULL
+*/
+static void* bench_modesRunner(
+    void* const args
+) {
+    Tracker_start((Tracker*) args);
+
+    return NULL;
+}
+
+/*
+    METHOD: bench_modesMode
+    ARGUMENTS:
+        mode - tracker mode to be measured
+        label - name printed next to the result
+    PURPOSE: measuring context switches and cpu time 
+        per tick of a tracker in a given mode
+    RETURN: nothing
+*/
+static void bench_modesMode(
+    int const mode,
+    char const* const label
+) {
+    Tracker* tracker;
+    pthread_t thread;
+    struct rusage before;
+    struct rusage after;
+    long switches;
+    long voluntary;
+    double cpu;
+    int out;
+    int null;
+
+    tracker = Tracker_init(INTERVAL, mode);
+
+    if (tracker == NULL) {
+        printf("%-10s SETUP FAILED\n", label);
+        return;
+    }
+
+    // FRAMES ARE NOT PART OF THE RESULT
+    fflush(stdout);
+    out = dup(STDOUT_FILENO);
+    null = open("/dev/null", O_WRONLY);
+    dup2(null, STDOUT_FILENO);
+
+    getrusage(RUSAGE_SELF, &before);
+
+    if (pthread_create(&thread, NULL, bench_modesRunner, tracker) == 0) {
+        usleep(INTERVAL * TICKS * 1000);
+        Tracker_terminate(tracker);
+        pthread_join(thread, NULL);
+    }
+
+    getrusage(RUSAGE_SELF, &after);
+
+    Tracker_destroy(tracker);
+
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+    close(null);
+
+    voluntary = after.ru_nvcsw - before.ru_nvcsw;
+    switches = voluntary + after.ru_nivcsw - before.ru_nivcsw;
+    cpu = (double) (after.ru_utime.tv_sec - before.ru_utime.tv_sec + after.ru_stime.tv_sec - before.ru_stime.tv_sec) * 1e6
+        + (double) (after.ru_utime.tv_usec - before.ru_utime.tv_usec + after.ru_stime.tv_usec - before.ru_stime.tv_usec);
+
+    printf("%-10s %8.2f switches/tick %8.2f voluntary/tick %10.1f us cpu/tick\n", 
+        label, (double) switches / TICKS, (double) voluntary / TICKS, cpu / TICKS);
+}
+
+/*
+    METHOD: bench_modes
+    ARGUMENTS: none
+    PURPOSE: comparison of tracker modes at the shortest interval
+    RETURN: nothing
+*/
+void bench_modes(
+    void
+) {
+    printf("Starting mode benchmark...\n");
+
+    bench_modesMode(TRACKER_THREADED, "threaded");
+    bench_modesMode(TRACKER_EVENT, "event");
+
+    printf("Mode benchmark finished !\n");
+}
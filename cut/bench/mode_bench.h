@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: mode_bench.h                       
+    PURPOSE: interface for tracker mode benchmark module 
+*/
+
+#ifndef MODE_BENCH
+#define MODE_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_modes(void);
+
+#endif 
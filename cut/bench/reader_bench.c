@@ -0,0 +1,160 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: reader_bench.c                       
+    PURPOSE: benchmarking reader module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <time.h>      
+#include <unistd.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "reader_bench.h"
+#include "../inc/buffer.h"
+#include "../inc/reader.h"
+#include "../inc/enums.h"
+#include "../inc/stats.h"
+
+// MACRO DEFINITION
+#define SYNTHETIC_PATH "/tmp/cut_bench_stat"
+#define SYNTHETIC_PROC 128
+#define ITERATIONS 2000
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_readerMode(char const* const, uint16_t const, int const, char const* const);
+
+/*
+    METHOD: bench_now
+    ARGUMENTS: none
+    PURPOSE: reading of monotonic clock
+    RETURN: current monotonic time in nanoseconds
+*/
+uint64_t bench_now(
+    void
+) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+/*
+    METHOD: bench_writeStat
+    ARGUMENTS:
+        path - path of a file to be created
+        proc - number of cpuN lines to be generated
+    PURPOSE: creation of a synthetic /proc/stat file
+    RETURN: enums integer value
+*/
+int bench_writeStat(
+    char const* const path,
+    uint16_t const proc
+) {
+    FILE* file;
+
+    file = fopen(path, "w");
+
+    if (file == NULL) { return ERR_FILE_OPEN; }
+
+    fprintf(file, "cpu  %u 1203 %u 918273645 51234 0 77123 0 0 0\n", 
+        proc * 1234567u, proc * 345678u);
+
+    for (uint16_t i = 0; i < proc; i++) {
+        fprintf(file, "cpu%u %u 1203 %u 9182736 512 0 771 0 0 0\n", 
+            i, 1234567u + i, 345678u + i);
+    }
+
+    fprintf(file, "intr 1234567890 0 9 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n");
+    fprintf(file, "ctxt 9876543210\nbtime 1700000000\nprocesses 123456\n");
+    fprintf(file, "procs_running 3\nprocs_blocked 0\n");
+
+    fclose(file);
+
+    return OK;
+}
+
+/*
+    METHOD: bench_readerMode
+    ARGUMENTS:
+        path - stat file to be read
+        proc - number of cores in a given file
+        mode - reader mode to be measured
+        label - name printed next to the result
+    PURPOSE: measuring mean time of a single Reader_read call
+    RETURN: nothing
+*/
+static void bench_readerMode(
+    char const* const path,
+    uint16_t const proc,
+    int const mode,
+    char const* const label
+) {
+    Buffer* buffer;
+    Reader* reader;
+    ProcessorStats* stats;
+    uint64_t start;
+    uint64_t elapsed;
+
+    buffer = Buffer_init(sizeof(ProcessorStats), 1, BUFFER_MPMC);
+    reader = Reader_init(buffer, NULL, proc, path, mode);
+    stats = malloc(STATS_SIZE(proc));
+
+    if (buffer == NULL || reader == NULL || stats == NULL) {
+        printf("%-40s SETUP FAILED\n", label);
+        free(stats);
+        Reader_destroy(reader);
+        Buffer_destroy(buffer);
+        return;
+    }
+
+    start = bench_now();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+        if (Reader_read(reader, stats) != OK) {
+            printf("%-40s READ FAILED\n", label);
+            break;
+        }
+    }
+
+    elapsed = bench_now() - start;
+
+    printf("%-40s %10.0f ns/read\n", label, (double) elapsed / ITERATIONS);
+
+    free(stats);
+    Reader_destroy(reader);
+    Buffer_destroy(buffer);
+}
+
+/*
+    METHOD: bench_reader
+    ARGUMENTS: none
+    PURPOSE: comparison of stream and persistent reader modes
+        on this host's /proc/stat and on a synthetic many-core file
+    RETURN: nothing
+*/
+void bench_reader(
+    void
+) {
+    long proc;
+
+    printf("Starting reader benchmark...\n");
+
+    proc = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (proc > 0 && proc <= UINT16_MAX) {
+        bench_readerMode("/proc/stat", (uint16_t) proc, READER_STREAM, "/proc/stat stream (fopen/fscanf)");
+        bench_readerMode("/proc/stat", (uint16_t) proc, READER_PERSISTENT, "/proc/stat persistent (pread/scan)");
+    }
+
+    if (bench_writeStat(SYNTHETIC_PATH, SYNTHETIC_PROC) == OK) {
+        bench_readerMode(SYNTHETIC_PATH, SYNTHETIC_PROC, READER_STREAM, "synthetic 128 cpu stream");
+        bench_readerMode(SYNTHETIC_PATH, SYNTHETIC_PROC, READER_PERSISTENT, "synthetic 128 cpu persistent");
+        remove(SYNTHETIC_PATH);
+    }
+
+    printf("Reader benchmark finished !\n");
+}
@@ -0,0 +1,18 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: reader_bench.h                       
+    PURPOSE: interface for reader benchmark module 
+*/
+
+#ifndef READER_BENCH
+#define READER_BENCH
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdint.h>
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_reader(void);
+int bench_writeStat(char const* const, uint16_t const);
+uint64_t bench_now(void);
+
+#endif 
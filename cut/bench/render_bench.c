@@ -0,0 +1,265 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: render_bench.c                       
+    PURPOSE: benchmarking time and bytes of a frame of 128 cores,
+        rendered as a difference, rendered whole, and printed
+        with a stdio call per cell as printer did before, 
+        and of a heatmap of 1024 cores
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <unistd.h>      
+#include <fcntl.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "render_bench.h"
+#include "../inc/printer.h"
+#include "../inc/screen.h"
+#include "../inc/buffer.h"
+#include "../inc/pool.h"
+#include "../inc/histogram.h"
+#include "../inc/scheduler.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define PROC 128
+#define HEATMAP_PROC 1024
+#define FRAMES 500
+#define STEP 3.0f
+
+// STRUCTURE FOR HOLDING A RESULT OF A SINGLE RENDERER
+typedef struct RenderResult {
+    uint64_t elapsed;
+    uint64_t bytes;
+} RenderResult;
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_renderFill(ConvertedStats* const, uint16_t const, float* const, uint32_t* const);
+static RenderResult bench_renderPrinter(uint16_t const, int const, bool const);
+static RenderResult bench_renderStdio(void);
+static size_t bench_renderStdioFrame(ConvertedStats* const);
+
+/*
+    METHOD: bench_renderFill
+    ARGUMENTS:
+        converted - an object to be filled
+        proc - number of cores of a given object
+        usage - usage of every row, walked a few percent each frame
+        seed - state of a generator of walks
+    PURPOSE: filling of a sample as load of a busy machine changes
+        between frames, deterministic so every renderer sees the same
+    RETURN: nothing
+*/
+static void bench_renderFill(
+    ConvertedStats* const converted,
+    uint16_t const proc,
+    float* const usage,
+    uint32_t* const seed
+) {
+    converted -> count = proc;
+    converted -> timestamp = Scheduler_now();
+
+    for (size_t row = 0; row <= proc; row++) {
+        *seed = *seed * 1664525u + 1013904223u;
+        usage[row] += ((float) (*seed >> 16) / 65536.0f - 0.5f) * 2.0f * STEP;
+
+        if (usage[row] < 0.0f) { usage[row] = 0.0f; }
+        if (usage[row] > 100.0f) { usage[row] = 100.0f; }
+
+        converted -> percentages[row] = usage[row];
+
+        for (int column = 0; column < COLUMNS; column++) {
+            CONVERTED_COLUMN(converted, column)[row] = column == COLUMN_IDLE ? 100.0f - usage[row] : usage[row] / 9.0f;
+        }
+
+        CONVERTED_IDS(converted)[row] = row == 0 ? 0 : (uint16_t) (row - 1);
+    }
+}
+
+/*
+    METHOD: bench_renderPrinter
+    ARGUMENTS:
+        proc - number of cores printed
+        layout - layout of a printer
+        whole - true to send every frame whole
+    PURPOSE: measuring printer's time per frame and bytes it sends,
+        standard output is expected to point to /dev/null
+    RETURN: time and bytes of all frames
+*/
+static RenderResult bench_renderPrinter(
+    uint16_t const proc,
+    int const layout,
+    bool const whole
+) {
+    float usage[HEATMAP_PROC + 1] = { 0 };
+    RenderResult result = { 0, 0 };
+    ConvertedStats* converted;
+    ScreenStats stats;
+    Histogram* latency;
+    Printer* printer;
+    Buffer* buffer;
+    uint32_t seed;
+    uint64_t start;
+    Pool* pool;
+
+    buffer = Buffer_init(sizeof(ConvertedStats*), 1, BUFFER_MPMC);
+    pool = Pool_init(CONVERTED_SIZE(proc), 2);
+    latency = Histogram_init();
+    printer = Printer_init(buffer, pool, latency, proc);
+
+    if (printer != NULL && Printer_setLayout(printer, layout) == OK) {
+        seed = 1;
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+            converted = Pool_acquire(pool);
+            bench_renderFill(converted, proc, usage, &seed);
+            Buffer_push(buffer, &converted);
+
+            if (whole) { Screen_invalidate(Printer_screen(printer)); }
+
+            start = Scheduler_now();
+            Printer_step(printer, false);
+            result.elapsed += Scheduler_now() - start;
+        }
+
+        Screen_stats(Printer_screen(printer), &stats);
+        result.bytes = stats.bytes;
+    }
+
+    Printer_destroy(printer);
+    Histogram_destroy(latency);
+    Pool_destroy(pool);
+    Buffer_destroy(buffer);
+
+    return result;
+}
+
+/*
+    METHOD: bench_renderStdioFrame
+    ARGUMENTS:
+        converted - a sample to be printed
+    PURPOSE: printing of a frame as printer did before, a clear 
+        of the screen and a stdio call for every cell of every bar
+    RETURN: number of bytes printed
+*/
+static size_t bench_renderStdioFrame(
+    ConvertedStats* const converted
+) {
+    size_t bytes;
+    int progress;
+
+    bytes = (size_t) printf("\033[H\033[J");
+    bytes += (size_t) printf("================ TRACKER ================\n\n");
+
+    for (size_t row = 0; row <= converted -> count; row++) {
+        if (row == 0) { bytes += (size_t) printf("cpu:   "); }
+        else { bytes += (size_t) printf("cpu%u:  ", CONVERTED_IDS(converted)[row]); }
+
+        progress = (int) (converted -> percentages[row] / 4.0f);
+
+        bytes += (size_t) printf("[");
+        for (int i = 0; i < progress; i++) { bytes += (size_t) printf("%s", "#"); }
+        for (int i = progress; i < 25; i++) { bytes += (size_t) printf(" "); }
+        bytes += (size_t) printf("] %0.2f%%\n", (double) converted -> percentages[row]);
+    }
+
+    bytes += (size_t) printf("\n================ TRACKER ================\n");
+
+    fflush(stdout);
+
+    return bytes;
+}
+
+/*
+    METHOD: bench_renderStdio
+    ARGUMENTS: none
+    PURPOSE: measuring time per frame and bytes of printing 
+        with a stdio call per cell
+    RETURN: time and bytes of all frames
+*/
+static RenderResult bench_renderStdio(
+    void
+) {
+    float usage[PROC + 1] = { 0 };
+    RenderResult result = { 0, 0 };
+    ConvertedStats* converted;
+    uint32_t seed;
+    uint64_t start;
+    Pool* pool;
+
+    pool = Pool_init(CONVERTED_SIZE(PROC), 1);
+    converted = pool == NULL ? NULL : Pool_acquire(pool);
+
+    if (converted != NULL) {
+        seed = 1;
+
+        for (int frame = 0; frame < FRAMES; frame++) {
+            bench_renderFill(converted, PROC, usage, &seed);
+
+            start = Scheduler_now();
+            result.bytes += bench_renderStdioFrame(converted);
+            result.elapsed += Scheduler_now() - start;
+        }
+
+        Pool_release(pool, converted);
+    }
+
+    Pool_destroy(pool);
+
+    return result;
+}
+
+/*
+    METHOD: bench_render
+    ARGUMENTS: none
+    PURPOSE: comparison of renderers on frames of 128 cores, and 
+        a heatmap of 1024 cores on a 240 by 70 terminal, written 
+        to /dev/null so only their own cost is measured
+    RETURN: nothing
+*/
+void bench_render(
+    void
+) {
+    RenderResult results[4];
+    char const* const labels[4] = { 
+        "128 cpu difference", "128 cpu whole frame", "128 cpu stdio per cell", "1024 cpu heatmap difference" 
+    };
+    int terminal;
+    int null;
+
+    printf("Starting render benchmark...\n");
+    fflush(stdout);
+
+    terminal = dup(STDOUT_FILENO);
+    null = open("/dev/null", O_WRONLY);
+
+    if (terminal < 0 || null < 0 || dup2(null, STDOUT_FILENO) < 0) {
+        printf("RENDER SETUP FAILED\n");
+        return;
+    }
+
+    // /DEV/NULL IS NOT A TERMINAL, SO HEATMAP TAKES ITS SIZE FROM ENVIRONMENT
+    setenv("LINES", "70", 1);
+    setenv("COLUMNS", "240", 1);
+
+    results[1] = bench_renderPrinter(PROC, PRINTER_BARS, true);
+    results[0] = bench_renderPrinter(PROC, PRINTER_BARS, false);
+    results[2] = bench_renderStdio();
+    results[3] = bench_renderPrinter(HEATMAP_PROC, PRINTER_HEATMAP, false);
+
+    fflush(stdout);
+    dup2(terminal, STDOUT_FILENO);
+    close(terminal);
+    close(null);
+
+    for (int i = 0; i < 4; i++) {
+        printf("%-30s %10.0f ns/frame %10.0f bytes/frame\n", 
+            labels[i], (double) results[i].elapsed / FRAMES, (double) results[i].bytes / FRAMES);
+    }
+
+    printf("Render benchmark finished !\n");
+}
@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: render_bench.h                       
+    PURPOSE: interface for render benchmark module 
+*/
+
+#ifndef RENDER_BENCH
+#define RENDER_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_render(void);
+
+#endif 
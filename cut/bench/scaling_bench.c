@@ -0,0 +1,123 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scaling_bench.c                       
+    PURPOSE: benchmarking growth of memory and per tick cost with cpu count 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "scaling_bench.h"
+#include "reader_bench.h"
+#include "../inc/compute.h"
+#include "../inc/reader.h"
+#include "../inc/buffer.h"
+#include "../inc/enums.h"
+#include "../inc/stats.h"
+
+// MACRO DEFINITION
+#define SYNTHETIC_PATH "/tmp/cut_bench_scaling_stat"
+#define CPU_WORK 2000000
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_scalingProc(uint16_t const);
+
+/*
+    METHOD: bench_scalingProc
+    ARGUMENTS:
+        proc - number of cpus in a synthetic stat file
+    PURPOSE: measuring per tick memory and mean time of reading
+        and analyzing a synthetic stat file of a given cpu count
+    RETURN: nothing
+*/
+static void bench_scalingProc(
+    uint16_t const proc
+) {
+    Buffer* buffer;
+    Reader* reader;
+    ComputeKernel kernel;
+    ProcessorStats* stats;
+    ConvertedStats* converted;
+    uint64_t* prev;
+    size_t memory;
+    uint64_t start;
+    uint64_t elapsed;
+    int iterations;
+
+    if (bench_writeStat(SYNTHETIC_PATH, proc) != OK) {
+        printf("%5u cpu SETUP FAILED\n", proc);
+        return;
+    }
+
+    // EVERY TICK HANDLES ABOUT THE SAME NUMBER OF CPUS, WHATEVER THEIR COUNT
+    iterations = CPU_WORK / proc;
+
+    buffer = Buffer_init(sizeof(ProcessorStats), 1, BUFFER_MPMC);
+    reader = Reader_init(buffer, NULL, proc, SYNTHETIC_PATH, READER_PERSISTENT);
+    kernel = Compute_kernel(COMPUTE_AUTO);
+    stats = malloc(STATS_SIZE(proc));
+    converted = malloc(CONVERTED_SIZE(proc));
+    prev = calloc(COMPUTE_PREV_BLOCKS * ((size_t) proc + 1), sizeof(uint64_t));
+
+    if (buffer == NULL || reader == NULL || stats == NULL || converted == NULL || prev == NULL) {
+        printf("%5u cpu SETUP FAILED\n", proc);
+        free(stats);
+        free(converted);
+        free(prev);
+        Reader_destroy(reader);
+        Buffer_destroy(buffer);
+        remove(SYNTHETIC_PATH);
+        return;
+    }
+
+    // SAMPLE IN BUFFER RA, RECORD IN BUFFER AP AND ANALYZER'S STATE
+    memory = STATS_SIZE(proc) + CONVERTED_SIZE(proc) + COMPUTE_PREV_BLOCKS * ((size_t) proc + 1) * sizeof(uint64_t);
+
+    start = bench_now();
+
+    for (int i = 0; i < iterations; i++) {
+        if (Reader_read(reader, stats) != OK) {
+            printf("%5u cpu READ FAILED\n", proc);
+            break;
+        }
+
+        converted -> timestamp = stats -> timestamp;
+        converted -> count = stats -> count;
+
+        kernel(stats -> columns, STATS_STRIDE(stats), STATS_STRIDE(stats), prev, converted -> percentages);
+    }
+
+    elapsed = bench_now() - start;
+
+    printf("%5u cpu %10zu bytes/sample %12.0f ns/tick %8.1f ns/cpu\n", 
+        proc, memory, (double) elapsed / iterations, (double) elapsed / iterations / proc);
+
+    free(stats);
+    free(converted);
+    free(prev);
+    Reader_destroy(reader);
+    Buffer_destroy(buffer);
+    remove(SYNTHETIC_PATH);
+}
+
+/*
+    METHOD: bench_scaling
+    ARGUMENTS: none
+    PURPOSE: showing that memory and per tick cost of read and analysis 
+        grow linearly with cpu count, up to a synthetic 4096 cpu host
+    RETURN: nothing
+*/
+void bench_scaling(
+    void
+) {
+    printf("Starting scaling benchmark...\n");
+
+    for (uint16_t proc = 64; proc <= 4096; proc *= 4) {
+        bench_scalingProc(proc);
+    }
+
+    printf("Scaling benchmark finished !\n");
+}
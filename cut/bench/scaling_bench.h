@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scaling_bench.h                       
+    PURPOSE: interface for scaling benchmark module 
+*/
+
+#ifndef SCALING_BENCH
+#define SCALING_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_scaling(void);
+
+#endif 
@@ -0,0 +1,264 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink_bench.c                       
+    PURPOSE: benchmarking throughput of every sink on records 
+        of 128 cores, alone and all at once, and of JSON Lines 
+        formatted with snprintf as a reference
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <string.h>      
+#include <unistd.h>      
+#include <fcntl.h>      
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "sink_bench.h"
+#include "../inc/sink.h"
+#include "../inc/scheduler.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define PROC 128
+#define RECORDS 20000
+#define BATCH 16
+#define LINE_SIZE (64 + 320 * (PROC + 1))
+
+// STRUCTURE FOR HOLDING A RESULT OF A SINGLE RUN
+typedef struct SinkResult {
+    uint64_t elapsed;
+    uint64_t bytes;
+} SinkResult;
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void bench_sinkFill(ConvertedStats* const* const);
+static SinkResult bench_sinkRun(ConvertedStats* const* const, int const* const, int const);
+static SinkResult bench_sinkPrintf(ConvertedStats* const* const);
+static size_t bench_sinkPrintfRow(ConvertedStats const* const, size_t const, char* const, size_t const);
+
+/*
+    METHOD: bench_sinkFill
+    ARGUMENTS:
+        batch - BATCH records of PROC cores to be filled
+    PURPOSE: filling of records with usage of a busy machine, 
+        with full float precision, so no number is short to encode
+    RETURN: nothing
+*/
+static void bench_sinkFill(
+    ConvertedStats* const* const batch
+) {
+    uint32_t seed;
+    uint16_t* ids;
+    float usage;
+
+    seed = 1;
+
+    for (size_t record = 0; record < BATCH; record++) {
+        batch[record] -> timestamp = Scheduler_now();
+        batch[record] -> count = PROC;
+
+        ids = CONVERTED_IDS(batch[record]);
+
+        for (size_t row = 0; row <= PROC; row++) {
+            seed = seed * 1664525u + 1013904223u;
+            usage = (float) (seed >> 8) / (float) (1u << 24) * 100.0f;
+
+            batch[record] -> percentages[row] = usage;
+
+            for (int column = 0; column < COLUMNS; column++) {
+                CONVERTED_COLUMN(batch[record], column)[row] = column == COLUMN_IDLE ? 100.0f - usage : usage / 9.0f;
+            }
+
+            ids[row] = row == 0 ? 0 : (uint16_t) (row - 1);
+        }
+    }
+}
+
+/*
+    METHOD: bench_sinkRun
+    ARGUMENTS:
+        batch - BATCH records emitted over and over
+        formats - formats of sinks run at once
+        count - number of sinks run at once
+    PURPOSE: measuring time of emitting RECORDS records to every
+        sink of a given format, in batches of BATCH, to /dev/null
+    RETURN: time and bytes written by all sinks
+*/
+static SinkResult bench_sinkRun(
+    ConvertedStats* const* const batch,
+    int const* const formats,
+    int const count
+) {
+    SinkResult result = { 0, 0 };
+    SinkStats stats;
+    Sink* sinks[SINK_BINARY + 1];
+    uint64_t start;
+
+    for (int i = 0; i < count; i++) {
+        sinks[i] = Sink_open(formats[i], "/dev/null", PROC);
+
+        if (sinks[i] == NULL) {
+            while (i-- > 0) { Sink_close(sinks[i]); }
+            return result;
+        }
+    }
+
+    start = Scheduler_now();
+
+    for (int round = 0; round < RECORDS / BATCH; round++) {
+        for (int i = 0; i < count; i++) { Sink_emit(sinks[i], batch, BATCH); }
+    }
+
+    for (int i = 0; i < count; i++) { Sink_flush(sinks[i]); }
+
+    result.elapsed = Scheduler_now() - start;
+
+    for (int i = 0; i < count; i++) {
+        Sink_stats(sinks[i], &stats);
+        result.bytes += stats.bytes;
+        Sink_close(sinks[i]);
+    }
+
+    return result;
+}
+
+/*
+    METHOD: bench_sinkPrintfRow
+    ARGUMENTS:
+        stats - a record to be formatted
+        row - row of a given record
+        output - where members are saved
+        size - size of a given output
+    PURPOSE: formatting of a row as JSON members with snprintf
+    RETURN: length of formatted members
+*/
+static size_t bench_sinkPrintfRow(
+    ConvertedStats const* const stats,
+    size_t const row,
+    char* const output,
+    size_t const size
+) {
+    int written;
+
+    written = snprintf(output, size,
+        "\"usage\":%.2f,\"user\":%.2f,\"nice\":%.2f,\"system\":%.2f,\"idle\":%.2f,\"iowait\":%.2f,"
+        "\"irq\":%.2f,\"softirq\":%.2f,\"steal\":%.2f,\"guest\":%.2f,\"guest_nice\":%.2f",
+        (double) stats -> percentages[row],
+        (double) CONVERTED_COLUMN(stats, COLUMN_USER)[row], (double) CONVERTED_COLUMN(stats, COLUMN_NICE)[row],
+        (double) CONVERTED_COLUMN(stats, COLUMN_SYSTEM)[row], (double) CONVERTED_COLUMN(stats, COLUMN_IDLE)[row],
+        (double) CONVERTED_COLUMN(stats, COLUMN_IOWAIT)[row], (double) CONVERTED_COLUMN(stats, COLUMN_IRQ)[row],
+        (double) CONVERTED_COLUMN(stats, COLUMN_SOFTIRQ)[row], (double) CONVERTED_COLUMN(stats, COLUMN_STEAL)[row],
+        (double) CONVERTED_COLUMN(stats, COLUMN_GUEST)[row], (double) CONVERTED_COLUMN(stats, COLUMN_GUEST_NICE)[row]);
+
+    return written < 0 || (size_t) written >= size ? 0 : (size_t) written;
+}
+
+/*
+    METHOD: bench_sinkPrintf
+    ARGUMENTS:
+        batch - BATCH records formatted over and over
+    PURPOSE: measuring time of formatting RECORDS records as the 
+        same JSON Lines with snprintf, written a line at a time
+    RETURN: time and bytes written
+*/
+static SinkResult bench_sinkPrintf(
+    ConvertedStats* const* const batch
+) {
+    SinkResult result = { 0, 0 };
+    ConvertedStats const* stats;
+    uint64_t start;
+    size_t length;
+    char* line;
+    int null;
+
+    line = (char*) malloc(LINE_SIZE);
+    null = open("/dev/null", O_WRONLY);
+
+    if (line == NULL || null < 0) {
+        free(line);
+        if (null >= 0) { close(null); }
+        return result;
+    }
+
+    start = Scheduler_now();
+
+    for (int record = 0; record < RECORDS; record++) {
+        stats = batch[record % BATCH];
+
+        length = (size_t) snprintf(line, LINE_SIZE, "{\"timestamp\":%llu,\"all\":{", (unsigned long long) stats -> timestamp);
+        length += bench_sinkPrintfRow(stats, 0, line + length, LINE_SIZE - length);
+        length += (size_t) snprintf(line + length, LINE_SIZE - length, "},\"cores\":[");
+
+        for (size_t row = 1; row <= stats -> count; row++) {
+            length += (size_t) snprintf(line + length, LINE_SIZE - length, "%s{\"id\":%u,", 
+                row > 1 ? "," : "", CONVERTED_IDS(stats)[row]);
+            length += bench_sinkPrintfRow(stats, row, line + length, LINE_SIZE - length);
+            line[length++] = '}';
+        }
+
+        length += (size_t) snprintf(line + length, LINE_SIZE - length, "]}\n");
+
+        if (write(null, line, length) == (ssize_t) length) { result.bytes += length; }
+    }
+
+    result.elapsed = Scheduler_now() - start;
+
+    close(null);
+    free(line);
+
+    return result;
+}
+
+/*
+    METHOD: bench_sinks
+    ARGUMENTS: none
+    PURPOSE: comparison of throughput of every sink, of all 
+        of them fed from the same records at once, and of 
+        JSON Lines formatted with snprintf
+    RETURN: nothing
+*/
+void bench_sinks(
+    void
+) {
+    int const formats[SINK_BINARY + 1] = { SINK_JSON, SINK_CSV, SINK_BINARY };
+    char const* const labels[5] = { 
+        "json lines", "csv", "binary", "all three at once", "json lines snprintf" 
+    };
+    ConvertedStats* batch[BATCH];
+    SinkResult results[5];
+    double seconds;
+
+    printf("Starting sink benchmark...\n");
+
+    for (int i = 0; i < BATCH; i++) {
+        batch[i] = (ConvertedStats*) malloc(CONVERTED_SIZE(PROC));
+
+        if (batch[i] == NULL) {
+            while (i-- > 0) { free(batch[i]); }
+            printf("SINK SETUP FAILED\n");
+            return;
+        }
+    }
+
+    bench_sinkFill(batch);
+
+    for (int i = 0; i <= SINK_BINARY; i++) { results[i] = bench_sinkRun(batch, &formats[i], 1); }
+
+    results[3] = bench_sinkRun(batch, formats, SINK_BINARY + 1);
+    results[4] = bench_sinkPrintf(batch);
+
+    for (int i = 0; i < 5; i++) {
+        seconds = (double) results[i].elapsed / 1e9;
+
+        printf("%-22s %10.0f ns/record %10.0f bytes/record %8.1f MB/s\n", 
+            labels[i], (double) results[i].elapsed / RECORDS, (double) results[i].bytes / RECORDS, 
+            seconds > 0.0 ? (double) results[i].bytes / seconds / 1e6 : 0.0);
+    }
+
+    for (int i = 0; i < BATCH; i++) { free(batch[i]); }
+
+    printf("Sink benchmark finished !\n");
+}
@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink_bench.h                       
+    PURPOSE: interface for sink benchmark module 
+*/
+
+#ifndef SINK_BENCH
+#define SINK_BENCH
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void bench_sinks(void);
+
+#endif 
@@ -10,17 +10,24 @@
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <signal.h>
 #include <stdint.h>
-#include <stdatomic.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "buffer.h"
+#include "notifier.h"
+#include "pool.h"
+#include "sink.h"
+#include "metrics.h"
 
 // ENCAPSULATION ON READER OBJECT
 typedef struct analyzer Analyzer;
 
 // PROTOTYPE FUNCTIONS FOR OUTSIDE WORLD
-Analyzer* Analyzer_init(Buffer* const, Buffer* const, uint8_t const);
-int Analyzer_start(Analyzer* const, volatile sig_atomic_t*, atomic_flag*);
+Analyzer* Analyzer_init(Buffer* const, Buffer* const, Pool* const, uint16_t const);
+int Analyzer_start(Analyzer* const, volatile sig_atomic_t*);
+Notifier* Analyzer_notifier(Analyzer* const);
+int Analyzer_addSink(Analyzer* const, Sink* const);
+int Analyzer_setMetrics(Analyzer* const, Metrics* const);
+int Analyzer_step(Analyzer* const);
 int Analyzer_join(Analyzer* const);
 void Analyzer_destroy(Analyzer* const);
 
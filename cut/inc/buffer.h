@@ -11,16 +11,41 @@
 #include <stdbool.h>    
 #include <stdint.h>     
 #include <stddef.h>     
+#include <time.h>
 
 // ENCAPSULATION ON BUFFER OBJECT
 typedef struct buffer Buffer;
 
+// STRUCTURE FOR HOLDING BUFFER COUNTERS
+typedef struct BufferStats {
+    size_t count;
+    size_t capacity;
+    size_t high_water;
+    size_t drops;
+    size_t overwrites;
+} BufferStats;
+
 // DECLARATIONS OF OUTSIDE PROTOTYPES
-Buffer* Buffer_init(size_t const, size_t const);
+Buffer* Buffer_init(size_t const, size_t const, int const);
 bool Buffer_isEmpty(Buffer* const);
 bool Buffer_isFull(Buffer* const);
 int Buffer_push(Buffer* const, void* const);
 int Buffer_pop(Buffer* const, void*);
+int Buffer_pushTimed(Buffer* const, void* const, struct timespec const* const);
+int Buffer_tryPush(Buffer* const, void* const);
+int Buffer_popTimed(Buffer* const, void*, struct timespec const* const);
+int Buffer_pushN(Buffer* const, void* const, size_t const, size_t* const);
+int Buffer_popN(Buffer* const, void*, size_t const, size_t* const);
+int Buffer_reserve(Buffer* const, void** const);
+int Buffer_commit(Buffer* const);
+int Buffer_cancel(Buffer* const);
+int Buffer_peek(Buffer* const, void** const);
+int Buffer_peekN(Buffer* const, void** const, size_t const, size_t* const);
+int Buffer_release(Buffer* const);
+int Buffer_releaseN(Buffer* const, size_t const);
+int Buffer_onDrop(Buffer* const, void (*)(void* const, void* const), void* const);
+int Buffer_stats(Buffer* const, BufferStats* const);
+void Buffer_close(Buffer* const);
 void Buffer_destroy(Buffer*);
 
 #endif 
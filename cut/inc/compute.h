@@ -0,0 +1,36 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute.h                       
+    PURPOSE: interface for compute module 
+*/
+
+#ifndef COMPUTE_H
+#define COMPUTE_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+#include <stdint.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "enums.h"
+
+// NUMBER OF ROW BLOCKS OF STATE KEPT BETWEEN SAMPLES, ONE PER COUNTER, TOTAL AND IDLE
+#define COMPUTE_PREV_BLOCKS (COLUMNS + 2)
+
+// NUMBER OF ROW BLOCKS OF PERCENTAGES, USAGE FOLLOWED BY ONE PER COUNTER
+#define COMPUTE_OUT_BLOCKS (COLUMNS + 1)
+
+// TYPE OF A KERNEL COUNTING PERCENTAGES OF ROWS OF PROCESSORSTATS COLUMNS
+typedef void (*ComputeKernel)(
+    uint64_t const* const, 
+    size_t const, 
+    size_t const, 
+    uint64_t* const, 
+    float* const
+);
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+ComputeKernel Compute_kernel(int const);
+void Compute_baseline(uint64_t const* const, size_t const, size_t const, uint64_t* const);
+
+#endif 
@@ -26,9 +26,77 @@ enum errors {
     ERR_RUN,
     ERR_PUSH,
     ERR_INIT,
+    ERR_CLOSED,
+    ERR_TIMEOUT,
     OK,
     INITIALIZED,
     ANALYZED
 };
 
+// ENUM FOR BUFFER TYPES
+enum buffer_types {
+    BUFFER_MPMC,
+    BUFFER_SPSC,
+    BUFFER_OVERWRITE
+};
+
+// ENUM FOR READER MODES
+enum reader_modes {
+    READER_STREAM,
+    READER_PERSISTENT
+};
+
+// ENUM FOR TRACKER MODES, A THREAD PER STAGE OR ALL STAGES ON ONE EVENT LOOP,
+// OR READER AND ANALYZER ONLY ON ONE EVENT LOOP, WRITING TO SINKS WITHOUT A PRINTER
+enum tracker_modes {
+    TRACKER_THREADED,
+    TRACKER_EVENT,
+    TRACKER_HEADLESS
+};
+
+// ENUM FOR PRINTER LAYOUTS, A BAR PER CORE OR A HEATMAP OF CORES FITTED TO TERMINAL,
+// OR NO FRAMES AT ALL WHEN RECORDS ONLY GO TO SINKS
+enum printer_layouts {
+    PRINTER_BARS,
+    PRINTER_HEATMAP,
+    PRINTER_NONE
+};
+
+// ENUM FOR ENCODINGS OF SINKS
+enum sink_formats {
+    SINK_JSON,
+    SINK_CSV,
+    SINK_BINARY
+};
+
+// ENUM FOR WHAT SUPERVISOR DOES WITH A STALLED STAGE
+enum supervisor_actions {
+    SUPERVISOR_TERMINATE,
+    SUPERVISOR_RESTART,
+    SUPERVISOR_IGNORE
+};
+
+// ENUM FOR COUNTER COLUMNS OF PROCESSORSTATS, IN /PROC/STAT ORDER
+enum stats_columns {
+    COLUMN_USER,
+    COLUMN_NICE,
+    COLUMN_SYSTEM,
+    COLUMN_IDLE,
+    COLUMN_IOWAIT,
+    COLUMN_IRQ,
+    COLUMN_SOFTIRQ,
+    COLUMN_STEAL,
+    COLUMN_GUEST,
+    COLUMN_GUEST_NICE,
+    COLUMNS
+};
+
+// ENUM FOR PERCENTAGE KERNELS
+enum compute_kernels {
+    COMPUTE_AUTO,
+    COMPUTE_SCALAR,
+    COMPUTE_SSE2,
+    COMPUTE_AVX2
+};
+
 #endif 
@@ -0,0 +1,28 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: format.h                       
+    PURPOSE: interface for format module 
+*/
+
+#ifndef FORMAT_H
+#define FORMAT_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// MACRO DEFINITION, MAGNITUDE OF THE LARGEST NUMBER FORMAT_FLOAT WRITES
+#define FORMAT_FLOAT_LIMIT 9999999.99
+
+// MACRO DEFINITION, MOST BYTES FORMAT_FLOAT WRITES
+#define FORMAT_FLOAT_SIZE 11
+
+// COPY OF A STRING LITERAL WITHOUT ITS TERMINATOR, EVALUATES TO ITS LENGTH
+#define FORMAT_COPY(output, literal) (memcpy((output), (literal), sizeof(literal) - 1), sizeof(literal) - 1)
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+size_t Format_unsigned(char* const, uint64_t const);
+size_t Format_float(char* const, double const);
+
+#endif
@@ -0,0 +1,26 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: histogram.h                       
+    PURPOSE: interface for histogram module 
+*/
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdint.h>
+#include <stdio.h>
+
+// ENCAPSULATION ON HISTOGRAM OBJECT
+typedef struct histogram Histogram;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Histogram* Histogram_init(void);
+void Histogram_record(Histogram* const, uint64_t const);
+uint64_t Histogram_count(Histogram* const);
+uint64_t Histogram_max(Histogram* const);
+uint64_t Histogram_percentile(Histogram* const, double const);
+void Histogram_print(Histogram* const, char const* const, FILE* const);
+void Histogram_destroy(Histogram*);
+
+#endif 
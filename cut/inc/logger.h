@@ -9,16 +9,109 @@
 
 // OUTSIDE WORLD INCLUDES
 #include <signal.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 // INSIDE WORLD INCLUDES
 #include "buffer.h"
 
+// LEVELS OF LOGS, PLAIN NUMBERS SO PREPROCESSOR CAN COMPARE THEM
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5
+
+// LOWEST LEVEL COMPILED IN, SET BY MAKEFILE, CALLS BELOW IT DO NOT EXIST IN A BINARY
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// MOST ARGUMENTS A SINGLE LOG CAN CARRY
+#define LOG_ARGS 4
+
+// STRUCTURE FOR HOLDING AN UNFORMATTED MESSAGE, FORMAT IS A STATIC STRING
+// AND ARGUMENTS ARE INTEGERS OR STATIC STRINGS, ALL KEPT AS 64 BITS
+typedef struct LogMessage {
+    char const* format;
+    uint64_t args[LOG_ARGS];
+} LogMessage;
+
+// STRUCTURE FOR HOLDING A LOG AS IT IS QUEUED, FORMATTED ONLY BY LOGGER
+typedef struct LogRecord {
+    uint64_t timestamp;
+    char const* name;
+    LogMessage message;
+    int thread;
+    uint8_t level;
+    char padding[3];
+} LogRecord;
+
+// LOWEST LEVEL LOGGED AT RUNTIME, CHECKED BEFORE A RECORD IS BUILT
+extern atomic_int logger_level;
+
+// SELECTION OF A MESSAGE BUILDER BY NUMBER OF ARGUMENTS AFTER FORMAT
+#define LOG_SELECT(format, a, b, c, d, builder, ...) builder
+#define LOG_VALUE(value) ((uint64_t) (uintptr_t) (value))
+#define LOG_MESSAGE0(format) { (format), { 0 } }
+#define LOG_MESSAGE1(format, a) { (format), { LOG_VALUE(a) } }
+#define LOG_MESSAGE2(format, a, b) { (format), { LOG_VALUE(a), LOG_VALUE(b) } }
+#define LOG_MESSAGE3(format, a, b, c) { (format), { LOG_VALUE(a), LOG_VALUE(b), LOG_VALUE(c) } }
+#define LOG_MESSAGE4(format, a, b, c, d) { (format), { LOG_VALUE(a), LOG_VALUE(b), LOG_VALUE(c), LOG_VALUE(d) } }
+#define LOG_MESSAGE(...) \
+    LOG_SELECT(__VA_ARGS__, LOG_MESSAGE4, LOG_MESSAGE3, LOG_MESSAGE2, LOG_MESSAGE1, LOG_MESSAGE0, 0)(__VA_ARGS__)
+
+// NAME AND FORMAT MUST OUTLIVE LOGGER, AS ONLY THEIR POINTERS ARE QUEUED
+#define LOG_AT(level, name, ...) \
+    ((void) ((level) >= atomic_load_explicit(&logger_level, memory_order_relaxed) ? \
+        Logger_write((level), (name), &(LogMessage const) LOG_MESSAGE(__VA_ARGS__)) : 0))
+
+// A CALL BELOW LOG_LEVEL, ITS NAME AND ARGUMENTS ARE ONLY USED IN AN UNEVALUATED
+// CONTEXT, SO THEY STILL COMPILE AND COUNT AS USED, BUT NOTHING IS LEFT IN A BINARY
+#define LOG_NONE(name, ...) ((void) (sizeof((LogMessage) LOG_MESSAGE(__VA_ARGS__)) + sizeof(name)))
+
+#if LOG_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(name, ...) LOG_AT(LOG_LEVEL_TRACE, name, __VA_ARGS__)
+#else
+#define LOG_TRACE(name, ...) LOG_NONE(name, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(name, ...) LOG_AT(LOG_LEVEL_DEBUG, name, __VA_ARGS__)
+#else
+#define LOG_DEBUG(name, ...) LOG_NONE(name, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(name, ...) LOG_AT(LOG_LEVEL_INFO, name, __VA_ARGS__)
+#else
+#define LOG_INFO(name, ...) LOG_NONE(name, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(name, ...) LOG_AT(LOG_LEVEL_WARN, name, __VA_ARGS__)
+#else
+#define LOG_WARN(name, ...) LOG_NONE(name, __VA_ARGS__)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(name, ...) LOG_AT(LOG_LEVEL_ERROR, name, __VA_ARGS__)
+#else
+#define LOG_ERROR(name, ...) LOG_NONE(name, __VA_ARGS__)
+#endif
+
 // DECLARATIONS OF OUTSIDE PROTOTYPES
 int Logger_init(void);
 int Logger_join(void);
 int Logger_start(void);
-int Logger_log(char* const, char* const);
+int Logger_setLevel(int const);
+int Logger_setRotation(size_t const, int const);
+int Logger_write(int const, char const* const, LogMessage const* const);
+uint64_t Logger_dropped(void);
+size_t Logger_format(LogRecord const* const, char* const, size_t const);
+int Logger_flush(void);
 void Logger_terminate(void);
 void Logger_destroy(void);
 
-#endif 
+#endif
@@ -0,0 +1,38 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics.h                       
+    PURPOSE: interface for metrics module 
+*/
+
+#ifndef METRICS_H
+#define METRICS_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdint.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "stats.h"
+#include "buffer.h"
+#include "scheduler.h"
+#include "supervisor.h"
+
+// MACRO DEFINITION, NUMBER OF BUFFERS ONE METRICS OBJECT CAN WATCH
+#define METRICS_BUFFERS 4
+
+// ENCAPSULATION ON METRICS OBJECT
+typedef struct metrics Metrics;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Metrics* Metrics_init(char const* const, uint16_t const, uint16_t const);
+int Metrics_watchBuffer(Metrics* const, char const* const, Buffer* const);
+int Metrics_watchSupervisor(Metrics* const, Supervisor* const, char* const* const, int const);
+int Metrics_watchScheduler(Metrics* const, Scheduler* const);
+void Metrics_publish(Metrics* const, ConvertedStats const* const);
+int Metrics_fd(Metrics* const);
+uint16_t Metrics_port(Metrics* const);
+int Metrics_serve(Metrics* const, int const);
+int Metrics_start(Metrics* const);
+int Metrics_join(Metrics* const);
+void Metrics_destroy(Metrics* const);
+
+#endif
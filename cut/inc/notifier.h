@@ -7,12 +7,17 @@
 #ifndef NOTIFIER_H
 #define NOTIFIER_H
 
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdbool.h>
+#include <stdint.h>
+
 // ENCAPSULATION ON NOTIFIER OBJECT
 typedef struct notifier Notifier;
 
 // DECLARATIONS OF OUTSIDE PROTOTYPES
 Notifier* Notifier_init(void);
 int Notifier_notify(Notifier* const);
+uint64_t Notifier_last(Notifier* const);
 int Notifier_check(Notifier* const, bool*);
 void Notifier_destroy(Notifier* const);
 
@@ -0,0 +1,23 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: pool.h                       
+    PURPOSE: interface for pool module 
+*/
+
+#ifndef POOL_H
+#define POOL_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+
+// ENCAPSULATION ON POOL OBJECT
+typedef struct pool Pool;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Pool* Pool_init(size_t const, size_t const);
+void* Pool_acquire(Pool* const);
+int Pool_release(Pool* const, void* const);
+size_t Pool_available(Pool* const);
+void Pool_destroy(Pool*);
+
+#endif 
@@ -9,17 +9,27 @@
 
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <signal.h>
-#include <stdatomic.h>
+#include <stdbool.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "buffer.h"
+#include "notifier.h"
+#include "pool.h"
+#include "histogram.h"
+#include "screen.h"
+#include "sink.h"
 
 // ENCAPSULATION ON PRINTER OBJECT
 typedef struct printer Printer;
 
 // DECLARATIONS OF PROTOTYPE FUNCTIONS
-Printer* Printer_init(Buffer* const, uint8_t const);
-int Printer_start(Printer* const, volatile sig_atomic_t*, atomic_flag*);
+Printer* Printer_init(Buffer* const, Pool* const, Histogram* const, uint16_t const);
+int Printer_start(Printer* const, volatile sig_atomic_t*);
+int Printer_setLayout(Printer* const, int const);
+int Printer_addSink(Printer* const, Sink* const);
+Notifier* Printer_notifier(Printer* const);
+Screen* Printer_screen(Printer* const);
+int Printer_step(Printer* const, bool const);
 int Printer_join(Printer* const);
 void Printer_destroy(Printer*);
 
@@ -9,18 +9,24 @@
 
 // OUTSIDE LIBRARIES
 #include <signal.h>
-#include <stdatomic.h>
 
 // INSIDE LIBRARIES
 #include "buffer.h"
+#include "notifier.h"
+#include "stats.h"
+#include "scheduler.h"
 
 // ENCAPSULATION ON READER OBJECT
 typedef struct reader Reader;
 
 // PROTOTYPE FUNCTIONS FOR OUTSIDE WORLD
-Reader* Reader_init(Buffer* const, const uint8_t); 
-int Reader_start(Reader* const, volatile sig_atomic_t*, atomic_flag*); 
-int Reader_join(Reader* const);
+Reader* Reader_init(Buffer* const, Scheduler* const, const uint16_t, char const* const, int const); 
+int Reader_start(Reader* const, volatile sig_atomic_t*);
+int Reader_restart(Reader* const);
+Notifier* Reader_notifier(Reader* const); 
+int Reader_step(Reader* const);
+int Reader_read(Reader* const, ProcessorStats* const);
+int Reader_join(Reader* const, long const);
 void Reader_destroy(Reader*);
 
 #endif 
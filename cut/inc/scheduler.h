@@ -0,0 +1,30 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scheduler.h                       
+    PURPOSE: interface for scheduler module 
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <signal.h>
+#include <stdint.h>
+
+// MACRO DEFINITION, BOUNDS OF A SAMPLING INTERVAL IN MILLISECONDS
+#define SCHEDULER_MIN_INTERVAL 10
+#define SCHEDULER_MAX_INTERVAL 1000
+
+// ENCAPSULATION ON SCHEDULER OBJECT
+typedef struct scheduler Scheduler;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Scheduler* Scheduler_init(long const);
+int Scheduler_wait(Scheduler* const, volatile sig_atomic_t* const);
+int Scheduler_arm(Scheduler* const);
+int Scheduler_expire(Scheduler* const);
+uint64_t Scheduler_missed(Scheduler* const);
+uint64_t Scheduler_now(void);
+void Scheduler_destroy(Scheduler*);
+
+#endif 
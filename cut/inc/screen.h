@@ -0,0 +1,41 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: screen.h                       
+    PURPOSE: interface for screen module 
+*/
+
+#ifndef SCREEN_H
+#define SCREEN_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+#include <stdint.h>
+
+// ENCAPSULATION ON SCREEN OBJECT
+typedef struct screen Screen;
+
+// CELL OF A FRAME, UP TO 3 BYTES OF AN UTF-8 GLYPH FROM ITS LOWEST BYTE UP
+// AND A 256 COLOR PALETTE INDEX IN ITS HIGHEST BYTE, 0 FOR DEFAULT COLOR
+typedef uint32_t ScreenCell;
+
+// STRUCTURE FOR HOLDING SCREEN COUNTERS
+typedef struct ScreenStats {
+    uint64_t frames;
+    uint64_t bytes;
+    size_t last;
+} ScreenStats;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Screen* Screen_init(uint16_t const, uint16_t const, int const);
+int Screen_fit(Screen* const);
+void Screen_size(Screen* const, uint16_t* const, uint16_t* const);
+void Screen_clear(Screen* const);
+int Screen_line(Screen* const, uint16_t const, char const* const, ...) __attribute__((format(printf, 3, 4)));
+ScreenCell Screen_glyph(char const* const, uint8_t const);
+int Screen_cell(Screen* const, uint16_t const, uint16_t const, ScreenCell const);
+int Screen_render(Screen* const);
+void Screen_invalidate(Screen* const);
+int Screen_stats(Screen* const, ScreenStats* const);
+void Screen_destroy(Screen* const);
+
+#endif 
@@ -0,0 +1,56 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink.h                       
+    PURPOSE: interface for sink module 
+*/
+
+#ifndef SINK_H
+#define SINK_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+#include <stdint.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "stats.h"
+
+// FIRST FOUR BYTES OF EVERY RECORD OF BINARY SINK, "CUTS" IN MEMORY ORDER
+#define SINK_MAGIC 0x53545543u
+
+// ID OF AGGREGATE CPU ROW OF BINARY SINK, OFFLINE ROWS ARE NOT WRITTEN AT ALL
+#define SINK_AGGREGATE UINT16_MAX
+
+// ENCAPSULATION ON SINK OBJECT
+typedef struct sink Sink;
+
+// STRUCTURE FOR HOLDING A HEADER OF A RECORD OF BINARY SINK, IN HOST BYTE ORDER,
+// FOLLOWED BY ROWS OF SINKROW, AGGREGATE CPU FIRST AND ONLINE CORES AFTER IT
+typedef struct SinkHeader {
+    uint32_t magic;
+    uint16_t rows;
+    uint16_t columns;
+    uint64_t timestamp;
+} SinkHeader;
+
+// STRUCTURE FOR HOLDING A ROW OF BINARY SINK, USAGE FOLLOWED BY EVERY COUNTER COLUMN
+typedef struct SinkRow {
+    uint16_t id;
+    char padding[2];
+    float percentages[COLUMNS + 1];
+} SinkRow;
+
+// STRUCTURE FOR HOLDING SINK COUNTERS
+typedef struct SinkStats {
+    uint64_t records;
+    uint64_t bytes;
+    uint64_t writes;
+} SinkStats;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Sink* Sink_open(int const, char const* const, uint16_t const);
+int Sink_emit(Sink* const, ConvertedStats* const* const, size_t const);
+int Sink_flush(Sink* const);
+int Sink_stats(Sink* const, SinkStats* const);
+int Sink_close(Sink* const);
+
+#endif
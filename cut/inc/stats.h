@@ -8,34 +8,64 @@
 #define STATS_H
 
 // INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
 #include <stdint.h>
 
-// STRUCTURE FOR HOLDING CORESTATS
-typedef struct CoreStats {
-    uint32_t user;
-    uint32_t nice;
-    uint32_t system;
-    uint32_t idle;
-    uint32_t iowait;
-    uint32_t irq;
-    uint32_t sortirq;
-    uint32_t steal;
-} CoreStats;
-
-// STRUCTURE FOR HOLDING PROCESSORSTATS
+// INCLUDES OF INSIDE LIBRARIES
+#include "enums.h"
+
+// STRUCTURE FOR HOLDING PROCESSORSTATS, COUNTERS ARE STORED INLINE AS ONE 
+// COLUMN PER COUNTER OF COUNT + 1 ROWS FOLLOWED BY CPU ID OF EVERY ROW, 
+// ROW 0 IS AGGREGATE CPU, OTHER ROWS ARE SLOTS GIVEN TO CORES BY READER,
+// TIMESTAMP IS MONOTONIC TIME OF THE READ IN NANOSECONDS
 typedef struct ProcessorStats {
-    CoreStats* cores;
-    CoreStats cores_average;
-    uint8_t count;
-    char padding[7];
+    uint64_t timestamp;
+    uint16_t count;
+    char padding[6];
+    uint64_t columns[];
 } ProcessorStats;
 
-// STRUCTURE FOR HOLDING CONVERTEDSTATS
+// ID OF A ROW WHOSE CORE WAS NOT PRESENT IN A SAMPLE
+#define STATS_OFFLINE UINT16_MAX
+
+// SIZE OF IDS OF PROC CORES AND AGGREGATE CPU, ROUNDED SO RECORDS STAY 8 BYTE ALIGNED
+#define STATS_IDS_SIZE(proc) (sizeof(uint64_t) * (((size_t) (proc) + 4) / 4))
+
+// SIZE OF PROCESSORSTATS WITH ROOM FOR PROC CORES
+#define STATS_SIZE(proc) \
+    (sizeof(ProcessorStats) + sizeof(uint64_t) * COLUMNS * ((size_t) (proc) + 1) + STATS_IDS_SIZE(proc))
+
+// DISTANCE BETWEEN COLUMNS OF A GIVEN PROCESSORSTATS
+#define STATS_STRIDE(stats) ((size_t) (stats) -> count + 1)
+
+// FIRST ROW OF A GIVEN COLUMN OF A GIVEN PROCESSORSTATS
+#define STATS_COLUMN(stats, column) \
+    (&((stats) -> columns[(size_t) (column) * STATS_STRIDE(stats)]))
+
+// CPU ID OF EVERY ROW OF A GIVEN PROCESSORSTATS, STATS_OFFLINE FOR EMPTY SLOTS
+#define STATS_IDS(stats) ((uint16_t*) STATS_COLUMN(stats, COLUMNS))
+
+// STRUCTURE FOR HOLDING CONVERTEDSTATS, PERCENTAGES ARE STORED INLINE IN BLOCKS 
+// OF COUNT + 1 ROWS, ROW 0 IS AGGREGATE CPU, ROW N + 1 IS CORE N, FIRST BLOCK
+// IS USAGE AND IT IS FOLLOWED BY A BLOCK FOR EVERY COUNTER COLUMN, 
+// CPU ID OF EVERY ROW FOLLOWS THE LAST BLOCK
 typedef struct ConvertedStats {
-    float* percentages;
-    float percentages_average;
-    uint8_t count;
-    char padding[3];
+    uint64_t timestamp;
+    uint16_t count;
+    char padding[6];
+    float percentages[];
 } ConvertedStats;
 
+// SIZE OF CONVERTEDSTATS WITH ROOM FOR PROC CORES
+#define CONVERTED_SIZE(proc) \
+    (sizeof(ConvertedStats) + sizeof(float) * (COLUMNS + 1) * ((size_t) (proc) + 1) + STATS_IDS_SIZE(proc))
+
+// FIRST ROW OF PERCENTAGES OF A GIVEN COUNTER COLUMN OF A GIVEN CONVERTEDSTATS
+#define CONVERTED_COLUMN(stats, column) \
+    (&((stats) -> percentages[((size_t) (column) + 1) * ((size_t) (stats) -> count + 1)]))
+
+// CPU ID OF EVERY ROW OF A GIVEN CONVERTEDSTATS, STATS_OFFLINE FOR EMPTY SLOTS
+#define CONVERTED_IDS(stats) \
+    ((uint16_t*) &((stats) -> percentages[((size_t) COLUMNS + 1) * ((size_t) (stats) -> count + 1)]))
+
 #endif 
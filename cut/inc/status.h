@@ -0,0 +1,20 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: status.h                       
+    PURPOSE: interface for status module 
+*/
+
+#ifndef STATUS_H
+#define STATUS_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <signal.h>
+#include <time.h>
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+void Status_set(volatile sig_atomic_t* const, int const);
+int Status_sleep(volatile sig_atomic_t* const, long const);
+int Status_sleepUntil(volatile sig_atomic_t* const, struct timespec const* const);
+void Status_deadline(struct timespec* const, long const);
+
+#endif 
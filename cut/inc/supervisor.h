@@ -0,0 +1,44 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: supervisor.h                       
+    PURPOSE: interface for supervisor module 
+*/
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "notifier.h"
+
+// MACRO DEFINITION, NUMBER OF STAGES ONE SUPERVISOR CAN WATCH
+#define SUPERVISOR_STAGES 8
+
+// ENCAPSULATION ON SUPERVISOR OBJECT
+typedef struct supervisor Supervisor;
+
+// CALLBACK RESTARTING A STALLED STAGE, WHICH MUST NOT WAIT FOR ITS OLD THREAD
+typedef int (*SupervisorRestart)(void* const);
+
+// STRUCTURE FOR HOLDING COUNTERS OF A WATCHED STAGE
+typedef struct SupervisorStats {
+    uint64_t stalls;
+    uint64_t restarts;
+    uint64_t stalled;
+} SupervisorStats;
+
+// DECLARATIONS OF OUTSIDE PROTOTYPES
+Supervisor* Supervisor_init(void);
+int Supervisor_watch(Supervisor* const, Notifier* const, char const* const, long const, int const);
+int Supervisor_onRestart(Supervisor* const, int const, SupervisorRestart const, void* const, long const, int const);
+int Supervisor_setConsole(Supervisor* const, FILE* const);
+int Supervisor_start(Supervisor* const, volatile sig_atomic_t* const);
+int Supervisor_join(Supervisor* const);
+int Supervisor_stats(Supervisor* const, int const, SupervisorStats* const);
+void Supervisor_destroy(Supervisor*);
+
+#endif 
@@ -7,12 +7,19 @@
 #ifndef TRACKER_H
 #define TRACKER_H
 
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdint.h>
+
 // ENCAPSULATION ON TRACKER OBJECT
 typedef struct tracker Tracker;
 
 // DECLARATIONS OF OUTSIDE PROTOTYPES
-Tracker* Tracker_init(void);
+Tracker* Tracker_init(long const, int const);
+int Tracker_setLayout(Tracker* const, int const);
+int Tracker_addSink(Tracker* const, int const, char const* const);
+int Tracker_serveMetrics(Tracker* const, char const* const, uint16_t const);
 int Tracker_start(Tracker* const);
+int Tracker_signal(Tracker* const);
 int Tracker_terminate(Tracker* const);
 void Tracker_destroy(Tracker* const);
 
@@ -14,45 +14,62 @@
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/analyzer.h"
 #include "../inc/enums.h"
-#include "../inc/watchdog.h"
 #include "../inc/notifier.h"
 #include "../inc/logger.h"
+#include "../inc/status.h"
 #include "../inc/stats.h"
+#include "../inc/compute.h"
+#include "../inc/sink.h"
+#include "../inc/metrics.h"
+
+// MACRO DEFINITION
+#define BATCH 32
+#define SINKS 8
 
 // PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static int Analyzer_spawn(Analyzer* analyzer);
 static void* Analyzer_threadf(void* args);
+static void Analyzer_baseline(Analyzer* analyzer, ProcessorStats*);
 static int Analyzer_analyze(Analyzer* analyzer, ProcessorStats*, ConvertedStats*);
-static float Analyzer_toPercent(CoreStats*, uint64_t*, uint64_t*);
+static void Analyzer_hotplug(Analyzer* analyzer, ProcessorStats*, ConvertedStats*);
+static void Analyzer_emit(Analyzer* analyzer, bool const);
 
-// STRUCTURE FOR HOLDING ANALYZER OBJECT
+// STRUCTURE FOR HOLDING ANALYZER OBJECT, A HEADLESS ONE HAS NO BUFFERAP AND POOL,
+// BUT A SINGLE RECORD WRITTEN STRAIGHT TO ITS SINKS, EVERY RECORD IS PUBLISHED TO METRICS
 struct analyzer {
-    Watchdog* watchdog;
     Notifier* notifier;
     Buffer* bufferRA;
     Buffer* bufferAP;
+    Pool* pool;
+    ConvertedStats* record;
+    Sink* sinks[SINKS];
+    Metrics* metrics;
+    volatile sig_atomic_t* status;
     pthread_t thread;
-    uint64_t* cores_total_prev;
-    uint64_t* cores_idle_prev;
-    uint64_t cpu_total_prev;
-    uint64_t cpu_idle_prev;
-    uint8_t proc;
+    ComputeKernel kernel;
+    uint64_t* prev;
+    uint16_t* ids;
+    uint16_t proc;
     bool thread_started;
     bool prev_analyzed;
-    char padding[5];
+    int sink_count;
+    char padding[4];
 };
 
 // STRUCTURE FOR HOLDING PARAMS PASSED TO READER THREAD FUNCTION
 typedef struct ThreadParams {
     Analyzer* analyzer;
     volatile sig_atomic_t* status;
-    atomic_flag* status_watch;
 } ThreadParams;
 
 /*
     METHOD: Analyzer_init
     ARGUMENTS:
         bufferRA - an object of Reader-Analyzer buffer
-        bufferAP - an object of Analyzer-Printer buffer
+        bufferAP - an object of Analyzer-Printer buffer, NULL for a headless 
+            analyzer, which writes records to its sinks instead of a printer
+        pool - a pool of converted stats records passed to printer,
+            NULL for a headless analyzer
         proc - a number of cores in a current computer
     PURPOSE: creation of Analyzer object
     RETURN: Analyzer object or NULL in 
@@ -61,17 +78,20 @@ typedef struct ThreadParams {
 Analyzer* Analyzer_init(
     Buffer* bufferRA,
     Buffer* bufferAP,
-    uint8_t proc
+    Pool* pool,
+    uint16_t proc
 ) {
-    Watchdog* watchdog;
     Notifier* notifier;
     Analyzer* analyzer;
+    ConvertedStats* record;
+    uint64_t* prev;
+    uint16_t* ids;
 
-    Logger_log("ANALYZER", "INIT STARTED");
+    LOG_DEBUG("ANALYZER", "INIT STARTED");
 
     if (
         bufferRA == NULL || 
-        bufferAP == NULL ||
+        (bufferAP == NULL) != (pool == NULL) ||
         proc <= 0
     ) { 
         return NULL; 
@@ -81,29 +101,40 @@ Analyzer* Analyzer_init(
 
     if (analyzer == NULL) { return NULL; }
 
+    // ROW 0 IS AGGREGATE CPU, ROW N + 1 IS CORE N
+    prev = calloc(COMPUTE_PREV_BLOCKS * ((size_t) proc + 1), sizeof(uint64_t));
+    ids = calloc((size_t) proc + 1, sizeof(uint16_t));
+    record = pool == NULL ? (ConvertedStats*) malloc(CONVERTED_SIZE(proc)) : NULL;
     notifier = Notifier_init();
 
-    if (notifier == NULL) { return NULL; }
-
-    watchdog = Watchdog_init(notifier, "ANALYZER");
+    if (prev == NULL || ids == NULL || (pool == NULL && record == NULL) || notifier == NULL) { 
+        Notifier_destroy(notifier);
+        free(prev);
+        free(ids);
+        free(record);
+        free(analyzer);
+        return NULL; 
+    }
 
-    if (watchdog == NULL) { return NULL; }
-    
     *analyzer = (Analyzer) {
-        .watchdog = watchdog,
         .notifier = notifier,
         .bufferRA = bufferRA,
         .bufferAP = bufferAP,
+        .pool = pool,
+        .record = record,
+        .sinks = { NULL },
+        .metrics = NULL,
+        .status = NULL,
         .thread_started = false,
         .prev_analyzed = false,
-        .cores_total_prev = NULL,
-        .cores_idle_prev = NULL,
-        .cpu_total_prev = 0,
-        .cpu_idle_prev = 0,
-        .proc = proc
+        .kernel = Compute_kernel(COMPUTE_AUTO),
+        .prev = prev,
+        .ids = ids,
+        .proc = proc,
+        .sink_count = 0
     };
 
-    Logger_log("ANALYZER", "INIT FINISHED");
+    LOG_DEBUG("ANALYZER", "INIT FINISHED");
 
     return analyzer;
 }
@@ -118,36 +149,57 @@ Analyzer* Analyzer_init(
 */
 int Analyzer_start(
     Analyzer* const analyzer,
-    volatile sig_atomic_t* status,
-    atomic_flag* status_watch
+    volatile sig_atomic_t* status
 ) {
-    ThreadParams* params;
+    int result;
 
-    Logger_log("ANALYZER", "START STARTED");
+    LOG_DEBUG("ANALYZER", "START STARTED");
 
     if (
         analyzer == NULL ||
+        analyzer -> thread_started ||
         *status != RUNNING
     ) { return ERR_PARAMS; }
 
+    analyzer -> status = status;
+
+    result = Analyzer_spawn(analyzer);
+
+    if (result != OK) { return result; }
+
+    LOG_DEBUG("ANALYZER", "START FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Analyzer_spawn
+    ARGUMENTS:
+        analyzer - an Analyzer object to work on
+    PURPOSE: creation of analyzer's thread
+    RETURN: enums integer value
+*/
+static int Analyzer_spawn(
+    Analyzer* analyzer
+) {
+    ThreadParams* params;
+
     params = (ThreadParams*) malloc(sizeof(ThreadParams));
 
     if (params == NULL) { return ERR_ALLOC; }
 
     *params = (ThreadParams) {
         .analyzer = analyzer,
-        .status = status,
-        .status_watch = status_watch
+        .status = analyzer -> status
     };
 
     if (pthread_create(&(analyzer -> thread), NULL, Analyzer_threadf, (void*) params) != 0) {
+        free(params);
         return ERR_CREATE;
     }
 
     analyzer -> thread_started = true;
 
-    Logger_log("ANALYZER", "START FINISHED");
-
     return OK;
 }
 
@@ -161,7 +213,7 @@ int Analyzer_start(
 int Analyzer_join(
     Analyzer* const analyzer
 ) {
-    Logger_log("ANALYZER", "JOIN STARTED");
+    LOG_DEBUG("ANALYZER", "JOIN STARTED");
 
     if (analyzer == NULL) { return ERR_PARAMS; }
     if (analyzer -> thread_started == false) { return ERR_PARAMS; }
@@ -169,7 +221,9 @@ int Analyzer_join(
         return ERR_JOIN;
     }
 
-    Logger_log("ANALYZER", "JOIN FINISHED");
+    analyzer -> thread_started = false;
+
+    LOG_DEBUG("ANALYZER", "JOIN FINISHED");
 
     return OK;
 }
@@ -178,208 +232,304 @@ int Analyzer_join(
     METHOD: Analyzer_threadf
     ARGUMENTS:
         args - pointer to function's parameters
-    PURPOSE: acomplishing reader's thread work
+    PURPOSE: acomplishing reader's thread work, ending on its own closes the pipeline
     RETURN: NULL
 */
 static void* Analyzer_threadf(
     void* args
 ) {
     ThreadParams* params;
-    ProcessorStats* stats;
-    ConvertedStats converted;
+    Analyzer* analyzer;
 
-    Logger_log("ANALYZER", "THREAD FUNCTION STARTED");
+    LOG_DEBUG("ANALYZER", "THREAD FUNCTION STARTED");
 
     params = (ThreadParams*)args;
-    stats = malloc(sizeof(ProcessorStats) + sizeof(CoreStats) * params -> analyzer -> proc);
-
-    if (stats == NULL) {
-        pthread_exit(NULL);
-    } 
-
-    Watchdog_start(params -> analyzer -> watchdog, params -> status, params -> status_watch);
+    analyzer = params -> analyzer;
 
+    // DRIVEN BY SAMPLES ARRIVING FROM READER, CLOSED BUFFER ENDS THE LOOP
     while (*(params -> status) == RUNNING) {
-        if (Buffer_pop(params -> analyzer -> bufferRA, stats) != OK) {
-            free(stats);
-            break;
-        }
-        
-        if (Analyzer_analyze(params -> analyzer, stats, &converted) == OK) {
-            if (Buffer_push(params -> analyzer -> bufferAP, &converted) != OK) {
-                free(stats -> cores);
-                free(converted.percentages);
-                break;
-            }
-        }
+        if (Analyzer_step(analyzer) != OK) { break; }
 
-        Notifier_notify(params -> analyzer -> notifier);
-
-        free(stats -> cores);
-        
-        sleep(1);
+        Notifier_notify(analyzer -> notifier);
     }
 
-    Watchdog_join(params -> analyzer -> watchdog);
+    Buffer_close(analyzer -> bufferRA);
+    Buffer_close(analyzer -> bufferAP);
+    Status_set(params -> status, TERMINATED);
 
-    Logger_log("ANALYZER", "THREAD FUNCTION FINISHED");
+    LOG_DEBUG("ANALYZER", "THREAD FUNCTION FINISHED");
 
-    free(stats);
     free(params);
 
     pthread_exit(NULL);
 }
 
 /*
-    METHOD: Analyzer_analyze
+    METHOD: Analyzer_step
     ARGUMENTS:
         analyzer - an Analyzer object to work on
-        processorStats - an object of not processed yet stats
-        convertedStats - an object of processed stats
-    PURPOSE: counts percentage for each core in a given ProcessorStats
-    RETURN: interger meaning if the operation successed or failed with an error
+    PURPOSE: single batch of analyzer's stage, waits for samples from 
+        reader and passes their records to printer, or writes them to 
+        sinks when headless, shared by threaded and event loop mode
+    RETURN: enums integer value, ERR_CLOSED when a buffer was closed
 */
-static int Analyzer_analyze(
-    Analyzer* analyzer,
-    ProcessorStats* processorStats,
-    ConvertedStats* convertedStats
+int Analyzer_step(
+    Analyzer* const analyzer
 ) {
-    uint64_t idle;
-    uint64_t non_idle;
+    ProcessorStats* stats[BATCH];
+    ConvertedStats* converted;
+    size_t peeked;
+    size_t i;
 
-    Logger_log("ANALYZER", "ANALYZE STARTED");
+    if (analyzer == NULL) { return ERR_PARAMS; }
 
-    if (
-        processorStats == NULL || 
-        analyzer == NULL || 
-        convertedStats == NULL
-    ) { 
-        return ERR_PARAMS; 
+    if (Buffer_peekN(analyzer -> bufferRA, (void**) stats, BATCH, &peeked) != OK) {
+        return ERR_CLOSED;
     }
+    
+    for (i = 0; i < peeked; i++) {
+        if (!analyzer -> prev_analyzed) {
+            Analyzer_baseline(analyzer, stats[i]);
+            continue;
+        } 
+
+        // WITHOUT A PRINTER EVERY RECORD IS ENCODED BY SINKS AT ONCE, SO ONE IS REUSED
+        if (analyzer -> record != NULL) {
+            if (Analyzer_analyze(analyzer, stats[i], analyzer -> record) == OK) {
+                Metrics_publish(analyzer -> metrics, analyzer -> record);
+                Analyzer_emit(analyzer, false);
+            }
+            continue;
+        }
 
-    if (!analyzer -> prev_analyzed) {
-        analyzer -> cores_total_prev = malloc(sizeof(uint64_t) * analyzer -> proc);
+        // RECORDS ARE PASSED BY POINTER SO OVERWRITTEN ONES CAN BE RELEASED BY BUFFER
+        converted = (ConvertedStats*) Pool_acquire(analyzer -> pool);
 
-        if (analyzer -> cores_total_prev == NULL) { return ERR_ALLOC; }
-        
-        analyzer -> cores_idle_prev = malloc(sizeof(long) * analyzer -> proc);
+        if (converted == NULL) {
+            LOG_WARN("ANALYZER", "POOL EXHAUSTED, SAMPLE SKIPPED");
+            continue;
+        }
 
-        if (analyzer -> cores_idle_prev == NULL) {
-            free(analyzer -> cores_total_prev);
-            return ERR_ALLOC;
+        if (Analyzer_analyze(analyzer, stats[i], converted) != OK) {
+            Pool_release(analyzer -> pool, converted);
+            continue;
         }
 
-        idle = processorStats -> cores_average.idle 
-            + processorStats -> cores_average.iowait;
-
-        non_idle = processorStats -> cores_average.user 
-            + processorStats -> cores_average.nice 
-            + processorStats -> cores_average.system 
-            + processorStats -> cores_average.irq 
-            + processorStats -> cores_average.sortirq
-            + processorStats -> cores_average.steal;
-
-        analyzer -> cpu_total_prev = idle + non_idle;
-        analyzer -> cpu_idle_prev = idle;
-
-        for(long i = 0; i < processorStats -> count; i++) {
-            idle = processorStats -> cores[i].idle 
-                + processorStats -> cores[i].iowait;
-
-            non_idle = processorStats -> cores[i].user 
-                + processorStats -> cores[i].nice 
-                + processorStats -> cores[i].system 
-                + processorStats -> cores[i].irq 
-                + processorStats -> cores[i].sortirq 
-                + processorStats -> cores[i].steal;
-    
-            analyzer -> cores_total_prev[i] = idle + non_idle;
-            analyzer -> cores_idle_prev[i] = idle;
+        // PUBLISHED BEFORE A PUSH, AFTER WHICH PRINTER MAY ALREADY RELEASE IT
+        Metrics_publish(analyzer -> metrics, converted);
+
+        if (Buffer_push(analyzer -> bufferAP, &converted) != OK) {
+            Pool_release(analyzer -> pool, converted);
+            break;
         }
+    }
+
+    if (analyzer -> record != NULL) { Analyzer_emit(analyzer, true); }
 
-        analyzer -> prev_analyzed = true;
+    if (i < peeked || Buffer_releaseN(analyzer -> bufferRA, peeked) != OK) {
+        return ERR_CLOSED;
+    }
+
+    return OK;
+}
+
+/*
+    METHOD: Analyzer_emit
+    ARGUMENTS:
+        analyzer - a headless Analyzer object to work on
+        flush - false to encode analyzer's record by every sink, 
+            true to write what they encoded, once per batch
+    PURPOSE: passing of records of a headless analyzer to its sinks
+    RETURN: nothing
+*/
+static void Analyzer_emit(
+    Analyzer* analyzer,
+    bool const flush
+) {
+    int result;
 
-        convertedStats -> percentages = NULL;
-        convertedStats -> count = processorStats -> count;
+    for (int i = 0; i < analyzer -> sink_count; i++) {
+        result = flush 
+            ? Sink_flush(analyzer -> sinks[i]) 
+            : Sink_emit(analyzer -> sinks[i], &(analyzer -> record), 1);
 
-        return ANALYZED;
+        if (result != OK) { LOG_WARN("ANALYZER", "RECORD OF SINK %d NOT WRITTEN", i); }
     }
-    
-    convertedStats -> percentages = malloc(sizeof(float) * processorStats -> count);
-    
-    if(convertedStats -> percentages == NULL) { return ERR_ALLOC; }
+}
 
-    convertedStats -> count = processorStats -> count;
-    convertedStats -> percentages_average = Analyzer_toPercent(
-        &processorStats -> cores_average, 
-        &analyzer -> cpu_total_prev, 
-        &analyzer -> cpu_idle_prev
+/*
+    METHOD: Analyzer_addSink
+    ARGUMENTS:
+        analyzer - a headless Analyzer object which was not started yet
+        sink - an opened Sink object, closed by analyzer once added
+    PURPOSE: addition of a sink every record is written to, up to SINKS of them
+    RETURN: enums integer value
+*/
+int Analyzer_addSink(
+    Analyzer* const analyzer,
+    Sink* const sink
+) {
+    if (
+        analyzer == NULL || 
+        sink == NULL || 
+        analyzer -> record == NULL || 
+        analyzer -> sink_count == SINKS
+    ) { return ERR_PARAMS; }
+
+    if (analyzer -> thread_started) { return ERR_RUN; }
+
+    analyzer -> sinks[analyzer -> sink_count++] = sink;
+
+    return OK;
+}
+
+/*
+    METHOD: Analyzer_setMetrics
+    ARGUMENTS:
+        analyzer - an Analyzer object which was not started yet
+        metrics - a Metrics object every analyzed record is published to,
+            not owned by analyzer
+    PURPOSE: choice of where records are published for scrapes, a publish
+        is a copy of a record and never waits for a scrape
+    RETURN: enums integer value
+*/
+int Analyzer_setMetrics(
+    Analyzer* const analyzer,
+    Metrics* const metrics
+) {
+    if (analyzer == NULL || metrics == NULL) { return ERR_PARAMS; }
+    if (analyzer -> thread_started) { return ERR_RUN; }
+
+    analyzer -> metrics = metrics;
+
+    return OK;
+}
+
+/*
+    METHOD: Analyzer_baseline
+    ARGUMENTS:
+        analyzer - an Analyzer object to work on
+        processorStats - the first sample read
+    PURPOSE: saves previous counters of the first sample, 
+        which has nothing to be compared with
+    RETURN: nothing
+*/
+static void Analyzer_baseline(
+    Analyzer* analyzer,
+    ProcessorStats* processorStats
+) {
+    LOG_TRACE("ANALYZER", "BASELINE STARTED");
+
+    Compute_baseline(
+        processorStats -> columns, 
+        STATS_STRIDE(processorStats), 
+        STATS_STRIDE(processorStats), 
+        analyzer -> prev
     );
 
-    for(uint8_t i = 0; i < processorStats -> count; i++) {
-        convertedStats -> percentages[i] = Analyzer_toPercent(
-            &(processorStats -> cores[i]), 
-            &(analyzer -> cores_total_prev[i]), 
-            &(analyzer -> cores_idle_prev[i])
-        );
+    for (size_t row = 0; row <= processorStats -> count; row++) {
+        analyzer -> ids[row] = STATS_IDS(processorStats)[row];
     }
 
-    Logger_log("ANALYZER", "ANALYZE FINISHED");
+    analyzer -> prev_analyzed = true;
 
-    return OK;
+    LOG_TRACE("ANALYZER", "BASELINE FINISHED");
 }
 
 /*
-    METHOD: Analyzer_toPercent
+    METHOD: Analyzer_analyze
     ARGUMENTS:
-        stats - an object of single core stats
-        total_prev - a pointer to previous total value
-        idle_prev - a pointer to previous idle value
-    PURPOSE: counts single core's usage percentage
-    RETURN: float percentage
+        analyzer - an Analyzer object to work on
+        processorStats - an object of not processed yet stats
+        convertedStats - an object of processed stats, 
+            with room for analyzer's core count
+    PURPOSE: counts usage and every counter's percentage 
+        for each core in a given ProcessorStats
+    RETURN: interger meaning if the operation successed or failed with an error
 */
-static float Analyzer_toPercent(
-    CoreStats* stats, 
-    uint64_t* total_prev, 
-    uint64_t* idle_prev
+static int Analyzer_analyze(
+    Analyzer* analyzer,
+    ProcessorStats* processorStats,
+    ConvertedStats* convertedStats
 ) {
-    uint64_t idle;
-    uint64_t non_idle;
-    uint64_t total;
-    uint64_t idled;
-    float percentage;
+    LOG_TRACE("ANALYZER", "ANALYZE STARTED");
+
+    if (
+        processorStats == NULL || 
+        analyzer == NULL || 
+        convertedStats == NULL
+    ) { 
+        return ERR_PARAMS; 
+    }
 
-    Logger_log("ANALYZER", "TOPERCENT STARTED");
+    // USAGE AND EVERY COUNTER OF ALL ROWS ARE COUNTED IN ONE PASS OVER COLUMNS
+    convertedStats -> timestamp = processorStats -> timestamp;
+    convertedStats -> count = processorStats -> count;
+
+    analyzer -> kernel(
+        processorStats -> columns, 
+        STATS_STRIDE(processorStats), 
+        STATS_STRIDE(processorStats), 
+        analyzer -> prev, 
+        convertedStats -> percentages
+    );
 
-    idle = stats -> idle 
-        + stats -> iowait;
+    Analyzer_hotplug(analyzer, processorStats, convertedStats);
 
-    non_idle = stats -> user 
-        + stats -> nice 
-        + stats -> system 
-        + stats -> irq 
-        + stats -> sortirq 
-        + stats -> steal;
+    LOG_TRACE("ANALYZER", "ANALYZE FINISHED");
 
-    total = idle 
-        + non_idle 
-        - *total_prev;
+    return OK;
+}
 
-    idled = idle 
-        - *idle_prev;
+/*
+    METHOD: Analyzer_hotplug
+    ARGUMENTS:
+        analyzer - an Analyzer object to work on
+        processorStats - an object of stats just analyzed
+        convertedStats - an object of processed stats
+    PURPOSE: zeroes percentages of rows whose cpu is offline now or was 
+        offline in previous sample, as they have nothing to be compared 
+        with, previous counters of other rows are kept as they are
+    RETURN: nothing
+*/
+static void Analyzer_hotplug(
+    Analyzer* analyzer,
+    ProcessorStats* processorStats,
+    ConvertedStats* convertedStats
+) {
+    uint16_t const* ids;
+    size_t rows;
 
-    percentage = 0.0f;
+    ids = STATS_IDS(processorStats);
+    rows = STATS_STRIDE(processorStats);
 
-    if(total != 0) { percentage = (float)(total - idled) / (float) total * 100.0f; }
+    for (size_t row = 0; row < rows; row++) {
+        if (ids[row] == STATS_OFFLINE || ids[row] != analyzer -> ids[row]) {
+            for (int block = 0; block < COMPUTE_OUT_BLOCKS; block++) {
+                convertedStats -> percentages[(size_t) block * rows + row] = 0.0f;
+            }
 
-    *total_prev = idle 
-        + non_idle;
+            analyzer -> ids[row] = ids[row];
+        }
 
-    *idle_prev = idle;
+        CONVERTED_IDS(convertedStats)[row] = ids[row];
+    }
+}
 
-    Logger_log("ANALYZER", "TOPERCENT FINISHED");
+/*
+    METHOD: Analyzer_notifier
+    ARGUMENTS:
+        analyzer - an Analyzer object to work on
+    PURPOSE: access to a heartbeat notified by a given object's thread 
+        on every unit of work, to be watched by a supervisor
+    RETURN: Notifier object or NULL
+*/
+Notifier* Analyzer_notifier(
+    Analyzer* const analyzer
+) {
+    if (analyzer == NULL) { return NULL; }
 
-    return percentage;
+    return analyzer -> notifier;
 }
 
 /*
@@ -393,17 +543,21 @@ static float Analyzer_toPercent(
 void Analyzer_destroy(
     Analyzer* analyzer
 ) {
-    Logger_log("ANALYZER", "DESTROY STARTED");
+    LOG_DEBUG("ANALYZER", "DESTROY STARTED");
 
     if (analyzer == NULL) { return; }
 
-    Watchdog_destroy(analyzer -> watchdog);
+    for (int i = 0; i < analyzer -> sink_count; i++) {
+        if (Sink_close(analyzer -> sinks[i]) != OK) { LOG_WARN("ANALYZER", "SINK %d NOT CLOSED CLEANLY", i); }
+    }
+
     Notifier_destroy(analyzer -> notifier);
     
-    free(analyzer -> cores_total_prev);
-    free(analyzer -> cores_idle_prev);
+    free(analyzer -> prev);
+    free(analyzer -> ids);
+    free(analyzer -> record);
 
     free(analyzer);
 
-    Logger_log("ANALYZER", "DESTROY FINISHED");
+    LOG_DEBUG("ANALYZER", "DESTROY FINISHED");
 }
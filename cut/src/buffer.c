@@ -4,18 +4,30 @@
     PURPOSE: implementation of buffer module
 */
 
+// FEATURE MACRO REQUIRED BY PTHREAD_MUTEX_CLOCKLOCK
+#define _GNU_SOURCE
+
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <pthread.h>    
 #include <stdlib.h>     
 #include <string.h>     
+#include <limits.h>
+#include <errno.h>
 #include <time.h>       
+#include <unistd.h>
+#include <stdatomic.h>
 #include <sys/time.h>   
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/buffer.h"
 #include "../inc/enums.h"
 #include "../inc/logger.h"
 
+// MACRO DEFINITION
+#define CACHE_LINE 64
+
 // STRUCTURE FOR HOLDING BUFFER OBJECT
 struct buffer {
     pthread_cond_t can_produce;
@@ -26,41 +38,121 @@ struct buffer {
     size_t count;
     size_t capacity;
     size_t size;
-    uint8_t elements[];   
+    void (*drop)(void* const, void* const);
+    void* drop_context;
+    int type;
+    char padding[4];
+
+    // PRODUCER SIDE OF SPSC BACKEND AND COUNTERS, WRITTEN ONLY BY PRODUCERS
+    _Alignas(CACHE_LINE) atomic_uint spsc_head;
+    unsigned int spsc_tail_cache;
+    atomic_size_t high_water;
+    atomic_size_t drops;
+    atomic_size_t overwrites;
+
+    // CONSUMER SIDE OF SPSC BACKEND, WRITTEN ONLY BY CONSUMER
+    _Alignas(CACHE_LINE) atomic_uint spsc_tail;
+    unsigned int spsc_head_cache;
+
+    // SLOW PATH OF SPSC BACKEND, TOUCHED ONLY WHEN RING IS EMPTY OR FULL
+    _Alignas(CACHE_LINE) atomic_bool closed;
+    atomic_uint consume_futex;
+    atomic_uint consume_waiting;
+    atomic_uint produce_futex;
+    atomic_uint produce_waiting;
+
+    _Alignas(CACHE_LINE) uint8_t elements[];
 };
 
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* Buffer_slot(Buffer* const, size_t const);
+static void Buffer_evict(Buffer* const);
+static int Buffer_claimProduce(Buffer* const, size_t const, struct timespec const* const, size_t* const, size_t* const);
+static int Buffer_publishProduce(Buffer* const, size_t const);
+static int Buffer_claimConsume(Buffer* const, size_t const, struct timespec const* const, size_t* const, size_t* const);
+static int Buffer_publishConsume(Buffer* const, size_t const);
+static int Buffer_lock(pthread_mutex_t* const, struct timespec const* const);
+static int Buffer_wait(Buffer* const, atomic_uint* const, atomic_uint* const, atomic_uint* const, unsigned int const, struct timespec const* const);
+static void Buffer_wake(atomic_uint* const, atomic_uint* const);
+
 /*
     METHOD: Buffer_init
     ARGUMENTS:
         size - size of a single element in an elements array
-        capacity - max count of elements in elements array
+        capacity - max count of elements in elements array,
+            rounded up to a power of two for BUFFER_SPSC
+        type - BUFFER_MPMC for mutex guarded buffer, BUFFER_SPSC
+            for lock-free single producer single consumer buffer or 
+            BUFFER_OVERWRITE for mutex guarded buffer which never
+            blocks producers and overwrites the oldest element instead
     PURPOSE: creation of Buffer object
     RETURN: Buffer object or NULL in 
         case creation was not possible 
 */
 Buffer* Buffer_init(
     size_t const size,
-    size_t const capacity
+    size_t const capacity,
+    int const type
 ) {
     Buffer* buffer;
+    pthread_condattr_t attributes;
+    size_t slots;
+    size_t bytes;
 
     if (size <= 0 || capacity <= 0) { return NULL; }
-    
-    buffer = (Buffer*) malloc(sizeof(Buffer) + (size * capacity));
+    if (
+        type != BUFFER_MPMC && 
+        type != BUFFER_SPSC && 
+        type != BUFFER_OVERWRITE
+    ) { return NULL; }
+
+    slots = capacity;
+
+    if (type == BUFFER_SPSC) {
+        if (capacity > UINT_MAX / 2) { return NULL; }
+
+        slots = 1;
+
+        while (slots < capacity) { slots <<= 1; }
+    }
+
+    bytes = sizeof(Buffer) + (size * slots);
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    buffer = (Buffer*) aligned_alloc(CACHE_LINE, bytes);
 
     if (buffer == NULL) { return NULL; }
 
     *buffer = (Buffer) {
         .mutex = PTHREAD_MUTEX_INITIALIZER,
-        .can_consume = PTHREAD_COND_INITIALIZER,
-        .can_produce = PTHREAD_COND_INITIALIZER,
         .tail = 0,
         .head = 0,
         .count = 0,
-        .capacity = capacity,
-        .size = size
+        .capacity = slots,
+        .size = size,
+        .drop = NULL,
+        .drop_context = NULL,
+        .type = type,
+        .spsc_head = 0,
+        .spsc_tail_cache = 0,
+        .high_water = 0,
+        .drops = 0,
+        .overwrites = 0,
+        .spsc_tail = 0,
+        .spsc_head_cache = 0,
+        .closed = false,
+        .consume_futex = 0,
+        .consume_waiting = 0,
+        .produce_futex = 0,
+        .produce_waiting = 0
     };
 
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&(buffer -> can_consume), &attributes);
+    pthread_cond_init(&(buffer -> can_produce), &attributes);
+    pthread_condattr_destroy(&attributes);
+
     return buffer;
 }
 
@@ -76,6 +168,11 @@ bool Buffer_isEmpty(
 ) {
     if (buffer == NULL) { return false; }
 
+    if (buffer -> type == BUFFER_SPSC) {
+        return atomic_load_explicit(&(buffer -> spsc_head), memory_order_acquire)
+            == atomic_load_explicit(&(buffer -> spsc_tail), memory_order_acquire);
+    }
+
     if (buffer -> count == 0) { return true; }
     else { return false; }
 }
@@ -92,6 +189,12 @@ bool Buffer_isFull(
 ) {
     if (buffer == NULL) { return false; }
 
+    if (buffer -> type == BUFFER_SPSC) {
+        return atomic_load_explicit(&(buffer -> spsc_head), memory_order_acquire)
+            - atomic_load_explicit(&(buffer -> spsc_tail), memory_order_acquire)
+            == buffer -> capacity;
+    }
+
     if (buffer -> count == buffer -> capacity) { return true; }
     else { return false; }
 }
@@ -108,76 +211,892 @@ int Buffer_push(
     Buffer* const buffer, 
     void* const element
 ) {
+    return Buffer_pushTimed(buffer, element, NULL);
+}
+
+/*
+    METHOD: Buffer_pop
+    ARGUMENTS:
+        buffer - an object where an element will be popped
+        element - an object to be popped into a given buffer
+    PURPOSE: pop of an element from a given buffer
+    RETURN: enums integer value
+*/
+int Buffer_pop(
+    Buffer* const buffer, 
+    void* element
+) {
+    return Buffer_popTimed(buffer, element, NULL);
+}
+
+/*
+    METHOD: Buffer_pushTimed
+    ARGUMENTS:
+        buffer - an object where an element will be pushed
+        element - an object to be pushed into a given buffer
+        deadline - absolute CLOCK_MONOTONIC time after which 
+            waiting for a free slot is given up, NULL waits forever
+    PURPOSE: push of an element into buffer with a deadline
+    RETURN: enums integer value, ERR_TIMEOUT when deadline passed,
+        ERR_CLOSED when buffer was closed
+*/
+int Buffer_pushTimed(
+    Buffer* const buffer, 
+    void* const element,
+    struct timespec const* const deadline
+) {
+    size_t start;
+    size_t claimed;
+    int result;
+
     if (buffer == NULL || element == NULL) { return ERR_PARAMS; }
 
-    pthread_mutex_lock(&buffer->mutex);
+    result = Buffer_claimProduce(buffer, 1, deadline, &start, &claimed);
 
-    if (Buffer_isFull(buffer)) {
-        pthread_cond_wait(&(buffer -> can_produce), &(buffer -> mutex));
-    }
+    if (result != OK) { return result; }
 
-    memcpy(
-        &(buffer -> elements[buffer -> head * buffer -> size]),
-        element, 
-        buffer -> size
-    );
+    memcpy(Buffer_slot(buffer, start), element, buffer -> size);
 
-    buffer -> count++;
-    buffer -> head = (buffer -> head + 1) % buffer -> capacity;
+    return Buffer_publishProduce(buffer, claimed);
+}
 
-    pthread_cond_signal(&(buffer -> can_consume));
-    pthread_mutex_unlock(&(buffer -> mutex));
+/*
+    METHOD: Buffer_tryPush
+    ARGUMENTS:
+        buffer - an object where an element will be pushed
+        element - an object to be pushed into a given buffer
+    PURPOSE: push of an element which never waits, 
+        an element which does not fit is dropped and counted
+    RETURN: enums integer value, ERR_TIMEOUT when buffer was full
+*/
+int Buffer_tryPush(
+    Buffer* const buffer, 
+    void* const element
+) {
+    struct timespec const now = { 0, 0 };
 
-    return OK;
+    return Buffer_pushTimed(buffer, element, &now);
 }
 
 /*
-    METHOD: Buffer_pop
+    METHOD: Buffer_popTimed
     ARGUMENTS:
         buffer - an object where an element will be popped
         element - an object to be popped into a given buffer
-    PURPOSE: pop of an element from a given buffer
-    RETURN: enums integer value
+        deadline - absolute CLOCK_MONOTONIC time after which 
+            waiting for an element is given up, NULL waits forever
+    PURPOSE: pop of an element from a given buffer with a deadline
+    RETURN: enums integer value, ERR_TIMEOUT when deadline passed,
+        ERR_CLOSED when buffer was closed and is empty
 */
-int Buffer_pop(
+int Buffer_popTimed(
     Buffer* const buffer, 
-    void* element
+    void* element,
+    struct timespec const* const deadline
 ) {
+    size_t start;
+    size_t claimed;
+    int result;
+
     if (buffer == NULL || element == NULL) { return ERR_PARAMS; }
 
-    pthread_mutex_lock(&(buffer -> mutex));
+    result = Buffer_claimConsume(buffer, 1, deadline, &start, &claimed);
+
+    if (result != OK) { return result; }
 
-    if (Buffer_isEmpty(buffer)) {
-        pthread_cond_wait(&(buffer -> can_consume), &(buffer -> mutex));
+    memcpy(element, Buffer_slot(buffer, start), buffer -> size);
+
+    return Buffer_publishConsume(buffer, claimed);
+}
+
+/*
+    METHOD: Buffer_pushN
+    ARGUMENTS:
+        buffer - an object where elements will be pushed
+        elements - an array of elements to be pushed
+        count - number of elements in a given array
+        pushed - a pointer where number of pushed elements 
+            will be saved, can be NULL
+    PURPOSE: push of as many elements as fit, up to count, 
+        under one synchronization and with one wake of consumer,
+        waits only when buffer is full
+    RETURN: enums integer value
+*/
+int Buffer_pushN(
+    Buffer* const buffer, 
+    void* const elements,
+    size_t const count,
+    size_t* const pushed
+) {
+    size_t start;
+    size_t claimed;
+    int result;
+
+    if (buffer == NULL || elements == NULL || count == 0) { return ERR_PARAMS; }
+
+    result = Buffer_claimProduce(buffer, count, NULL, &start, &claimed);
+
+    if (result != OK) { return result; }
+
+    for (size_t i = 0; i < claimed; i++) {
+        memcpy(
+            Buffer_slot(buffer, start + i), 
+            (uint8_t*) elements + i * buffer -> size, 
+            buffer -> size
+        );
     }
 
-    memcpy(
-        element,
-        &(buffer -> elements[buffer -> tail * buffer -> size]), 
-        buffer -> size
-    );
+    if (pushed != NULL) { *pushed = claimed; }
+
+    return Buffer_publishProduce(buffer, claimed);
+}
+
+/*
+    METHOD: Buffer_popN
+    ARGUMENTS:
+        buffer - an object where elements will be popped
+        elements - an array where popped elements will be saved
+        count - max number of elements to be popped
+        popped - a pointer where number of popped elements 
+            will be saved, can be NULL
+    PURPOSE: pop of all available elements, up to count, 
+        under one synchronization and with one wake of producer,
+        waits only when buffer is empty
+    RETURN: enums integer value
+*/
+int Buffer_popN(
+    Buffer* const buffer, 
+    void* elements,
+    size_t const count,
+    size_t* const popped
+) {
+    size_t start;
+    size_t claimed;
+    int result;
+
+    if (buffer == NULL || elements == NULL || count == 0) { return ERR_PARAMS; }
+
+    result = Buffer_claimConsume(buffer, count, NULL, &start, &claimed);
+
+    if (result != OK) { return result; }
+
+    for (size_t i = 0; i < claimed; i++) {
+        memcpy(
+            (uint8_t*) elements + i * buffer -> size, 
+            Buffer_slot(buffer, start + i), 
+            buffer -> size
+        );
+    }
+
+    if (popped != NULL) { *popped = claimed; }
+
+    return Buffer_publishConsume(buffer, claimed);
+}
+
+/*
+    METHOD: Buffer_reserve
+    ARGUMENTS:
+        buffer - an object where a slot will be reserved
+        slot - a pointer where address of reserved slot will be saved
+    PURPOSE: reservation of a free slot which can be written in place,
+        waits when buffer is full, every reservation has to be 
+        followed by Buffer_commit or Buffer_cancel from the same thread,
+        BUFFER_MPMC stays locked for both sides until then,
+        not available for BUFFER_OVERWRITE
+    RETURN: enums integer value
+*/
+int Buffer_reserve(
+    Buffer* const buffer,
+    void** const slot
+) {
+    size_t start;
+    size_t claimed;
+    int result;
+
+    if (buffer == NULL || slot == NULL) { return ERR_PARAMS; }
+    if (buffer -> type == BUFFER_OVERWRITE) { return ERR_PARAMS; }
+
+    result = Buffer_claimProduce(buffer, 1, NULL, &start, &claimed);
+
+    if (result != OK) { return result; }
+
+    *slot = Buffer_slot(buffer, start);
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_commit
+    ARGUMENTS:
+        buffer - an object where reserved slot will be published
+    PURPOSE: publication of a slot taken by Buffer_reserve to consumer
+    RETURN: enums integer value
+*/
+int Buffer_commit(
+    Buffer* const buffer
+) {
+    if (buffer == NULL) { return ERR_PARAMS; }
+
+    return Buffer_publishProduce(buffer, 1);
+}
+
+/*
+    METHOD: Buffer_cancel
+    ARGUMENTS:
+        buffer - an object where reserved slot will be given back
+    PURPOSE: drop of a slot taken by Buffer_reserve without publishing it,
+        used when a reserved slot could not be filled
+    RETURN: enums integer value
+*/
+int Buffer_cancel(
+    Buffer* const buffer
+) {
+    if (buffer == NULL) { return ERR_PARAMS; }
+
+    // SPSC HEAD MOVES ONLY ON COMMIT, OTHER TYPES HOLD MUTEX SINCE CLAIM
+    if (buffer -> type != BUFFER_SPSC) { pthread_mutex_unlock(&(buffer -> mutex)); }
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_peek
+    ARGUMENTS:
+        buffer - an object where the oldest slot will be peeked
+        slot - a pointer where address of the oldest slot will be saved
+    PURPOSE: access to the oldest element without copying it,
+        waits when buffer is empty, every peek has to be 
+        followed by Buffer_release from the same thread,
+        not available for BUFFER_OVERWRITE
+    RETURN: enums integer value
+*/
+int Buffer_peek(
+    Buffer* const buffer,
+    void** const slot
+) {
+    size_t count;
+
+    return Buffer_peekN(buffer, slot, 1, &count);
+}
+
+/*
+    METHOD: Buffer_peekN
+    ARGUMENTS:
+        buffer - an object where the oldest slots will be peeked
+        slots - an array where addresses of peeked slots will be saved
+        count - max number of slots to be peeked
+        peeked - a pointer where number of peeked slots will be saved
+    PURPOSE: access to all available elements, up to count, without 
+        copying them, waits when buffer is empty, has to be followed
+        by Buffer_releaseN of peeked count from the same thread,
+        BUFFER_MPMC stays locked for both sides until then,
+        not available for BUFFER_OVERWRITE since peeked slots 
+        could be overwritten
+    RETURN: enums integer value
+*/
+int Buffer_peekN(
+    Buffer* const buffer,
+    void** const slots,
+    size_t const count,
+    size_t* const peeked
+) {
+    size_t start;
+    size_t claimed;
+    int result;
+
+    if (
+        buffer == NULL || 
+        slots == NULL || 
+        peeked == NULL || 
+        count == 0 ||
+        buffer -> type == BUFFER_OVERWRITE
+    ) { return ERR_PARAMS; }
+
+    result = Buffer_claimConsume(buffer, count, NULL, &start, &claimed);
+
+    if (result != OK) { return result; }
+
+    for (size_t i = 0; i < claimed; i++) {
+        slots[i] = Buffer_slot(buffer, start + i);
+    }
+
+    *peeked = claimed;
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_release
+    ARGUMENTS:
+        buffer - an object where peeked slot will be freed
+    PURPOSE: return of a slot taken by Buffer_peek to producer
+    RETURN: enums integer value
+*/
+int Buffer_release(
+    Buffer* const buffer
+) {
+    return Buffer_releaseN(buffer, 1);
+}
+
+/*
+    METHOD: Buffer_releaseN
+    ARGUMENTS:
+        buffer - an object where peeked slots will be freed
+        count - number of slots to be freed
+    PURPOSE: return of slots taken by Buffer_peekN to producer
+        with one wake of producer
+    RETURN: enums integer value
+*/
+int Buffer_releaseN(
+    Buffer* const buffer,
+    size_t const count
+) {
+    if (buffer == NULL || count == 0) { return ERR_PARAMS; }
+
+    return Buffer_publishConsume(buffer, count);
+}
+
+/*
+    METHOD: Buffer_slot
+    ARGUMENTS:
+        buffer - an object which slot will be returned
+        position - position of a slot, taken modulo capacity
+    PURPOSE: address of an element on a given position
+    RETURN: pointer to a slot
+*/
+static void* Buffer_slot(
+    Buffer* const buffer,
+    size_t const position
+) {
+    if (buffer -> type == BUFFER_SPSC) {
+        return &(buffer -> elements[(position & (buffer -> capacity - 1)) * buffer -> size]);
+    }
+
+    return &(buffer -> elements[(position % buffer -> capacity) * buffer -> size]);
+}
+
+/*
+    METHOD: Buffer_evict
+    ARGUMENTS:
+        buffer - a BUFFER_OVERWRITE object with its mutex locked
+    PURPOSE: drop of the oldest element to make room for a new one,
+        its payload is passed to a drop callback
+    RETURN: nothing
+*/
+static void Buffer_evict(
+    Buffer* const buffer
+) {
+    if (buffer -> drop != NULL) {
+        buffer -> drop(Buffer_slot(buffer, buffer -> tail), buffer -> drop_context);
+    }
 
     buffer -> count--;
     buffer -> tail = (buffer -> tail + 1) % buffer -> capacity;
 
+    atomic_fetch_add_explicit(&(buffer -> overwrites), 1, memory_order_relaxed);
+}
+
+/*
+    METHOD: Buffer_claimProduce
+    ARGUMENTS:
+        buffer - an object where free slots will be claimed
+        count - max number of slots to be claimed
+        deadline - absolute CLOCK_MONOTONIC deadline of waiting, 
+            NULL waits forever
+        start - a pointer where position of the first slot will be saved
+        claimed - a pointer where number of claimed slots will be saved
+    PURPOSE: waits for at least one free slot and claims 
+        as many as available, up to count
+    RETURN: enums integer value
+*/
+static int Buffer_claimProduce(
+    Buffer* const buffer,
+    size_t const count,
+    struct timespec const* const deadline,
+    size_t* const start,
+    size_t* const claimed
+) {
+    unsigned int head;
+    size_t free_slots;
+    int result;
+
+    if (buffer -> type == BUFFER_SPSC) {
+        head = atomic_load_explicit(&(buffer -> spsc_head), memory_order_relaxed);
+
+        while (head - buffer -> spsc_tail_cache == buffer -> capacity) {
+            buffer -> spsc_tail_cache = atomic_load_explicit(&(buffer -> spsc_tail), memory_order_acquire);
+
+            if (head - buffer -> spsc_tail_cache != buffer -> capacity) { break; }
+
+            result = Buffer_wait(
+                buffer,
+                &(buffer -> produce_futex),
+                &(buffer -> produce_waiting),
+                &(buffer -> spsc_tail),
+                buffer -> spsc_tail_cache,
+                deadline
+            );
+
+            if (result != OK) { 
+                atomic_fetch_add_explicit(&(buffer -> drops), 1, memory_order_relaxed);
+                return result; 
+            }
+        }
+
+        if (atomic_load_explicit(&(buffer -> closed), memory_order_relaxed)) { 
+            atomic_fetch_add_explicit(&(buffer -> drops), 1, memory_order_relaxed);
+            return ERR_CLOSED; 
+        }
+
+        free_slots = buffer -> capacity - (head - buffer -> spsc_tail_cache);
+
+        if (free_slots < count) {
+            buffer -> spsc_tail_cache = atomic_load_explicit(&(buffer -> spsc_tail), memory_order_acquire);
+            free_slots = buffer -> capacity - (head - buffer -> spsc_tail_cache);
+        }
+
+        *start = head;
+        *claimed = free_slots < count ? free_slots : count;
+
+        return OK;
+    }
+
+    // OTHER TYPES KEEP THEIR ONLY MUTEX FROM CLAIM TO PUBLISH, SO A PUSH LOCKS IT ONCE
+    result = Buffer_lock(&(buffer -> mutex), deadline);
+
+    if (result != OK) { 
+        atomic_fetch_add_explicit(&(buffer -> drops), 1, memory_order_relaxed);
+        return result; 
+    }
+
+    if (buffer -> type == BUFFER_OVERWRITE && !buffer -> closed) {
+        while (buffer -> capacity - buffer -> count < count && buffer -> count > 0) {
+            Buffer_evict(buffer);
+        }
+
+        free_slots = buffer -> capacity - buffer -> count;
+
+        *start = buffer -> head;
+        *claimed = free_slots < count ? free_slots : count;
+
+        return OK;
+    }
+
+    while (!buffer -> closed && Buffer_isFull(buffer)) {
+        if (deadline == NULL) {
+            pthread_cond_wait(&(buffer -> can_produce), &(buffer -> mutex));
+        } else if (pthread_cond_timedwait(&(buffer -> can_produce), &(buffer -> mutex), deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    result = buffer -> closed ? ERR_CLOSED : Buffer_isFull(buffer) ? ERR_TIMEOUT : OK;
+
+    free_slots = buffer -> capacity - buffer -> count;
+
+    *start = buffer -> head;
+    *claimed = free_slots < count ? free_slots : count;
+
+    if (result != OK) { 
+        pthread_mutex_unlock(&(buffer -> mutex)); 
+        atomic_fetch_add_explicit(&(buffer -> drops), 1, memory_order_relaxed);
+    }
+
+    return result;
+}
+
+/*
+    METHOD: Buffer_publishProduce
+    ARGUMENTS:
+        buffer - an object where claimed slots will be published
+        count - number of slots to be published
+    PURPOSE: publication of claimed slots to consumer with one wake,
+        high-water mark of occupancy is updated on the way
+    RETURN: enums integer value
+*/
+static int Buffer_publishProduce(
+    Buffer* const buffer,
+    size_t const count
+) {
+    unsigned int head;
+    size_t occupancy;
+
+    if (buffer -> type == BUFFER_SPSC) {
+        head = atomic_load_explicit(&(buffer -> spsc_head), memory_order_relaxed) + (unsigned int) count;
+        atomic_store_explicit(&(buffer -> spsc_head), head, memory_order_release);
+
+        // CACHED TAIL GIVES AN UPPER BOUND, EXACT TAIL IS READ ONLY WHEN IT MAY BE A NEW MARK
+        occupancy = head - buffer -> spsc_tail_cache;
+
+        if (occupancy > atomic_load_explicit(&(buffer -> high_water), memory_order_relaxed)) {
+            occupancy = head - atomic_load_explicit(&(buffer -> spsc_tail), memory_order_relaxed);
+
+            if (occupancy > atomic_load_explicit(&(buffer -> high_water), memory_order_relaxed)) {
+                atomic_store_explicit(&(buffer -> high_water), occupancy, memory_order_relaxed);
+            }
+        }
+
+        Buffer_wake(&(buffer -> consume_futex), &(buffer -> consume_waiting));
+
+        return OK;
+    }
+
+    // MUTEX IS LOCKED SINCE CLAIM
+    buffer -> count += count;
+    buffer -> head = (buffer -> head + count) % buffer -> capacity;
+
+    if (buffer -> count > atomic_load_explicit(&(buffer -> high_water), memory_order_relaxed)) {
+        atomic_store_explicit(&(buffer -> high_water), buffer -> count, memory_order_relaxed);
+    }
+
+    pthread_cond_signal(&(buffer -> can_consume));
+    pthread_mutex_unlock(&(buffer -> mutex));
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_claimConsume
+    ARGUMENTS:
+        buffer - an object where filled slots will be claimed
+        count - max number of slots to be claimed
+        deadline - absolute CLOCK_MONOTONIC deadline of waiting, 
+            NULL waits forever
+        start - a pointer where position of the first slot will be saved
+        claimed - a pointer where number of claimed slots will be saved
+    PURPOSE: waits for at least one element and claims 
+        as many as available, up to count, elements left 
+        in a closed buffer can still be claimed
+    RETURN: enums integer value
+*/
+static int Buffer_claimConsume(
+    Buffer* const buffer,
+    size_t const count,
+    struct timespec const* const deadline,
+    size_t* const start,
+    size_t* const claimed
+) {
+    unsigned int tail;
+    size_t available;
+    int result;
+
+    if (buffer -> type == BUFFER_SPSC) {
+        tail = atomic_load_explicit(&(buffer -> spsc_tail), memory_order_relaxed);
+
+        while (tail == buffer -> spsc_head_cache) {
+            buffer -> spsc_head_cache = atomic_load_explicit(&(buffer -> spsc_head), memory_order_acquire);
+
+            if (tail != buffer -> spsc_head_cache) { break; }
+
+            result = Buffer_wait(
+                buffer,
+                &(buffer -> consume_futex),
+                &(buffer -> consume_waiting),
+                &(buffer -> spsc_head),
+                tail,
+                deadline
+            );
+
+            if (result == ERR_CLOSED) {
+                buffer -> spsc_head_cache = atomic_load_explicit(&(buffer -> spsc_head), memory_order_acquire);
+
+                if (tail != buffer -> spsc_head_cache) { break; }
+            }
+
+            if (result != OK) { return result; }
+        }
+
+        available = buffer -> spsc_head_cache - tail;
+
+        if (available < count) {
+            buffer -> spsc_head_cache = atomic_load_explicit(&(buffer -> spsc_head), memory_order_acquire);
+            available = buffer -> spsc_head_cache - tail;
+        }
+
+        *start = tail;
+        *claimed = available < count ? available : count;
+
+        return OK;
+    }
+
+    // MUTEX STAYS LOCKED UNTIL RELEASE, SO CLAIMED SLOTS CANNOT BE OVERWRITTEN OR CLAIMED TWICE
+    result = Buffer_lock(&(buffer -> mutex), deadline);
+
+    if (result != OK) { return result; }
+
+    while (!buffer -> closed && Buffer_isEmpty(buffer)) {
+        if (deadline == NULL) {
+            pthread_cond_wait(&(buffer -> can_consume), &(buffer -> mutex));
+        } else if (pthread_cond_timedwait(&(buffer -> can_consume), &(buffer -> mutex), deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+
+    result = !Buffer_isEmpty(buffer) ? OK : buffer -> closed ? ERR_CLOSED : ERR_TIMEOUT;
+
+    available = buffer -> count;
+
+    *start = buffer -> tail;
+    *claimed = available < count ? available : count;
+
+    if (result != OK) { pthread_mutex_unlock(&(buffer -> mutex)); }
+
+    return result;
+}
+
+/*
+    METHOD: Buffer_publishConsume
+    ARGUMENTS:
+        buffer - an object where claimed slots will be freed
+        count - number of slots to be freed
+    PURPOSE: return of claimed slots to producer with one wake
+    RETURN: enums integer value
+*/
+static int Buffer_publishConsume(
+    Buffer* const buffer,
+    size_t const count
+) {
+    unsigned int tail;
+
+    if (buffer -> type == BUFFER_SPSC) {
+        tail = atomic_load_explicit(&(buffer -> spsc_tail), memory_order_relaxed);
+        atomic_store_explicit(&(buffer -> spsc_tail), tail + (unsigned int) count, memory_order_release);
+
+        Buffer_wake(&(buffer -> produce_futex), &(buffer -> produce_waiting));
+
+        return OK;
+    }
+
+    buffer -> count -= count;
+    buffer -> tail = (buffer -> tail + count) % buffer -> capacity;
+
     pthread_cond_signal(&(buffer -> can_produce));
     pthread_mutex_unlock(&(buffer -> mutex));
 
     return OK;
 }
 
+/*
+    METHOD: Buffer_onDrop
+    ARGUMENTS:
+        buffer - an object which callback will be set
+        drop - a function called with an element which is overwritten
+            or still left in buffer when it is destroyed
+        context - a pointer passed to every call of a given function
+    PURPOSE: set of a callback freeing payloads of dropped elements,
+        has to be called before buffer is shared between threads
+    RETURN: enums integer value
+*/
+int Buffer_onDrop(
+    Buffer* const buffer,
+    void (*drop)(void* const, void* const),
+    void* const context
+) {
+    if (buffer == NULL) { return ERR_PARAMS; }
+
+    buffer -> drop = drop;
+    buffer -> drop_context = context;
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_stats
+    ARGUMENTS:
+        buffer - an object which counters will be read
+        stats - an object where counters will be saved
+    PURPOSE: read of occupancy and loss counters, 
+        counters are read without locking and may be slightly stale
+    RETURN: enums integer value
+*/
+int Buffer_stats(
+    Buffer* const buffer,
+    BufferStats* const stats
+) {
+    if (buffer == NULL || stats == NULL) { return ERR_PARAMS; }
+
+    *stats = (BufferStats) {
+        .count = buffer -> type == BUFFER_SPSC
+            ? (size_t) (atomic_load(&(buffer -> spsc_head)) - atomic_load(&(buffer -> spsc_tail)))
+            : buffer -> count,
+        .capacity = buffer -> capacity,
+        .high_water = atomic_load_explicit(&(buffer -> high_water), memory_order_relaxed),
+        .drops = atomic_load_explicit(&(buffer -> drops), memory_order_relaxed),
+        .overwrites = atomic_load_explicit(&(buffer -> overwrites), memory_order_relaxed)
+    };
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_close
+    ARGUMENTS:
+        buffer - an object to be closed
+    PURPOSE: wakes all waiting producers and consumers, producers 
+        get ERR_CLOSED at once, consumers after buffer is drained,
+        for BUFFER_SPSC it is async-signal-safe
+    RETURN: nothing
+*/
+void Buffer_close(
+    Buffer* const buffer
+) {
+    if (buffer == NULL) { return; }
+
+    if (buffer -> type == BUFFER_SPSC) {
+        atomic_store(&(buffer -> closed), true);
+
+        atomic_fetch_add(&(buffer -> consume_futex), 1);
+        atomic_fetch_add(&(buffer -> produce_futex), 1);
+
+        syscall(SYS_futex, (unsigned int*) &(buffer -> consume_futex), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+        syscall(SYS_futex, (unsigned int*) &(buffer -> produce_futex), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+
+        return;
+    }
+
+    pthread_mutex_lock(&(buffer -> mutex));
+
+    buffer -> closed = true;
+
+    pthread_cond_broadcast(&(buffer -> can_consume));
+    pthread_cond_broadcast(&(buffer -> can_produce));
+    pthread_mutex_unlock(&(buffer -> mutex));
+}
+
+/*
+    METHOD: Buffer_lock
+    ARGUMENTS:
+        mutex - a mutex to be locked
+        deadline - absolute CLOCK_MONOTONIC deadline of waiting, 
+            NULL waits forever
+    PURPOSE: lock of a mutex with an optional deadline, a zero one 
+        of a call which must not wait for room still waits for a mutex, 
+        as it is held only for a claim, so contention alone drops nothing
+    RETURN: OK or ERR_TIMEOUT
+*/
+static int Buffer_lock(
+    pthread_mutex_t* const mutex,
+    struct timespec const* const deadline
+) {
+    if (deadline == NULL || (deadline -> tv_sec == 0 && deadline -> tv_nsec == 0)) {
+        pthread_mutex_lock(mutex);
+        return OK;
+    }
+
+    if (pthread_mutex_clocklock(mutex, CLOCK_MONOTONIC, deadline) != 0) { return ERR_TIMEOUT; }
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_wait
+    ARGUMENTS:
+        buffer - an object which is waited on
+        futex - futex word of a waiting side
+        waiting - flag telling the other side that someone sleeps
+        index - index of the other side which is awaited to change
+        seen - last seen value of a given index
+        deadline - absolute CLOCK_MONOTONIC deadline of waiting, 
+            NULL waits forever
+    PURPOSE: sleep until the other side moves its index,
+        returns at once when the index has already moved
+    RETURN: OK, ERR_TIMEOUT when deadline passed 
+        or ERR_CLOSED when buffer was closed
+*/
+static int Buffer_wait(
+    Buffer* const buffer,
+    atomic_uint* const futex,
+    atomic_uint* const waiting,
+    atomic_uint* const index,
+    unsigned int const seen,
+    struct timespec const* const deadline
+) {
+    unsigned int sequence;
+    long result;
+
+    sequence = atomic_load_explicit(futex, memory_order_acquire);
+
+    atomic_store_explicit(waiting, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    result = 0;
+
+    if (atomic_load_explicit(&(buffer -> closed), memory_order_relaxed)) {
+        atomic_store_explicit(waiting, 0, memory_order_relaxed);
+        return ERR_CLOSED;
+    }
+
+    if (deadline != NULL && deadline -> tv_sec == 0 && deadline -> tv_nsec == 0) {
+        atomic_store_explicit(waiting, 0, memory_order_relaxed);
+        return ERR_TIMEOUT;
+    }
+
+    if (atomic_load_explicit(index, memory_order_acquire) == seen) {
+        result = syscall(
+            SYS_futex, 
+            (unsigned int*) futex, 
+            FUTEX_WAIT_BITSET_PRIVATE, 
+            sequence, 
+            deadline, 
+            NULL, 
+            FUTEX_BITSET_MATCH_ANY
+        );
+    }
+
+    atomic_store_explicit(waiting, 0, memory_order_relaxed);
+
+    if (result != 0 && errno == ETIMEDOUT) { return ERR_TIMEOUT; }
+
+    return OK;
+}
+
+/*
+    METHOD: Buffer_wake
+    ARGUMENTS:
+        futex - futex word of a waiting side
+        waiting - flag telling that someone sleeps on a given futex
+    PURPOSE: wake of the other side, syscall is made only when it sleeps
+    RETURN: nothing
+*/
+static void Buffer_wake(
+    atomic_uint* const futex,
+    atomic_uint* const waiting
+) {
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(waiting, memory_order_relaxed) == 0) { return; }
+
+    atomic_fetch_add_explicit(futex, 1, memory_order_release);
+    syscall(SYS_futex, (unsigned int*) futex, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
 /*
     METHOD: Buffer_destroy
     ARGUMENTS:
         buffer - an object where memory will be freed
-    PURPOSE: free of a given object's memory
+    PURPOSE: free of a given object's memory, payloads of elements
+        left in buffer are passed to a drop callback
     RETURN: nothing
 */
 void Buffer_destroy(
     Buffer* buffer
 ) {
+    size_t position;
+    size_t end;
+
     if (buffer == NULL) { return; }
 
+    if (buffer -> drop != NULL) {
+        position = buffer -> type == BUFFER_SPSC ? atomic_load(&(buffer -> spsc_tail)) : buffer -> tail;
+        end = buffer -> type == BUFFER_SPSC 
+            ? position + (unsigned int) (atomic_load(&(buffer -> spsc_head)) - atomic_load(&(buffer -> spsc_tail)))
+            : position + buffer -> count;
+
+        for (; position < end; position++) {
+            buffer -> drop(Buffer_slot(buffer, position), buffer -> drop_context);
+        }
+    }
+
     pthread_mutex_destroy(&(buffer -> mutex));
     pthread_cond_destroy(&(buffer -> can_produce));
     pthread_cond_destroy(&(buffer -> can_consume));
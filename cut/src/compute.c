@@ -0,0 +1,457 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute.c                       
+    PURPOSE: implementation of compute module, kernels counting usage 
+        and per counter percentages of many cores in one pass over
+        columns of counters, vectorized kernels are picked at runtime
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COMPUTE_X86
+#endif
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/compute.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION, CELL OF A GIVEN COLUMN OR BLOCK AT A GIVEN ROW
+#define CELL(columns, stride, column, row) ((columns) + (size_t) (column) * (stride) + (row))
+
+// MACRO DEFINITION, BLOCKS OF PREVIOUS STATE FOLLOWING PREVIOUS COUNTERS
+#define PREV_TOTAL COLUMNS
+#define PREV_IDLE (COLUMNS + 1)
+
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static void Compute_sums(uint64_t const* const, size_t const, size_t const, uint64_t* const, uint64_t* const);
+static float Compute_percent(uint64_t const, uint64_t const);
+static void Compute_row(uint64_t const* const, size_t const, size_t const, uint64_t* const, float* const);
+static void Compute_scalar(uint64_t const* const, size_t const, size_t const, uint64_t* const, float* const);
+
+#ifdef COMPUTE_X86
+static void Compute_sse2(uint64_t const* const, size_t const, size_t const, uint64_t* const, float* const);
+static void Compute_avx2(uint64_t const* const, size_t const, size_t const, uint64_t* const, float* const);
+#endif
+
+/*
+    METHOD: Compute_kernel
+    ARGUMENTS:
+        type - COMPUTE_AUTO for the fastest kernel this cpu supports
+            or COMPUTE_SCALAR, COMPUTE_SSE2, COMPUTE_AVX2 for a given one
+    PURPOSE: runtime dispatch of a percentage kernel, every kernel 
+        gives the same results bit for bit
+    RETURN: kernel or NULL when a given one is not supported
+*/
+ComputeKernel Compute_kernel(
+    int const type
+) {
+#ifdef COMPUTE_X86
+    __builtin_cpu_init();
+
+    switch (type) {
+        case COMPUTE_AUTO:
+            return __builtin_cpu_supports("avx2") 
+                ? Compute_avx2 
+                : __builtin_cpu_supports("sse2") ? Compute_sse2 : Compute_scalar;
+        case COMPUTE_SCALAR:
+            return Compute_scalar;
+        case COMPUTE_SSE2:
+            return __builtin_cpu_supports("sse2") ? Compute_sse2 : NULL;
+        case COMPUTE_AVX2:
+            return __builtin_cpu_supports("avx2") ? Compute_avx2 : NULL;
+        default:
+            return NULL;
+    }
+#else
+    return type == COMPUTE_AUTO || type == COMPUTE_SCALAR ? Compute_scalar : NULL;
+#endif
+}
+
+/*
+    METHOD: Compute_baseline
+    ARGUMENTS:
+        columns - first row of the first column of counters
+        stride - distance between columns
+        rows - number of rows to be processed
+        prev - COMPUTE_PREV_BLOCKS blocks of rows of state kept between samples
+    PURPOSE: saving of the first sample which later deltas are counted from
+    RETURN: nothing
+*/
+void Compute_baseline(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev
+) {
+    for (int column = 0; column < COLUMNS; column++) {
+        for (size_t row = 0; row < rows; row++) {
+            *CELL(prev, rows, column, row) = *CELL(columns, stride, column, row);
+        }
+    }
+
+    Compute_sums(columns, stride, rows, CELL(prev, rows, PREV_TOTAL, 0), CELL(prev, rows, PREV_IDLE, 0));
+}
+
+/*
+    METHOD: Compute_sums
+    ARGUMENTS:
+        columns - first row of the first column of counters
+        stride - distance between columns
+        rows - number of rows to be summed
+        total - totals of every row, guest time is already part of user
+        idle - idle times of every row
+    PURPOSE: summing of idle and total time of given rows
+    RETURN: nothing
+*/
+static void Compute_sums(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const total,
+    uint64_t* const idle
+) {
+    for (size_t row = 0; row < rows; row++) {
+        idle[row] = *CELL(columns, stride, COLUMN_IDLE, row)
+            + *CELL(columns, stride, COLUMN_IOWAIT, row);
+
+        total[row] = idle[row]
+            + *CELL(columns, stride, COLUMN_USER, row)
+            + *CELL(columns, stride, COLUMN_NICE, row)
+            + *CELL(columns, stride, COLUMN_SYSTEM, row)
+            + *CELL(columns, stride, COLUMN_IRQ, row)
+            + *CELL(columns, stride, COLUMN_SOFTIRQ, row)
+            + *CELL(columns, stride, COLUMN_STEAL, row);
+    }
+}
+
+/*
+    METHOD: Compute_percent
+    ARGUMENTS:
+        total - total time passed since previous sample
+        part - part of it spent in a given way
+    PURPOSE: counting of a single percentage, reference for vector kernels
+    RETURN: float percentage
+*/
+static float Compute_percent(
+    uint64_t const total,
+    uint64_t const part
+) {
+    if (total == 0) { return 0.0f; }
+
+    return (float) part / (float) total * 100.0f;
+}
+
+/*
+    METHOD: Compute_row
+    ARGUMENTS:
+        columns - a given row of the first column of counters
+        stride - distance between columns
+        rows - distance between blocks of previous state and percentages
+        prev - a given row of the first block of previous state
+        percentages - a given row of the first block of percentages
+    PURPOSE: counting of usage and per counter percentages of one row
+    RETURN: nothing
+*/
+static void Compute_row(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev,
+    float* const percentages
+) {
+    uint64_t total;
+    uint64_t idle;
+    uint64_t delta;
+
+    Compute_sums(columns, stride, 1, &total, &idle);
+
+    delta = total - *CELL(prev, rows, PREV_TOTAL, 0);
+
+    percentages[0] = Compute_percent(delta, delta - (idle - *CELL(prev, rows, PREV_IDLE, 0)));
+
+    for (int column = 0; column < COLUMNS; column++) {
+        *CELL(percentages, rows, column + 1, 0) = Compute_percent(
+            delta, 
+            *CELL(columns, stride, column, 0) - *CELL(prev, rows, column, 0)
+        );
+
+        *CELL(prev, rows, column, 0) = *CELL(columns, stride, column, 0);
+    }
+
+    *CELL(prev, rows, PREV_TOTAL, 0) = total;
+    *CELL(prev, rows, PREV_IDLE, 0) = idle;
+}
+
+/*
+    METHOD: Compute_scalar
+    ARGUMENTS:
+        columns - first row of the first column of counters
+        stride - distance between columns
+        rows - number of rows to be processed, also distance 
+            between blocks of previous state and percentages
+        prev - COMPUTE_PREV_BLOCKS blocks of rows of previous 
+            sample's state, replaced by current ones
+        percentages - COMPUTE_OUT_BLOCKS blocks of rows, usage 
+            percentage followed by percentage of every counter
+    PURPOSE: counting of percentages one row at a time
+    RETURN: nothing
+*/
+static void Compute_scalar(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev,
+    float* const percentages
+) {
+    for (size_t row = 0; row < rows; row++) {
+        Compute_row(columns + row, stride, rows, prev + row, percentages + row);
+    }
+}
+
+#ifdef COMPUTE_X86
+
+/*
+    METHOD: Compute_sse2Pack
+    ARGUMENTS:
+        values - two uint64 lanes known to be below 2^31
+    PURPOSE: conversion of two lanes into the low two float lanes,
+        through int32 which rounds exactly like uint64 below 2^31
+    RETURN: converted lanes
+*/
+static inline __m128 Compute_sse2Pack(
+    __m128i const values
+) {
+    return _mm_cvtepi32_ps(_mm_shuffle_epi32(values, _MM_SHUFFLE(3, 3, 2, 0)));
+}
+
+/*
+    METHOD: Compute_sse2
+    ARGUMENTS: the same as Compute_scalar
+    PURPOSE: counting of percentages two rows at a time, rare rows 
+        with deltas of 2^31 or more fall back to scalar conversion
+    RETURN: nothing
+*/
+static void Compute_sse2(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev,
+    float* const percentages
+) {
+    __m128i counters[COLUMNS];
+    __m128i parts[COLUMNS + 1];
+    __m128i idle;
+    __m128i total;
+    __m128i delta;
+    __m128i check;
+    __m128 divisor;
+    __m128 hundred;
+    __m128 zero;
+    uint64_t deltas[2];
+    uint64_t values[2];
+    size_t row;
+
+    hundred = _mm_set1_ps(100.0f);
+
+    for (row = 0; row + 2 <= rows; row += 2) {
+        for (int column = 0; column < COLUMNS; column++) {
+            counters[column] = _mm_loadu_si128((__m128i const*) CELL(columns, stride, column, row));
+            parts[column + 1] = _mm_sub_epi64(counters[column], _mm_loadu_si128((__m128i const*) CELL(prev, rows, column, row)));
+
+            _mm_storeu_si128((__m128i*) CELL(prev, rows, column, row), counters[column]);
+        }
+
+        idle = _mm_add_epi64(counters[COLUMN_IDLE], counters[COLUMN_IOWAIT]);
+        total = _mm_add_epi64(
+            _mm_add_epi64(
+                _mm_add_epi64(counters[COLUMN_USER], counters[COLUMN_NICE]),
+                _mm_add_epi64(counters[COLUMN_SYSTEM], counters[COLUMN_IRQ])
+            ),
+            _mm_add_epi64(_mm_add_epi64(counters[COLUMN_SOFTIRQ], counters[COLUMN_STEAL]), idle)
+        );
+
+        delta = _mm_sub_epi64(total, _mm_loadu_si128((__m128i const*) CELL(prev, rows, PREV_TOTAL, row)));
+        parts[0] = _mm_sub_epi64(delta, _mm_sub_epi64(idle, _mm_loadu_si128((__m128i const*) CELL(prev, rows, PREV_IDLE, row))));
+
+        _mm_storeu_si128((__m128i*) CELL(prev, rows, PREV_TOTAL, row), total);
+        _mm_storeu_si128((__m128i*) CELL(prev, rows, PREV_IDLE, row), idle);
+
+        check = delta;
+
+        for (int block = 0; block < COLUMNS + 1; block++) { check = _mm_or_si128(check, parts[block]); }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi64(check, 31), _mm_setzero_si128())) != 0xFFFF) {
+            _mm_storeu_si128((__m128i*) deltas, delta);
+
+            for (int block = 0; block < COLUMNS + 1; block++) {
+                _mm_storeu_si128((__m128i*) values, parts[block]);
+
+                *CELL(percentages, rows, block, row) = Compute_percent(deltas[0], values[0]);
+                *CELL(percentages, rows, block, row + 1) = Compute_percent(deltas[1], values[1]);
+            }
+            continue;
+        }
+
+        divisor = Compute_sse2Pack(delta);
+        zero = _mm_cmpeq_ps(divisor, _mm_setzero_ps());
+
+        for (int block = 0; block < COLUMNS + 1; block++) {
+            _mm_storel_pi(
+                (__m64*) CELL(percentages, rows, block, row), 
+                _mm_andnot_ps(zero, _mm_mul_ps(_mm_div_ps(Compute_sse2Pack(parts[block]), divisor), hundred))
+            );
+        }
+    }
+
+    for (; row < rows; row++) {
+        Compute_row(columns + row, stride, rows, prev + row, percentages + row);
+    }
+}
+
+/*
+    METHOD: Compute_avx2Pack
+    ARGUMENTS:
+        low - four uint64 lanes known to be below 2^31, rows 0 to 3
+        high - four uint64 lanes known to be below 2^31, rows 4 to 7
+    PURPOSE: conversion of eight lanes into eight float lanes,
+        through int32 which rounds exactly like uint64 below 2^31
+    RETURN: converted lanes
+*/
+__attribute__((target("avx2")))
+static inline __m256 Compute_avx2Pack(
+    __m256i const low,
+    __m256i const high
+) {
+    __m256i const order = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+    return _mm256_cvtepi32_ps(_mm256_inserti128_si256(
+        _mm256_permutevar8x32_epi32(low, order), 
+        _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(high, order)), 
+        1
+    ));
+}
+
+/*
+    METHOD: Compute_avx2Deltas
+    ARGUMENTS:
+        columns, stride, rows, prev - the same as Compute_scalar
+        row - first of four rows to be processed
+        delta - total time passed since previous sample
+        parts - non idle time followed by every counter's 
+            time passed since previous sample
+    PURPOSE: counting of deltas of four rows with saving of current state
+    RETURN: deltas and parts or-ed together, for a range check
+*/
+__attribute__((target("avx2")))
+static inline __m256i Compute_avx2Deltas(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev,
+    size_t const row,
+    __m256i* const delta,
+    __m256i* const parts
+) {
+    __m256i counters[COLUMNS];
+    __m256i idle;
+    __m256i total;
+    __m256i check;
+
+    for (int column = 0; column < COLUMNS; column++) {
+        counters[column] = _mm256_loadu_si256((__m256i const*) CELL(columns, stride, column, row));
+        parts[column + 1] = _mm256_sub_epi64(counters[column], _mm256_loadu_si256((__m256i const*) CELL(prev, rows, column, row)));
+
+        _mm256_storeu_si256((__m256i*) CELL(prev, rows, column, row), counters[column]);
+    }
+
+    idle = _mm256_add_epi64(counters[COLUMN_IDLE], counters[COLUMN_IOWAIT]);
+    total = _mm256_add_epi64(
+        _mm256_add_epi64(
+            _mm256_add_epi64(counters[COLUMN_USER], counters[COLUMN_NICE]),
+            _mm256_add_epi64(counters[COLUMN_SYSTEM], counters[COLUMN_IRQ])
+        ),
+        _mm256_add_epi64(_mm256_add_epi64(counters[COLUMN_SOFTIRQ], counters[COLUMN_STEAL]), idle)
+    );
+
+    *delta = _mm256_sub_epi64(total, _mm256_loadu_si256((__m256i const*) CELL(prev, rows, PREV_TOTAL, row)));
+    parts[0] = _mm256_sub_epi64(*delta, _mm256_sub_epi64(idle, _mm256_loadu_si256((__m256i const*) CELL(prev, rows, PREV_IDLE, row))));
+
+    _mm256_storeu_si256((__m256i*) CELL(prev, rows, PREV_TOTAL, row), total);
+    _mm256_storeu_si256((__m256i*) CELL(prev, rows, PREV_IDLE, row), idle);
+
+    check = *delta;
+
+    for (int block = 0; block < COLUMNS + 1; block++) { check = _mm256_or_si256(check, parts[block]); }
+
+    return check;
+}
+
+/*
+    METHOD: Compute_avx2
+    ARGUMENTS: the same as Compute_scalar
+    PURPOSE: counting of percentages eight rows at a time, 
+        with the same conversion rules as Compute_sse2
+    RETURN: nothing
+*/
+__attribute__((target("avx2")))
+static void Compute_avx2(
+    uint64_t const* const columns,
+    size_t const stride,
+    size_t const rows,
+    uint64_t* const prev,
+    float* const percentages
+) {
+    __m256i delta[2];
+    __m256i parts[2][COLUMNS + 1];
+    __m256i check;
+    __m256 divisor;
+    __m256 hundred;
+    __m256 zero;
+    uint64_t deltas[8];
+    uint64_t values[8];
+    size_t row;
+
+    hundred = _mm256_set1_ps(100.0f);
+
+    for (row = 0; row + 8 <= rows; row += 8) {
+        check = _mm256_or_si256(
+            Compute_avx2Deltas(columns, stride, rows, prev, row, &delta[0], parts[0]),
+            Compute_avx2Deltas(columns, stride, rows, prev, row + 4, &delta[1], parts[1])
+        );
+
+        if (!_mm256_testz_si256(_mm256_srli_epi64(check, 31), _mm256_set1_epi64x(-1))) {
+            _mm256_storeu_si256((__m256i*) deltas, delta[0]);
+            _mm256_storeu_si256((__m256i*) (deltas + 4), delta[1]);
+
+            for (int block = 0; block < COLUMNS + 1; block++) {
+                _mm256_storeu_si256((__m256i*) values, parts[0][block]);
+                _mm256_storeu_si256((__m256i*) (values + 4), parts[1][block]);
+
+                for (size_t i = 0; i < 8; i++) {
+                    *CELL(percentages, rows, block, row + i) = Compute_percent(deltas[i], values[i]);
+                }
+            }
+            continue;
+        }
+
+        divisor = Compute_avx2Pack(delta[0], delta[1]);
+        zero = _mm256_cmp_ps(divisor, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+        for (int block = 0; block < COLUMNS + 1; block++) {
+            _mm256_storeu_ps(
+                CELL(percentages, rows, block, row), 
+                _mm256_andnot_ps(zero, _mm256_mul_ps(_mm256_div_ps(Compute_avx2Pack(parts[0][block], parts[1][block]), divisor), hundred))
+            );
+        }
+    }
+
+    for (; row < rows; row++) {
+        Compute_row(columns + row, stride, rows, prev + row, percentages + row);
+    }
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: format.c                       
+    PURPOSE: implementation of format module, numbers written 
+        as decimal text without printf and without a terminator,
+        shared by sinks, metrics and screen
+*/
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/format.h"
+
+/*
+    METHOD: Format_unsigned
+    ARGUMENTS:
+        output - where digits are saved
+        number - a number to be written
+    PURPOSE: composition of decimal digits of a number
+    RETURN: number of digits
+*/
+size_t Format_unsigned(
+    char* const output,
+    uint64_t const number
+) {
+    char digits[20];
+    size_t count;
+    uint64_t rest;
+
+    count = 0;
+    rest = number;
+
+    do {
+        digits[count++] = (char) ('0' + rest % 10);
+        rest /= 10;
+    } while (rest > 0);
+
+    for (size_t i = 0; i < count; i++) { output[i] = digits[count - 1 - i]; }
+
+    return count;
+}
+
+/*
+    METHOD: Format_float
+    ARGUMENTS:
+        output - where a number is saved
+        value - a number to be written
+    PURPOSE: composition of a number rounded to hundredths, 
+        NAN is written as 0 and magnitudes past FORMAT_FLOAT_LIMIT 
+        as FORMAT_FLOAT_LIMIT, so a number never takes more 
+        than FORMAT_FLOAT_SIZE bytes
+    RETURN: length of a composed number
+*/
+size_t Format_float(
+    char* const output,
+    double const value
+) {
+    uint64_t hundredths;
+    double magnitude;
+    size_t length;
+
+    magnitude = value < 0.0 ? -value : value;
+
+    if (!(magnitude <= FORMAT_FLOAT_LIMIT)) { magnitude = magnitude > FORMAT_FLOAT_LIMIT ? FORMAT_FLOAT_LIMIT : 0.0; }
+
+    hundredths = (uint64_t) (magnitude * 100.0 + 0.5);
+    length = 0;
+
+    if (value < 0.0 && hundredths > 0) { output[length++] = '-'; }
+
+    length += Format_unsigned(output + length, hundredths / 100);
+    output[length++] = '.';
+    output[length++] = (char) ('0' + hundredths / 10 % 10);
+    output[length++] = (char) ('0' + hundredths % 10);
+
+    return length;
+}
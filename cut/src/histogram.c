@@ -0,0 +1,236 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: histogram.c                       
+    PURPOSE: implementation of histogram module, log-linear buckets of
+        nanosecond values, four per power of two, so a record is a couple
+        of instructions and any percentile is off by under 25 percent
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/histogram.h"
+
+// MACRO DEFINITION, 4 EXACT BUCKETS AND 4 FOR EVERY POWER OF TWO FROM 4 TO 2^63
+#define SUB_BUCKETS 4
+#define BUCKETS (SUB_BUCKETS * 63)
+
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static unsigned int Histogram_bucket(uint64_t const);
+static uint64_t Histogram_upper(unsigned int const);
+
+// STRUCTURE FOR HOLDING HISTOGRAM OBJECT, WRITTEN BY ONE THREAD, READ BY ANY
+struct histogram {
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t max;
+    atomic_uint_fast64_t buckets[BUCKETS];
+};
+
+/*
+    METHOD: Histogram_init
+    ARGUMENTS: none
+    PURPOSE: creation of an empty Histogram object
+    RETURN: Histogram object or NULL in case creation was not possible
+*/
+Histogram* Histogram_init(
+    void
+) {
+    Histogram* histogram;
+
+    histogram = (Histogram*) calloc(1, sizeof(Histogram));
+
+    return histogram;
+}
+
+/*
+    METHOD: Histogram_bucket
+    ARGUMENTS:
+        value - a recorded value
+    PURPOSE: finding of a bucket of a given value, from its highest 
+        set bit and two bits right below it
+    RETURN: index of a bucket
+*/
+static unsigned int Histogram_bucket(
+    uint64_t const value
+) {
+    unsigned int exponent;
+
+    if (value < SUB_BUCKETS) { return (unsigned int) value; }
+
+    exponent = 63u - (unsigned int) __builtin_clzll(value);
+
+    return (exponent - 1) * SUB_BUCKETS + (unsigned int) ((value >> (exponent - 2)) & (SUB_BUCKETS - 1));
+}
+
+/*
+    METHOD: Histogram_upper
+    ARGUMENTS:
+        bucket - index of a bucket
+    PURPOSE: finding of the highest value which falls into a given bucket
+    RETURN: upper bound of a bucket
+*/
+static uint64_t Histogram_upper(
+    unsigned int const bucket
+) {
+    unsigned int exponent;
+    uint64_t lower;
+
+    if (bucket < SUB_BUCKETS) { return bucket; }
+
+    exponent = bucket / SUB_BUCKETS + 1;
+    lower = (uint64_t) (SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 2);
+
+    return lower + ((uint64_t) 1 << (exponent - 2)) - 1;
+}
+
+/*
+    METHOD: Histogram_record
+    ARGUMENTS:
+        histogram - an object where a value will be recorded
+        value - a value to be recorded
+    PURPOSE: recording of a single value, only one thread may record
+        so counters are updated without read-modify-write instructions
+    RETURN: nothing
+*/
+void Histogram_record(
+    Histogram* const histogram,
+    uint64_t const value
+) {
+    atomic_uint_fast64_t* bucket;
+
+    if (histogram == NULL) { return; }
+
+    bucket = &(histogram -> buckets[Histogram_bucket(value)]);
+
+    atomic_store_explicit(bucket, atomic_load_explicit(bucket, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&(histogram -> count), atomic_load_explicit(&(histogram -> count), memory_order_relaxed) + 1, memory_order_relaxed);
+
+    if (value > atomic_load_explicit(&(histogram -> max), memory_order_relaxed)) {
+        atomic_store_explicit(&(histogram -> max), value, memory_order_relaxed);
+    }
+}
+
+/*
+    METHOD: Histogram_count
+    ARGUMENTS:
+        histogram - an object which values will be counted
+    PURPOSE: read of a number of recorded values
+    RETURN: number of recorded values
+*/
+uint64_t Histogram_count(
+    Histogram* const histogram
+) {
+    if (histogram == NULL) { return 0; }
+
+    return atomic_load_explicit(&(histogram -> count), memory_order_relaxed);
+}
+
+/*
+    METHOD: Histogram_max
+    ARGUMENTS:
+        histogram - an object which highest value will be read
+    PURPOSE: read of the highest recorded value
+    RETURN: the highest recorded value, exact
+*/
+uint64_t Histogram_max(
+    Histogram* const histogram
+) {
+    if (histogram == NULL) { return 0; }
+
+    return atomic_load_explicit(&(histogram -> max), memory_order_relaxed);
+}
+
+/*
+    METHOD: Histogram_percentile
+    ARGUMENTS:
+        histogram - an object which percentile will be found
+        percentile - a percentile between 0 and 100
+    PURPOSE: finding of a value below which a given percent of values fall
+    RETURN: upper bound of a bucket holding a given percentile, 
+        never above the highest recorded value, 0 when histogram is empty
+*/
+uint64_t Histogram_percentile(
+    Histogram* const histogram,
+    double const percentile
+) {
+    uint64_t count;
+    uint64_t rank;
+    uint64_t seen;
+    uint64_t upper;
+
+    count = Histogram_count(histogram);
+
+    if (count == 0) { return 0; }
+
+    rank = (uint64_t) ((double) count * percentile / 100.0 + 0.5);
+    rank = rank == 0 ? 1 : rank > count ? count : rank;
+    seen = 0;
+
+    for (unsigned int bucket = 0; bucket < BUCKETS; bucket++) {
+        seen += atomic_load_explicit(&(histogram -> buckets[bucket]), memory_order_relaxed);
+
+        if (seen >= rank) {
+            upper = Histogram_upper(bucket);
+            return upper < Histogram_max(histogram) ? upper : Histogram_max(histogram);
+        }
+    }
+
+    return Histogram_max(histogram);
+}
+
+/*
+    METHOD: Histogram_print
+    ARGUMENTS:
+        histogram - an object to be printed
+        name - a name of recorded values
+        file - a stream where histogram will be printed
+    PURPOSE: printing of percentiles and non empty buckets in microseconds
+    RETURN: nothing
+*/
+void Histogram_print(
+    Histogram* const histogram,
+    char const* const name,
+    FILE* const file
+) {
+    uint64_t count;
+
+    if (histogram == NULL || name == NULL || file == NULL) { return; }
+
+    fprintf(file, "================ %s ================\n", name);
+    fprintf(
+        file,
+        "samples %" PRIu64 ", p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+        Histogram_count(histogram),
+        (double) Histogram_percentile(histogram, 50.0) / 1000.0,
+        (double) Histogram_percentile(histogram, 90.0) / 1000.0,
+        (double) Histogram_percentile(histogram, 99.0) / 1000.0,
+        (double) Histogram_percentile(histogram, 99.9) / 1000.0,
+        (double) Histogram_max(histogram) / 1000.0
+    );
+
+    for (unsigned int bucket = 0; bucket < BUCKETS; bucket++) {
+        count = atomic_load_explicit(&(histogram -> buckets[bucket]), memory_order_relaxed);
+
+        if (count == 0) { continue; }
+
+        fprintf(file, "  <= %12.1f us: %" PRIu64 "\n", (double) Histogram_upper(bucket) / 1000.0, count);
+    }
+}
+
+/*
+    METHOD: Histogram_destroy
+    ARGUMENTS:
+        histogram - an object to be freed
+    PURPOSE: free of a given object's memory
+    RETURN: nothing
+*/
+void Histogram_destroy(
+    Histogram* histogram
+) {
+    free(histogram);
+}
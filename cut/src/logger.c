@@ -4,38 +4,98 @@
     PURPOSE: implementation of logger module
 */
 
+// FEATURE MACRO NEEDED BY GETTID AND MEMRCHR
+#define _GNU_SOURCE
+
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <inttypes.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/buffer.h"
 #include "../inc/enums.h"
 #include "../inc/logger.h"
+#include "../inc/status.h"
 
 // DEFINITIONS OF MACRO
 #define PATH "logs/log.txt"
+#define PATH_SIZE 64
+#define MESSAGE_SIZE 256
+#define BATCH 32
+#define THREADS 64
+#define QUEUE_CAPACITY 512
+#define SEGMENT_SIZE (4u << 20)
+#define SEGMENTS 4
+#define PERIOD 10
+#define NANOSECONDS 1000000000u
+
+// STRUCTURE FOR HOLDING A QUEUE OF A SINGLE PRODUCING THREAD
+typedef struct LogQueue {
+    Buffer* buffer;
+    size_t reported;
+    int thread;
+    atomic_bool orphaned;
+    char padding[3];
+} LogQueue;
 
 // STRUCTURE FOR HOLDING LOGGER SINGLETON OBJECT
 typedef struct logger {
     pthread_t thread;
-    Buffer* buffer;
-    FILE* file;
+    pthread_mutex_t mutex;
+    pthread_key_t key;
+    _Atomic(LogQueue*) queues[THREADS];
+    LogRecord* records;
+    char* segment;
+    size_t length;
+    uint64_t dropped;
+    int file;
     volatile sig_atomic_t status;
-    char padding[4];
 } Logger;
 
 // STATIC GLOBAL VARIABLES
 static bool initialized = false;
 static bool joined = false;
 static bool started = false;
+static unsigned epoch = 0;
+static size_t segment_size = SEGMENT_SIZE;
+static int segments = SEGMENTS;
 static Logger* logger;
 
+// QUEUE OF A CALLING THREAD, VALID ONLY FOR LOGGER OF ITS EPOCH
+static _Thread_local LogQueue* local = NULL;
+static _Thread_local unsigned local_epoch = 0;
+static _Thread_local int local_thread = 0;
+
+// EVERY LEVEL COMPILED IN IS LOGGED UNTIL RAISED
+atomic_int logger_level = ATOMIC_VAR_INIT(LOG_LEVEL);
+
+// NAMES OF LOG LEVELS, IN LOG_LEVEL_* ORDER
+static char const* const LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+
 // PROTOTYPE FUNCTIONS DECLARATIONS
 static void* Logger_threadf(void* const);
+static int Logger_register(void);
+static void Logger_orphan(void* const);
+static void Logger_drain(void);
+static void Logger_report(LogQueue* const);
+static void Logger_append(LogRecord const* const);
+static int Logger_open(void);
+static void Logger_seal(void);
+static int Logger_rotate(void);
+static void Logger_shift(void);
+static size_t Logger_conversion(char const* const, uint64_t const, char* const, size_t const);
 
 /*
     METHOD: Logger_init
@@ -46,33 +106,44 @@ static void* Logger_threadf(void* const);
 int Logger_init(
     void
 ) {
-    FILE* file;
-    Buffer* buffer;
+    LogRecord* records;
 
     if (initialized) { return ERR_INIT; }
 
-    file = fopen(PATH, "w");
-    if (file == NULL) { return ERR_FILE_OPEN; }
+    records = (LogRecord*) malloc(sizeof(LogRecord) * BATCH);
+    logger = (Logger*) calloc(1, sizeof(Logger));
 
-    buffer = Buffer_init(sizeof(char) * 256, 100);
-    if (buffer == NULL) {
-        fclose(file);
-        return ERR_ALLOC;
+    if (records == NULL || logger == NULL) { 
+        free(records);
+        free(logger);
+        return ERR_ALLOC; 
     }
 
-    logger = (Logger*) malloc(sizeof(Logger));
+    logger -> file = -1;
 
-    if (logger == NULL) { 
-        fclose(file);
-        return ERR_ALLOC; 
+    // SEGMENT LEFT BY A PREVIOUS RUN IS RECOVERED AND KEPT AS THE NEWEST ROTATED ONE
+    if (Logger_open() != OK || (logger -> length > 0 && Logger_rotate() != OK)) {
+        Logger_seal();
+        free(records);
+        free(logger);
+        return ERR_FILE_OPEN;
+    }
+
+    // KEY ONLY MARKS QUEUES OF ENDED THREADS, SO LOGGER CAN FREE THEM ONCE DRAINED
+    if (pthread_key_create(&(logger -> key), Logger_orphan) != 0) {
+        Logger_seal();
+        free(records);
+        free(logger);
+        return ERR_INIT;
     }
-    
-    *logger = (Logger) {
-        .buffer = buffer,
-        .file = file,
-        .status = CREATED
-    };
 
+    logger -> mutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+    logger -> records = records;
+    logger -> status = CREATED;
+
+    epoch++;
+    joined = false;
+    started = false;
     initialized = true;
     
     return OK;
@@ -89,12 +160,17 @@ int Logger_join(
 ) {
     if (joined) { return ERR_JOIN; }
 
-    if (pthread_join(logger -> thread, NULL) != 0) {
-        fclose(logger -> file);
-        free(logger);
+    if (!started) {
+        Logger_flush();
+    } else if (pthread_join(logger -> thread, NULL) != 0) {
         return ERR_JOIN;
     }
 
+    // SEGMENT IS CUT TO ITS LINES, SO A FINISHED LOG HAS NO PREALLOCATED TAIL
+    pthread_mutex_lock(&(logger -> mutex));
+    Logger_seal();
+    pthread_mutex_unlock(&(logger -> mutex));
+
     joined = true;
 
     return OK;
@@ -109,13 +185,12 @@ int Logger_join(
 int Logger_start(
     void
 ) {
+    if (!initialized) { return ERR_INIT; }
     if (started) { return ERR_RUN; }
     
     logger -> status = RUNNING;
 
     if (pthread_create(&(logger -> thread), NULL, Logger_threadf, NULL) != 0) {
-        fclose(logger -> file);
-        free(logger);
         return ERR_CREATE; 
     }
     
@@ -128,92 +203,624 @@ int Logger_start(
     METHOD: Logger_threadf
     ARGUMENTS: 
         args - arguments passed by Logger_start function
-    PURPOSE: completing Logger thread duties
+    PURPOSE: completing Logger thread duties, every period queues 
+        of all threads are drained, formatted and written in batches,
+        once terminated they are drained a last time
     RETURN: pointer
 */
 static void* Logger_threadf(
     void* const args
 ) {
-    char* message;
-
     (void) args;
 
-    message = malloc(sizeof(char) * 256);
+    while (true) {
+        Logger_drain();
+
+        if (logger -> status != RUNNING) { break; }
+
+        Status_sleep(&(logger -> status), PERIOD);
+    }
+
+    pthread_exit(NULL);
+}
+
+/*
+    METHOD: Logger_write
+    ARGUMENTS: 
+        level - level of a given message
+        name - name of a module which invoked this function, a static string
+        message - format with its arguments, copied as they are
+    PURPOSE: queueing of an unformatted record on calling thread's own 
+        queue, stamped with realtime clock and thread id, formatting
+        is left to logger, modules log through LOG_* macros instead,
+        a caller never waits, a record which does not fit is dropped
+    RETURN: int from enums, explaining result, ERR_PUSH when dropped
+*/
+int Logger_write(
+    int const level,
+    char const* const name,
+    LogMessage const* const message
+) {
+    struct timespec now;
+    LogRecord record;
+
+    if (!initialized) { return ERR_INIT; }
+    if (name == NULL || message == NULL || message -> format == NULL) { return ERR_PARAMS; }
+    if (local == NULL || local_epoch != epoch) {
+        if (Logger_register() != OK) { return ERR_ALLOC; }
+    }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    record = (LogRecord) {
+        .timestamp = (uint64_t) now.tv_sec * NANOSECONDS + (uint64_t) now.tv_nsec,
+        .name = name,
+        .message = *message,
+        .thread = local_thread,
+        .level = (uint8_t) level
+    };
+
+    // WITHOUT LOGGER THREAD NOBODY ELSE MAKES ROOM, SO A FULL QUEUE IS FLUSHED IN PLACE
+    if (!started && Buffer_isFull(local -> buffer)) { Logger_flush(); }
+
+    // QUEUE COUNTS WHAT IT DROPS, LOGGER REPORTS IT ON ITS NEXT DRAIN
+    if (Buffer_tryPush(local -> buffer, &record) != OK) {
+        return ERR_PUSH;
+    }
+
+    return OK;
+}
+
+/*
+    METHOD: Logger_register
+    ARGUMENTS: none
+    PURPOSE: creation of a queue of calling thread on its first log,
+        its slot is taken without logger mutex, so a thread never 
+        waits for a drain which may be rotating segments
+    RETURN: int from enums, explaining result
+*/
+static int Logger_register(
+    void
+) {
+    LogQueue* expected;
+    LogQueue* queue;
+    int result;
+
+    queue = (LogQueue*) malloc(sizeof(LogQueue));
 
-    if (message == NULL) {pthread_exit(NULL); }
+    if (queue == NULL) { return ERR_ALLOC; }
 
-    while (logger -> status == RUNNING) {
-        if (Buffer_pop(logger -> buffer, message) != OK) {
+    queue -> buffer = Buffer_init(sizeof(LogRecord), QUEUE_CAPACITY, BUFFER_SPSC);
+    queue -> reported = 0;
+    queue -> thread = (int) gettid();
+    atomic_init(&(queue -> orphaned), false);
+
+    if (queue -> buffer == NULL) {
+        free(queue);
+        return ERR_ALLOC;
+    }
+
+    result = ERR_ALLOC;
+
+    // ONLY REGISTRATION FILLS A SLOT AND ONLY DRAIN EMPTIES IT, SO A SWAP FROM NULL IS ENOUGH
+    for (int i = 0; i < THREADS; i++) {
+        expected = NULL;
+
+        if (atomic_compare_exchange_strong(&(logger -> queues[i]), &expected, queue)) {
+            result = OK;
             break;
         }
+    }
 
-        fprintf(logger -> file, "%s\n", message);
-        fflush(logger -> file);
+    if (result != OK || pthread_setspecific(logger -> key, queue) != 0) {
+        Buffer_destroy(queue -> buffer);
+        free(queue);
+        return ERR_ALLOC;
     }
 
-    while (!Buffer_isEmpty(logger -> buffer)) {
-        if (Buffer_pop(logger -> buffer, message) != OK) {
-            break;
+    local = queue;
+    local_epoch = epoch;
+    local_thread = queue -> thread;
+
+    return OK;
+}
+
+/*
+    METHOD: Logger_orphan
+    ARGUMENTS: 
+        queue - a queue of a thread which is ending
+    PURPOSE: marking a queue nobody will push to again
+    RETURN: nothing
+*/
+static void Logger_orphan(
+    void* const queue
+) {
+    atomic_store(&(((LogQueue*) queue) -> orphaned), true);
+}
+
+/*
+    METHOD: Logger_drain
+    ARGUMENTS: none
+    PURPOSE: formatting and writing of every queued record, 
+        queues of ended threads are freed once empty, logger mutex 
+        keeps drains apart but is never taken by a registering thread
+    RETURN: nothing
+*/
+static void Logger_drain(
+    void
+) {
+    LogQueue* queue;
+    size_t popped;
+
+    pthread_mutex_lock(&(logger -> mutex));
+
+    for (int i = 0; i < THREADS; i++) {
+        queue = atomic_load(&(logger -> queues[i]));
+
+        if (queue == NULL) { continue; }
+
+        while (!Buffer_isEmpty(queue -> buffer)) {
+            if (Buffer_popN(queue -> buffer, logger -> records, BATCH, &popped) != OK) { break; }
+
+            for (size_t j = 0; j < popped; j++) { Logger_append(&(logger -> records[j])); }
         }
 
-        fprintf(logger -> file, "%s\n", message);
-        fflush(logger -> file);
+        Logger_report(queue);
+
+        // ORPHANED IS SET AFTER LAST PUSH, SO ANYTHING PUSHED BEFORE IT IS ALREADY DRAINED
+        if (atomic_load(&(queue -> orphaned)) && Buffer_isEmpty(queue -> buffer)) {
+            atomic_store(&(logger -> queues[i]), NULL);
+            logger -> dropped += queue -> reported;
+            Buffer_destroy(queue -> buffer);
+            free(queue);
+        }
     }
-    
-    free(message);
 
-    pthread_exit(NULL);
+    pthread_mutex_unlock(&(logger -> mutex));
+}
+
+/*
+    METHOD: Logger_report
+    ARGUMENTS: 
+        queue - a queue which drops are checked
+    PURPOSE: logging of records a given queue dropped since 
+        its last report, as a line of logger itself
+    RETURN: nothing
+*/
+static void Logger_report(
+    LogQueue* const queue
+) {
+    struct timespec now;
+    BufferStats stats;
+    LogRecord record;
+
+    if (Buffer_stats(queue -> buffer, &stats) != OK || stats.drops == queue -> reported) { return; }
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    record = (LogRecord) {
+        .timestamp = (uint64_t) now.tv_sec * NANOSECONDS + (uint64_t) now.tv_nsec,
+        .name = "LOGGER",
+        .message = LOG_MESSAGE("%zu RECORDS OF THREAD %d DROPPED", stats.drops - queue -> reported, queue -> thread),
+        .thread = queue -> thread,
+        .level = LOG_LEVEL_WARN
+    };
+
+    Logger_append(&record);
+
+    queue -> reported = stats.drops;
 }
 
 /*
-    METHOD: Logger_log
+    METHOD: Logger_append
     ARGUMENTS: 
-        name - name of a module which invoked this function
-        info - content of a message sent to logger
-    PURPOSE: appearance of a single log in log.txt
+        record - a record to be formatted
+    PURPOSE: formatting of a record and its copy at the end of 
+        a mapped segment, without any syscall unless segment 
+        is full and has to be rotated, a line nowhere to be written is lost
+    RETURN: nothing
+*/
+static void Logger_append(
+    LogRecord const* const record
+) {
+    char line[MESSAGE_SIZE];
+    size_t length;
+
+    length = Logger_format(record, line, sizeof(line));
+
+    if (logger -> segment == NULL && Logger_open() != OK) { return; }
+    if (logger -> length + length > segment_size && Logger_rotate() != OK) { return; }
+
+    memcpy(logger -> segment + logger -> length, line, length);
+    logger -> length += length;
+}
+
+/*
+    METHOD: Logger_open
+    ARGUMENTS: none
+    PURPOSE: opening of active segment, preallocated to its full size 
+        and mapped, so a full disk fails here and not on a later copy,
+        lines already in it are kept and a line cut short by a crash, 
+        which is followed by zeros of preallocation, is erased,
+        a file larger than a segment is rotated away untouched
     RETURN: int from enums, explaining result
 */
-int Logger_log(
-    char* const name, 
-    char* const info
+static int Logger_open(
+    void
 ) {
-    char message[256];
+    struct stat info;
+    char* segment;
+    char* end;
+    char* last;
+    int file;
+
+    file = open(PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (file < 0) { return ERR_FILE_OPEN; }
+
+    if (fstat(file, &info) != 0) {
+        close(file);
+        return ERR_FILE_OPEN;
+    }
 
-    if (name == NULL || info == NULL) { return ERR_PARAMS; }
+    // LEFT BY A LOGGER WITH LARGER SEGMENTS OR NONE AT ALL, SO IT IS NOT A SEGMENT TO CONTINUE
+    if ((size_t) info.st_size > segment_size) {
+        close(file);
+        Logger_shift();
 
-    snprintf(message, sizeof(message), "[%s]: %s", name, info);
+        file = open(PATH, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
 
-    if (Buffer_push(logger -> buffer, message) != OK) {
-        return ERR_PUSH;
+        if (file < 0) { return ERR_FILE_OPEN; }
+
+        info.st_size = 0;
+    }
+
+    if (posix_fallocate(file, 0, (off_t) segment_size) != 0) {
+        close(file);
+        return ERR_FILE_OPEN;
+    }
+
+    segment = (char*) mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+    if (segment == MAP_FAILED) {
+        close(file);
+        return ERR_FILE_OPEN;
     }
 
+    // LINES NEVER HOLD ZEROS, SO FIRST ZERO ENDS WRITTEN PART AND LAST NEWLINE BEFORE IT ITS LAST WHOLE LINE
+    end = (char*) memchr(segment, '\0', (size_t) info.st_size);
+    if (end == NULL) { end = segment + info.st_size; }
+
+    last = (char*) memrchr(segment, '\n', (size_t) (end - segment));
+    logger -> length = last == NULL ? 0 : (size_t) (last - segment) + 1;
+
+    memset(segment + logger -> length, 0, (size_t) (end - segment) - logger -> length);
+
+    logger -> segment = segment;
+    logger -> file = file;
+
+    return OK;
+}
+
+/*
+    METHOD: Logger_seal
+    ARGUMENTS: none
+    PURPOSE: unmapping and closing of active segment,
+        cut to its lines so its preallocated tail is freed
+    RETURN: nothing
+*/
+static void Logger_seal(
+    void
+) {
+    if (logger -> segment == NULL) { return; }
+
+    munmap(logger -> segment, segment_size);
+    ftruncate(logger -> file, (off_t) logger -> length);
+    close(logger -> file);
+
+    logger -> segment = NULL;
+    logger -> length = 0;
+    logger -> file = -1;
+}
+
+/*
+    METHOD: Logger_rotate
+    ARGUMENTS: none
+    PURPOSE: sealing of a full active segment, shift of kept 
+        segments by one and opening of a new empty active segment, 
+        done by logger alone so callers never wait on it
+    RETURN: int from enums, explaining result
+*/
+static int Logger_rotate(
+    void
+) {
+    Logger_seal();
+    Logger_shift();
+
+    return Logger_open();
+}
+
+/*
+    METHOD: Logger_shift
+    ARGUMENTS: none
+    PURPOSE: renaming of every kept segment to the next older name, 
+        the oldest one replaced, so active name is free
+    RETURN: nothing
+*/
+static void Logger_shift(
+    void
+) {
+    char older[PATH_SIZE];
+    char newer[PATH_SIZE];
+
+    for (int i = segments - 1; i > 0; i--) {
+        snprintf(older, sizeof(older), "%s.%d", PATH, i);
+
+        if (i > 1) { snprintf(newer, sizeof(newer), "%s.%d", PATH, i - 1); }
+        else { snprintf(newer, sizeof(newer), "%s", PATH); }
+
+        rename(newer, older);
+    }
+
+    // WITH A SINGLE SEGMENT NOTHING IS KEPT, ACTIVE ONE STARTS OVER
+    if (segments == 1) { unlink(PATH); }
+}
+
+/*
+    METHOD: Logger_format
+    ARGUMENTS: 
+        record - a record to be formatted
+        line - where a formatted line is saved
+        size - size of a given line, at least 3
+    PURPOSE: formatting of a record into a single null terminated line 
+        ending with a newline, cut short when too long, length modifiers of its 
+        format are ignored as every argument is kept as 64 bits
+    RETURN: length of a formatted line
+*/
+size_t Logger_format(
+    LogRecord const* const record,
+    char* const line,
+    size_t const size
+) {
+    char const* cursor;
+    size_t length;
+    size_t arg;
+    int written;
+
+    written = snprintf(
+        line, size, "%" PRIu64 ".%09" PRIu64 " %d %s [%s]: ", 
+        record -> timestamp / NANOSECONDS, record -> timestamp % NANOSECONDS, record -> thread,
+        record -> level <= LOG_LEVEL_OFF ? LEVEL_NAMES[record -> level] : "?", record -> name
+    );
+
+    length = written < 0 ? 0 : (size_t) written;
+    if (length > size - 2) { length = size - 2; }
+
+    cursor = record -> message.format;
+    arg = 0;
+
+    while (*cursor != '\0' && length < size - 2) {
+        if (*cursor != '%' || cursor[1] == '%') {
+            line[length++] = *cursor;
+            cursor += *cursor == '%' ? 2 : 1;
+            continue;
+        }
+
+        length += Logger_conversion(
+            cursor, arg < LOG_ARGS ? record -> message.args[arg] : 0, 
+            line + length, size - 2 - length
+        );
+
+        arg++;
+        cursor++;
+
+        while (*cursor != '\0' && strchr("-+ #0123456789.hlLqjzt", *cursor) != NULL) { cursor++; }
+        if (*cursor != '\0') { cursor++; }
+    }
+
+    line[length++] = '\n';
+    line[length] = '\0';
+
+    return length;
+}
+
+/*
+    METHOD: Logger_conversion
+    ARGUMENTS: 
+        spec - a single conversion of a format, starting with %
+        value - its argument
+        output - where a converted argument is saved
+        size - room left in a given output, not counting a null terminator
+    PURPOSE: conversion of a single argument with flags, width 
+        and precision of a given spec, integers are widened to long long
+    RETURN: length of a converted argument, cut to a given room
+*/
+static size_t Logger_conversion(
+    char const* const spec,
+    uint64_t const value,
+    char* const output,
+    size_t const size
+) {
+    char format[24];
+    size_t length;
+    size_t i;
+    int written;
+
+    length = 0;
+    format[length++] = '%';
+
+    for (i = 1; spec[i] != '\0' && strchr("-+ #0123456789.", spec[i]) != NULL && length < 16; i++) {
+        format[length++] = spec[i];
+    }
+
+    while (spec[i] != '\0' && strchr("hlLqjzt", spec[i]) != NULL) { i++; }
+
+    switch (spec[i]) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+            format[length++] = 'l';
+            format[length++] = 'l';
+            format[length++] = spec[i];
+            format[length] = '\0';
+            written = spec[i] == 'd' || spec[i] == 'i' 
+                ? snprintf(output, size + 1, format, (long long) value)
+                : snprintf(output, size + 1, format, (unsigned long long) value);
+            break;
+        case 'c':
+            format[length++] = 'c';
+            format[length] = '\0';
+            written = snprintf(output, size + 1, format, (int) value);
+            break;
+        case 's':
+            format[length++] = 's';
+            format[length] = '\0';
+            written = snprintf(output, size + 1, format, value == 0 ? "(null)" : (char const*) (uintptr_t) value);
+            break;
+        case 'p':
+            format[length++] = 'p';
+            format[length] = '\0';
+            written = snprintf(output, size + 1, format, (void*) (uintptr_t) value);
+            break;
+        default:
+            written = snprintf(output, size + 1, "?");
+            break;
+    }
+
+    if (written < 0) { return 0; }
+
+    return (size_t) written < size ? (size_t) written : size;
+}
+
+/*
+    METHOD: Logger_setRotation
+    ARGUMENTS:
+        size - size of a single segment in bytes, at least a message long
+        count - number of segments kept, active one included
+    PURPOSE: change of rotation of a logger created later on, 
+        whole log never takes more than size times count bytes
+    RETURN: int from enums, explaining result
+*/
+int Logger_setRotation(
+    size_t const size,
+    int const count
+) {
+    if (initialized) { return ERR_INIT; }
+    if (size < MESSAGE_SIZE || count < 1 || count > 99) { return ERR_PARAMS; }
+
+    segment_size = size;
+    segments = count;
+
+    return OK;
+}
+
+/*
+    METHOD: Logger_setLevel
+    ARGUMENTS:
+        level - lowest LOG_LEVEL_* value to be logged, 
+            levels not compiled in stay silent anyway
+    PURPOSE: change of logged levels, safe at any time from any thread
+    RETURN: int from enums, explaining result
+*/
+int Logger_setLevel(
+    int const level
+) {
+    if (level < LOG_LEVEL_TRACE || level > LOG_LEVEL_OFF) { return ERR_PARAMS; }
+
+    atomic_store_explicit(&logger_level, level, memory_order_relaxed);
+
+    return OK;
+}
+
+/*
+    METHOD: Logger_dropped
+    ARGUMENTS: none
+    PURPOSE: count of records dropped by every queue so far,
+        queues of threads still logging may drop more meanwhile
+    RETURN: number of dropped records
+*/
+uint64_t Logger_dropped(
+    void
+) {
+    BufferStats stats;
+    LogQueue* queue;
+    uint64_t dropped;
+
+    if (!initialized) { return 0; }
+
+    pthread_mutex_lock(&(logger -> mutex));
+
+    dropped = logger -> dropped;
+
+    for (int i = 0; i < THREADS; i++) {
+        queue = atomic_load(&(logger -> queues[i]));
+
+        if (queue == NULL) { continue; }
+        if (Buffer_stats(queue -> buffer, &stats) == OK) { dropped += stats.drops; }
+    }
+
+    pthread_mutex_unlock(&(logger -> mutex));
+
+    return dropped;
+}
+
+/*
+    METHOD: Logger_flush
+    ARGUMENTS: none
+    PURPOSE: writing of every waiting record by a caller, for a logger 
+        which was not started, so an event loop can defer logging 
+        to the idle part of its tick
+    RETURN: int from enums, explaining result
+*/
+int Logger_flush(
+    void
+) {
+    if (!initialized) { return ERR_INIT; }
+    if (started) { return ERR_RUN; }
+
+    Logger_drain();
+
     return OK;
 }
 
 /*
     METHOD: Logger_terminate
     ARGUMENTS: none
-    PURPOSE: sets status variable to TERMINATED
+    PURPOSE: sets status variable to TERMINATED and wakes logger 
+        thread, so it drains every queue and finishes
     RETURN: nothing
 */
 void Logger_terminate(
     void
 ) {
-    logger -> status = TERMINATED;
+    Status_set(&(logger -> status), TERMINATED);
 }
 
 /*
     METHOD: Logger_destroy
     ARGUMENTS: none
-    PURPOSE: free of memory taken by Logger object
+    PURPOSE: free of memory taken by Logger object, records 
+        still queued by other threads are dropped
     RETURN: nothing
 */
 void Logger_destroy(
     void
 ) {
-    fclose(logger -> file);
+    LogQueue* queue;
+
+    initialized = false;
+
+    for (int i = 0; i < THREADS; i++) {
+        queue = atomic_load(&(logger -> queues[i]));
+
+        if (queue == NULL) { continue; }
+
+        Buffer_destroy(queue -> buffer);
+        free(queue);
+    }
+
+    pthread_setspecific(logger -> key, NULL);
+    pthread_key_delete(logger -> key);
 
-    Buffer_destroy(logger -> buffer);
+    Logger_seal();
 
+    free(logger -> records);
     free(logger);
 }
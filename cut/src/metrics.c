@@ -0,0 +1,1082 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics.c                       
+    PURPOSE: implementation of metrics module, an HTTP/1.1 server of
+        /metrics in Prometheus text format, non-blocking on a single
+        thread, rendering scrapes from the last record analyzer published
+        through a sequence lock, so no scrape ever holds analyzer back
+*/
+
+// FEATURE MACRO NEEDED BY ACCEPT4
+#define _GNU_SOURCE
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/metrics.h"
+#include "../inc/logger.h"
+#include "../inc/enums.h"
+#include "../inc/stats.h"
+#include "../inc/format.h"
+
+// MACRO DEFINITION
+#define CONNECTIONS 8
+#define BACKLOG 16
+#define REQUEST_SIZE 2048
+#define NAME_SIZE 32
+#define HEAD_SIZE 256
+#define FIXED_SIZE (16u << 10)
+#define LINE_SIZE 80
+#define RESPONSE_SIZE(proc) (HEAD_SIZE + FIXED_SIZE + (size_t) LINE_SIZE * (COLUMNS + 1) * ((size_t) (proc) + 1))
+#define NANOSECONDS 1000000000.0
+#define LISTENER UINT64_MAX
+#define WAKE (UINT64_MAX - 1)
+
+// HELP AND TYPE LINES OF A METRIC FAMILY
+#define METRICS_HEAD(name, help, type) "# HELP " name " " help "\n# TYPE " name " " type "\n"
+
+// FAMILY OF BUFFER COUNTERS, READ FROM A GIVEN FIELD OF BUFFERSTATS
+#define BUFFER_FAMILY(name, help, type, field) \
+    { name, METRICS_HEAD(name, help, type), offsetof(BufferStats, field) }
+
+// RESPONSES WHICH ARE NEVER RENDERED, TO REQUESTS OTHER THAN GET OR HEAD OF /METRICS
+#define BAD_REQUEST \
+    "HTTP/1.1 400 Bad Request\r\nContent-Type: text/plain\r\nContent-Length: 12\r\n" \
+    "Connection: close\r\n\r\nbad request\n"
+#define NOT_FOUND \
+    "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\nContent-Length: 10\r\n" \
+    "Connection: close\r\n\r\nnot found\n"
+#define METHOD_NOT_ALLOWED \
+    "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET, HEAD\r\nContent-Type: text/plain\r\n" \
+    "Content-Length: 19\r\nConnection: close\r\n\r\nmethod not allowed\n"
+
+// STRUCTURE FOR HOLDING A FAMILY OF BUFFER COUNTERS
+typedef struct MetricsFamily {
+    char const* name;
+    char const* head;
+    size_t offset;
+} MetricsFamily;
+
+// STRUCTURE FOR HOLDING A CONNECTION, IT IS READ UNTIL ITS REQUEST HAS ENDED
+// AND HAS NO OUTPUT UNTIL THEN, A SCRAPE IS RENDERED INTO ITS OWN RESPONSE,
+// SO A CLIENT WHICH NEVER READS KEEPS NO OTHER SCRAPE STALE
+typedef struct MetricsConnection {
+    char const* output;
+    char* response;
+    size_t length;
+    size_t sent;
+    size_t received;
+    uint64_t serial;
+    int fd;
+    bool waiting;
+    char padding[3];
+    char request[REQUEST_SIZE + 1];
+    char padding_end[7];
+} MetricsConnection;
+
+// STRUCTURE FOR HOLDING METRICS OBJECT, SNAPSHOT IS WRITTEN BY ANALYZER ONLY,
+// COPY, RESPONSE AND CONNECTIONS BY A THREAD SERVING SCRAPES ONLY
+struct metrics {
+    ConvertedStats* snapshot;
+    ConvertedStats* copy;
+    char* responses;
+    Buffer* buffers[METRICS_BUFFERS];
+    char buffer_names[METRICS_BUFFERS][NAME_SIZE];
+    Supervisor* supervisor;
+    char stage_names[SUPERVISOR_STAGES][NAME_SIZE];
+    Scheduler* scheduler;
+    MetricsConnection connections[CONNECTIONS];
+    pthread_t thread;
+    uint64_t serial;
+    uint64_t scrapes;
+    atomic_uint_fast64_t sequence;
+    atomic_bool running;
+    bool thread_started;
+    uint16_t proc;
+    uint16_t port;
+    char padding[2];
+    int listener;
+    int epoll;
+    int wake;
+    int buffer_count;
+    int stage_count;
+    char padding_end[4];
+};
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* Metrics_threadf(void* const);
+static void Metrics_accept(Metrics* const);
+static void Metrics_receive(Metrics* const, MetricsConnection* const);
+static void Metrics_respond(Metrics* const, MetricsConnection* const);
+static void Metrics_send(Metrics* const, MetricsConnection* const);
+static void Metrics_close(MetricsConnection* const);
+static void Metrics_render(Metrics* const, MetricsConnection* const, bool const);
+static bool Metrics_read(Metrics* const, uint64_t* const);
+static size_t Metrics_cpus(ConvertedStats const* const, char* const);
+static size_t Metrics_health(Metrics* const, char* const);
+static size_t Metrics_line(char* const, char const* const, char const* const, char const* const);
+static size_t Metrics_string(char* const, char const* const);
+
+// NAMES OF COUNTER COLUMNS USED AS MODE LABELS, IN /PROC/STAT ORDER
+static char const* const MODE_NAMES[COLUMNS] = {
+    "user", "nice", "system", "idle", "iowait", "irq", "softirq", "steal", "guest", "guest_nice"
+};
+
+// FAMILIES OF BUFFER COUNTERS, EVERY WATCHED BUFFER IS A SAMPLE OF EACH
+static MetricsFamily const BUFFER_FAMILIES[] = {
+    BUFFER_FAMILY("cut_buffer_occupancy", "Records waiting in a buffer.", "gauge", count),
+    BUFFER_FAMILY("cut_buffer_capacity", "Records a buffer holds at most.", "gauge", capacity),
+    BUFFER_FAMILY("cut_buffer_high_water", "Most records a buffer held at once.", "gauge", high_water),
+    BUFFER_FAMILY("cut_buffer_drops_total", "Records a buffer refused as it was full or closed.", "counter", drops),
+    BUFFER_FAMILY("cut_buffer_overwrites_total", "Oldest records a full buffer overwrote.", "counter", overwrites)
+};
+
+/*
+    METHOD: Metrics_init
+    ARGUMENTS:
+        address - a local IPv4 address to listen on, like 127.0.0.1
+        port - a port to listen on, 0 for any free one
+        proc - most cores a single published record has
+    PURPOSE: creation of Metrics object listening on a given address,
+        with a snapshot and a response of every connection for a record 
+        of proc cores allocated up front, so neither publishing nor a scrape allocates
+    RETURN: Metrics object or NULL in
+        case creation was not possible
+*/
+Metrics* Metrics_init(
+    char const* const address,
+    uint16_t const port,
+    uint16_t const proc
+) {
+    struct sockaddr_in local;
+    struct epoll_event events[2];
+    socklen_t length;
+    Metrics* metrics;
+    int const reuse = 1;
+
+    LOG_DEBUG("METRICS", "INIT STARTED");
+
+    if (address == NULL || proc == 0) { return NULL; }
+
+    local = (struct sockaddr_in) { .sin_family = AF_INET, .sin_port = htons(port) };
+
+    if (inet_pton(AF_INET, address, &(local.sin_addr)) != 1) { return NULL; }
+
+    metrics = (Metrics*) malloc(sizeof(Metrics));
+    if (metrics == NULL) { goto err_metrics_alloc; }
+
+    *metrics = (Metrics) {
+        .snapshot = (ConvertedStats*) malloc(CONVERTED_SIZE(proc)),
+        .copy = (ConvertedStats*) malloc(CONVERTED_SIZE(proc)),
+        .responses = (char*) malloc(CONNECTIONS * RESPONSE_SIZE(proc)),
+        .sequence = ATOMIC_VAR_INIT(0),
+        .running = ATOMIC_VAR_INIT(false),
+        .thread_started = false,
+        .proc = proc,
+        .listener = -1,
+        .epoll = -1,
+        .wake = -1
+    };
+
+    if (metrics -> snapshot == NULL || metrics -> copy == NULL || metrics -> responses == NULL) { goto err_buffers_alloc; }
+
+    for (int i = 0; i < CONNECTIONS; i++) { 
+        metrics -> connections[i].fd = -1; 
+        metrics -> connections[i].response = metrics -> responses + (size_t) i * RESPONSE_SIZE(proc);
+    }
+
+    metrics -> listener = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (metrics -> listener < 0) { goto err_buffers_alloc; }
+
+    length = sizeof(local);
+
+    if (
+        setsockopt(metrics -> listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(metrics -> listener, (struct sockaddr*) &local, sizeof(local)) != 0 ||
+        listen(metrics -> listener, BACKLOG) != 0 ||
+        getsockname(metrics -> listener, (struct sockaddr*) &local, &length) != 0
+    ) {
+        LOG_ERROR("METRICS", "COULD NOT LISTEN ON %s:%u", address, (unsigned) port);
+        goto err_socket_bind;
+    }
+
+    metrics -> port = ntohs(local.sin_port);
+
+    metrics -> epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (metrics -> epoll < 0) { goto err_socket_bind; }
+
+    // SERVING THREAD IS WOKEN THROUGH IT ON JOIN
+    metrics -> wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (metrics -> wake < 0) { goto err_epoll_init; }
+
+    events[0] = (struct epoll_event) { .events = EPOLLIN, .data.u64 = LISTENER };
+    events[1] = (struct epoll_event) { .events = EPOLLIN, .data.u64 = WAKE };
+
+    if (
+        epoll_ctl(metrics -> epoll, EPOLL_CTL_ADD, metrics -> listener, &events[0]) != 0 ||
+        epoll_ctl(metrics -> epoll, EPOLL_CTL_ADD, metrics -> wake, &events[1]) != 0
+    ) { goto err_epoll_ctl; }
+
+    LOG_INFO("METRICS", "LISTENING ON %s:%u", address, (unsigned) metrics -> port);
+
+    return metrics;
+
+    err_epoll_ctl:
+        close(metrics -> wake);
+    err_epoll_init:
+        close(metrics -> epoll);
+    err_socket_bind:
+        close(metrics -> listener);
+    err_buffers_alloc:
+        free(metrics -> snapshot);
+        free(metrics -> copy);
+        free(metrics -> responses);
+        free(metrics);
+    err_metrics_alloc:
+        LOG_ERROR("METRICS", "INIT ERROR");
+
+    return NULL;
+}
+
+/*
+    METHOD: Metrics_watchBuffer
+    ARGUMENTS:
+        metrics - a Metrics object which is not served yet
+        name - a label of a buffer, cut to NAME_SIZE - 1 bytes
+        buffer - a buffer which counters are served, up to METRICS_BUFFERS of them
+    PURPOSE: addition of a buffer which occupancy and losses every scrape reads
+    RETURN: enums integer value
+*/
+int Metrics_watchBuffer(
+    Metrics* const metrics,
+    char const* const name,
+    Buffer* const buffer
+) {
+    if (
+        metrics == NULL ||
+        name == NULL ||
+        buffer == NULL ||
+        metrics -> buffer_count == METRICS_BUFFERS
+    ) { return ERR_PARAMS; }
+
+    if (metrics -> thread_started) { return ERR_RUN; }
+
+    snprintf(metrics -> buffer_names[metrics -> buffer_count], NAME_SIZE, "%s", name);
+    metrics -> buffers[metrics -> buffer_count++] = buffer;
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_watchSupervisor
+    ARGUMENTS:
+        metrics - a Metrics object which is not served yet
+        supervisor - a supervisor which stage counters are served
+        names - names of its stages in order they are watched,
+            labels are their lowercase copies
+        count - number of its stages
+    PURPOSE: addition of stalls and restarts of every supervised stage
+    RETURN: enums integer value
+*/
+int Metrics_watchSupervisor(
+    Metrics* const metrics,
+    Supervisor* const supervisor,
+    char* const* const names,
+    int const count
+) {
+    char* label;
+
+    if (
+        metrics == NULL ||
+        supervisor == NULL ||
+        names == NULL ||
+        count <= 0 ||
+        count > SUPERVISOR_STAGES
+    ) { return ERR_PARAMS; }
+
+    if (metrics -> thread_started) { return ERR_RUN; }
+
+    for (int stage = 0; stage < count; stage++) {
+        label = metrics -> stage_names[stage];
+
+        snprintf(label, NAME_SIZE, "%s", names[stage]);
+
+        for (size_t i = 0; label[i] != '\0'; i++) { label[i] = (char) tolower((unsigned char) label[i]); }
+    }
+
+    metrics -> supervisor = supervisor;
+    metrics -> stage_count = count;
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_watchScheduler
+    ARGUMENTS:
+        metrics - a Metrics object which is not served yet
+        scheduler - a scheduler which missed ticks are served
+    PURPOSE: addition of sampling ticks which could not be kept
+    RETURN: enums integer value
+*/
+int Metrics_watchScheduler(
+    Metrics* const metrics,
+    Scheduler* const scheduler
+) {
+    if (metrics == NULL || scheduler == NULL) { return ERR_PARAMS; }
+    if (metrics -> thread_started) { return ERR_RUN; }
+
+    metrics -> scheduler = scheduler;
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_publish
+    ARGUMENTS:
+        metrics - a Metrics object to work on, NULL when nothing is served
+        stats - the last analyzed record
+    PURPOSE: copy of a record into a snapshot scrapes are rendered from,
+        sequence is odd while it is written, so a scrape copying it
+        at the same time sees a change and copies it again, a publisher
+        never waits, only one may publish at a time
+    RETURN: nothing
+*/
+void Metrics_publish(
+    Metrics* const metrics,
+    ConvertedStats const* const stats
+) {
+    uint_fast64_t sequence;
+
+    if (metrics == NULL || stats == NULL || stats -> count > metrics -> proc) { return; }
+
+    sequence = atomic_load_explicit(&(metrics -> sequence), memory_order_relaxed);
+
+    atomic_store_explicit(&(metrics -> sequence), sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(metrics -> snapshot, stats, CONVERTED_SIZE(stats -> count));
+
+    atomic_store_explicit(&(metrics -> sequence), sequence + 2, memory_order_release);
+}
+
+/*
+    METHOD: Metrics_read
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        samples - where a number of records published so far is saved
+    PURPOSE: copy of a snapshot, repeated until no record was published
+        during it, records come once a tick, so it is repeated rarely
+    RETURN: true when a record was published, false otherwise
+*/
+static bool Metrics_read(
+    Metrics* const metrics,
+    uint64_t* const samples
+) {
+    uint_fast64_t sequence;
+
+    for (;;) {
+        sequence = atomic_load_explicit(&(metrics -> sequence), memory_order_acquire);
+
+        if (sequence == 0) {
+            *samples = 0;
+            return false;
+        }
+
+        if (sequence % 2 == 1) {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(metrics -> copy, metrics -> snapshot, CONVERTED_SIZE(metrics -> proc));
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&(metrics -> sequence), memory_order_relaxed) == sequence) { break; }
+    }
+
+    *samples = (uint64_t) sequence / 2;
+
+    return true;
+}
+
+/*
+    METHOD: Metrics_fd
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+    PURPOSE: access to an epoll descriptor which is readable whenever
+        Metrics_serve has work, so an event loop can serve scrapes inline
+    RETURN: a descriptor or -1 in case of wrong parameters
+*/
+int Metrics_fd(
+    Metrics* const metrics
+) {
+    if (metrics == NULL) { return -1; }
+
+    return metrics -> epoll;
+}
+
+/*
+    METHOD: Metrics_port
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+    PURPOSE: access to a port listened on, chosen by the system when 0 was given
+    RETURN: a port or 0 in case of wrong parameters
+*/
+uint16_t Metrics_port(
+    Metrics* const metrics
+) {
+    if (metrics == NULL) { return 0; }
+
+    return metrics -> port;
+}
+
+/*
+    METHOD: Metrics_serve
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        timeout - milliseconds to wait for work, 0 for none, -1 until there is some
+    PURPOSE: accepting of connections, reading of their requests and
+        sending of responses, as far as it goes without blocking
+    RETURN: enums integer value
+*/
+int Metrics_serve(
+    Metrics* const metrics,
+    int const timeout
+) {
+    struct epoll_event events[CONNECTIONS + 2];
+    MetricsConnection* connection;
+    uint64_t wakes;
+    int ready;
+
+    if (metrics == NULL) { return ERR_PARAMS; }
+
+    ready = epoll_wait(metrics -> epoll, events, CONNECTIONS + 2, timeout);
+
+    if (ready < 0) { return errno == EINTR ? OK : ERR_RUN; }
+
+    for (int i = 0; i < ready; i++) {
+        if (events[i].data.u64 == LISTENER) {
+            Metrics_accept(metrics);
+            continue;
+        }
+
+        if (events[i].data.u64 == WAKE) {
+            while (read(metrics -> wake, &wakes, sizeof(wakes)) == sizeof(wakes)) {}
+            continue;
+        }
+
+        // AN EVENT OF A CONNECTION EVICTED EARLIER IN THIS BATCH FINDS ITS SLOT EMPTY OR REUSED,
+        // EITHER WAY READING OR SENDING JUST STOPS AT EAGAIN
+        connection = &(metrics -> connections[events[i].data.u64]);
+
+        if (connection -> fd < 0) { continue; }
+
+        if (connection -> output == NULL) {
+            Metrics_receive(metrics, connection);
+        } else {
+            Metrics_send(metrics, connection);
+        }
+    }
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_accept
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+    PURPOSE: accepting of every pending connection, a free slot is
+        taken or the oldest connection gives its one up, so clients
+        which never send a request cannot lock scrapes out
+    RETURN: nothing
+*/
+static void Metrics_accept(
+    Metrics* const metrics
+) {
+    MetricsConnection* connection;
+    MetricsConnection* candidate;
+    struct epoll_event event;
+    int fd;
+
+    while ((fd = accept4(metrics -> listener, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+        connection = NULL;
+
+        for (int i = 0; i < CONNECTIONS; i++) {
+            candidate = &(metrics -> connections[i]);
+
+            if (candidate -> fd < 0) {
+                connection = candidate;
+                break;
+            }
+
+            if (connection == NULL || candidate -> serial < connection -> serial) { connection = candidate; }
+        }
+
+        if (connection -> fd >= 0) {
+            LOG_WARN("METRICS", "ALL CONNECTIONS BUSY, OLDEST CLOSED");
+            Metrics_close(connection);
+        }
+
+        connection -> output = NULL;
+        connection -> length = 0;
+        connection -> sent = 0;
+        connection -> received = 0;
+        connection -> serial = metrics -> serial++;
+        connection -> fd = fd;
+        connection -> waiting = false;
+
+        event = (struct epoll_event) {
+            .events = EPOLLIN,
+            .data.u64 = (uint64_t) (connection - metrics -> connections)
+        };
+
+        if (epoll_ctl(metrics -> epoll, EPOLL_CTL_ADD, fd, &event) != 0) { Metrics_close(connection); }
+    }
+}
+
+/*
+    METHOD: Metrics_receive
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        connection - a connection whose request has not ended yet
+    PURPOSE: reading of a request until an empty line ends its headers,
+        answered at once then, a request too long for REQUEST_SIZE is refused
+    RETURN: nothing
+*/
+static void Metrics_receive(
+    Metrics* const metrics,
+    MetricsConnection* const connection
+) {
+    ssize_t received;
+
+    received = recv(
+        connection -> fd,
+        connection -> request + connection -> received,
+        REQUEST_SIZE - connection -> received,
+        0
+    );
+
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) { return; }
+
+    if (received <= 0) {
+        Metrics_close(connection);
+        return;
+    }
+
+    connection -> received += (size_t) received;
+    connection -> request[connection -> received] = '\0';
+
+    if (strstr(connection -> request, "\r\n\r\n") != NULL || strstr(connection -> request, "\n\n") != NULL) {
+        Metrics_respond(metrics, connection);
+    } else if (connection -> received == REQUEST_SIZE) {
+        connection -> output = BAD_REQUEST;
+        connection -> length = sizeof(BAD_REQUEST) - 1;
+    } else {
+        return;
+    }
+
+    Metrics_send(metrics, connection);
+}
+
+/*
+    METHOD: Metrics_respond
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        connection - a connection whose request has ended
+    PURPOSE: choice of a response by a request line, only GET and HEAD
+        of /metrics, with any query, get one freshly rendered
+    RETURN: nothing
+*/
+static void Metrics_respond(
+    Metrics* const metrics,
+    MetricsConnection* const connection
+) {
+    char const* request;
+    char const* target;
+    size_t method;
+    size_t path;
+    bool head;
+
+    request = connection -> request;
+    method = strcspn(request, " \r\n");
+    target = request + method + 1;
+    path = strcspn(target, " ?\r\n");
+
+    head = method == 4 && strncmp(request, "HEAD", 4) == 0;
+
+    if (request[method] != ' ' || method == 0 || target[strcspn(target, " \r\n")] != ' ') {
+        connection -> output = BAD_REQUEST;
+        connection -> length = sizeof(BAD_REQUEST) - 1;
+    } else if (!head && !(method == 3 && strncmp(request, "GET", 3) == 0)) {
+        connection -> output = METHOD_NOT_ALLOWED;
+        connection -> length = sizeof(METHOD_NOT_ALLOWED) - 1;
+    } else if (path != sizeof("/metrics") - 1 || strncmp(target, "/metrics", path) != 0) {
+        connection -> output = NOT_FOUND;
+        connection -> length = sizeof(NOT_FOUND) - 1;
+    } else {
+        metrics -> scrapes++;
+
+        Metrics_render(metrics, connection, head);
+    }
+}
+
+/*
+    METHOD: Metrics_send
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        connection - a connection with a response
+    PURPOSE: sending of a response as far as a socket takes it,
+        the rest waits for it to be writable, a connection is closed
+        once all of it was sent or the client went away
+    RETURN: nothing
+*/
+static void Metrics_send(
+    Metrics* const metrics,
+    MetricsConnection* const connection
+) {
+    struct epoll_event event;
+    ssize_t sent;
+
+    while (connection -> sent < connection -> length) {
+        sent = send(
+            connection -> fd,
+            connection -> output + connection -> sent,
+            connection -> length - connection -> sent,
+            MSG_NOSIGNAL
+        );
+
+        if (sent < 0 && errno == EINTR) { continue; }
+
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!connection -> waiting) {
+                event = (struct epoll_event) {
+                    .events = EPOLLOUT,
+                    .data.u64 = (uint64_t) (connection - metrics -> connections)
+                };
+
+                if (epoll_ctl(metrics -> epoll, EPOLL_CTL_MOD, connection -> fd, &event) != 0) { break; }
+
+                connection -> waiting = true;
+            }
+
+            return;
+        }
+
+        if (sent <= 0) { break; }
+
+        connection -> sent += (size_t) sent;
+    }
+
+    Metrics_close(connection);
+}
+
+/*
+    METHOD: Metrics_close
+    ARGUMENTS:
+        connection - an open connection
+    PURPOSE: close of a connection, which frees its slot
+    RETURN: nothing
+*/
+static void Metrics_close(
+    MetricsConnection* const connection
+) {
+    close(connection -> fd);
+
+    connection -> fd = -1;
+    connection -> output = NULL;
+}
+
+/*
+    METHOD: Metrics_render
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        connection - a connection whose response is rendered
+        bodiless - true when only headers are sent, for HEAD
+    PURPOSE: rendering of a response to a scrape, a body is composed
+        after HEAD_SIZE bytes of a response and its headers right before it,
+        once its length is known, so neither of them is moved
+    RETURN: nothing
+*/
+static void Metrics_render(
+    Metrics* const metrics,
+    MetricsConnection* const connection,
+    bool const bodiless
+) {
+    char head[HEAD_SIZE];
+    uint64_t samples;
+    char* body;
+    size_t length;
+    int written;
+
+    body = connection -> response + HEAD_SIZE;
+    length = 0;
+
+    if (Metrics_read(metrics, &samples)) { length += Metrics_cpus(metrics -> copy, body); }
+
+    length += FORMAT_COPY(body + length, METRICS_HEAD("cut_samples_total", "Records analyzed since start.", "counter"));
+    length += Metrics_line(body + length, "cut_samples_total", NULL, NULL);
+    length += Format_unsigned(body + length, samples);
+    body[length++] = '\n';
+
+    length += Metrics_health(metrics, body + length);
+
+    written = snprintf(
+        head, sizeof(head),
+        "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+        "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+        length
+    );
+
+    memcpy(body - written, head, (size_t) written);
+
+    connection -> output = body - written;
+    connection -> length = bodiless ? (size_t) written : (size_t) written + length;
+}
+
+/*
+    METHOD: Metrics_cpus
+    ARGUMENTS:
+        stats - a copy of the last published record
+        output - where samples are saved
+    PURPOSE: composition of usage and of every mode of aggregate cpu,
+        labelled "all", and of every online core, labelled with its id,
+        followed by age of a record, all without printf
+    RETURN: length of composed samples
+*/
+static size_t Metrics_cpus(
+    ConvertedStats const* const stats,
+    char* const output
+) {
+    uint16_t const* ids;
+    char cpu[8];
+    size_t digits;
+    size_t length;
+
+    ids = CONVERTED_IDS(stats);
+
+    length = FORMAT_COPY(output, METRICS_HEAD(
+        "cut_cpu_usage_percent", "Busy share of a cpu over the last sampling interval.", "gauge"
+    ));
+
+    for (size_t row = 0; row <= stats -> count; row++) {
+        if (row > 0 && ids[row] == STATS_OFFLINE) { continue; }
+
+        digits = row == 0 ? FORMAT_COPY(cpu, "all") : Format_unsigned(cpu, ids[row]);
+        cpu[digits] = '\0';
+
+        length += Metrics_line(output + length, "cut_cpu_usage_percent", "cpu", cpu);
+        length += Format_float(output + length, stats -> percentages[row]);
+        output[length++] = '\n';
+    }
+
+    length += FORMAT_COPY(output + length, METRICS_HEAD(
+        "cut_cpu_mode_percent", "Share of a cpu spent in a mode over the last sampling interval.", "gauge"
+    ));
+
+    for (size_t row = 0; row <= stats -> count; row++) {
+        if (row > 0 && ids[row] == STATS_OFFLINE) { continue; }
+
+        digits = row == 0 ? FORMAT_COPY(cpu, "all") : Format_unsigned(cpu, ids[row]);
+        cpu[digits] = '\0';
+
+        for (int column = 0; column < COLUMNS; column++) {
+            length += FORMAT_COPY(output + length, "cut_cpu_mode_percent{cpu=\"");
+            length += Metrics_string(output + length, cpu);
+            length += FORMAT_COPY(output + length, "\",mode=\"");
+            length += Metrics_string(output + length, MODE_NAMES[column]);
+            length += FORMAT_COPY(output + length, "\"} ");
+            length += Format_float(output + length, CONVERTED_COLUMN(stats, column)[row]);
+            output[length++] = '\n';
+        }
+    }
+
+    length += FORMAT_COPY(output + length, METRICS_HEAD(
+        "cut_sample_age_seconds", "Time since the last analyzed record was read.", "gauge"
+    ));
+    length += Metrics_line(output + length, "cut_sample_age_seconds", NULL, NULL);
+    length += Format_float(output + length, (double) (Scheduler_now() - stats -> timestamp) / NANOSECONDS);
+    output[length++] = '\n';
+
+    return length;
+}
+
+/*
+    METHOD: Metrics_health
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+        output - where samples are saved
+    PURPOSE: composition of counters of watched buffers, supervised stages,
+        scheduler and logger, read at once, all of them are safe to read
+        while tracker runs
+    RETURN: length of composed samples
+*/
+static size_t Metrics_health(
+    Metrics* const metrics,
+    char* const output
+) {
+    BufferStats buffers[METRICS_BUFFERS];
+    SupervisorStats stages[SUPERVISOR_STAGES];
+    size_t length;
+    size_t value;
+
+    length = 0;
+
+    for (int i = 0; i < metrics -> buffer_count; i++) {
+        if (Buffer_stats(metrics -> buffers[i], &buffers[i]) != OK) { memset(&buffers[i], 0, sizeof(BufferStats)); }
+    }
+
+    for (size_t family = 0; family < sizeof(BUFFER_FAMILIES) / sizeof(BUFFER_FAMILIES[0]) && metrics -> buffer_count > 0; family++) {
+        length += Metrics_string(output + length, BUFFER_FAMILIES[family].head);
+
+        for (int i = 0; i < metrics -> buffer_count; i++) {
+            memcpy(&value, (char const*) &buffers[i] + BUFFER_FAMILIES[family].offset, sizeof(value));
+
+            length += Metrics_line(output + length, BUFFER_FAMILIES[family].name, "buffer", metrics -> buffer_names[i]);
+            length += Format_unsigned(output + length, value);
+            output[length++] = '\n';
+        }
+    }
+
+    for (int stage = 0; stage < metrics -> stage_count; stage++) {
+        if (Supervisor_stats(metrics -> supervisor, stage, &stages[stage]) != OK) {
+            memset(&stages[stage], 0, sizeof(SupervisorStats));
+        }
+    }
+
+    if (metrics -> stage_count > 0) {
+        length += FORMAT_COPY(output + length, METRICS_HEAD(
+            "cut_stage_stalls_total", "Stalls of a stage seen by watchdog of supervisor.", "counter"
+        ));
+
+        for (int stage = 0; stage < metrics -> stage_count; stage++) {
+            length += Metrics_line(output + length, "cut_stage_stalls_total", "stage", metrics -> stage_names[stage]);
+            length += Format_unsigned(output + length, stages[stage].stalls);
+            output[length++] = '\n';
+        }
+
+        length += FORMAT_COPY(output + length, METRICS_HEAD(
+            "cut_stage_restarts_total", "Restarts of a stalled stage by supervisor.", "counter"
+        ));
+
+        for (int stage = 0; stage < metrics -> stage_count; stage++) {
+            length += Metrics_line(output + length, "cut_stage_restarts_total", "stage", metrics -> stage_names[stage]);
+            length += Format_unsigned(output + length, stages[stage].restarts);
+            output[length++] = '\n';
+        }
+
+        length += FORMAT_COPY(output + length, METRICS_HEAD(
+            "cut_stage_stalled_seconds", "Time a stage went without a heartbeat when last seen stalled.", "gauge"
+        ));
+
+        for (int stage = 0; stage < metrics -> stage_count; stage++) {
+            length += Metrics_line(output + length, "cut_stage_stalled_seconds", "stage", metrics -> stage_names[stage]);
+            length += Format_float(output + length, (double) stages[stage].stalled / NANOSECONDS);
+            output[length++] = '\n';
+        }
+    }
+
+    if (metrics -> scheduler != NULL) {
+        length += FORMAT_COPY(output + length, METRICS_HEAD(
+            "cut_scheduler_missed_ticks_total", "Sampling ticks which could not be kept.", "counter"
+        ));
+        length += Metrics_line(output + length, "cut_scheduler_missed_ticks_total", NULL, NULL);
+        length += Format_unsigned(output + length, Scheduler_missed(metrics -> scheduler));
+        output[length++] = '\n';
+    }
+
+    length += FORMAT_COPY(output + length, METRICS_HEAD(
+        "cut_log_dropped_total", "Log records dropped as logger could not keep up.", "counter"
+    ));
+    length += Metrics_line(output + length, "cut_log_dropped_total", NULL, NULL);
+    length += Format_unsigned(output + length, Logger_dropped());
+    output[length++] = '\n';
+
+    length += FORMAT_COPY(output + length, METRICS_HEAD(
+        "cut_scrapes_total", "Scrapes of /metrics served since start.", "counter"
+    ));
+    length += Metrics_line(output + length, "cut_scrapes_total", NULL, NULL);
+    length += Format_unsigned(output + length, metrics -> scrapes);
+    output[length++] = '\n';
+
+    return length;
+}
+
+/*
+    METHOD: Metrics_line
+    ARGUMENTS:
+        output - where a sample is saved
+        name - a name of a metric
+        label - a name of its only label, NULL for none
+        value - a value of its only label
+    PURPOSE: composition of a sample up to its value, which follows it
+    RETURN: length of a composed sample
+*/
+static size_t Metrics_line(
+    char* const output,
+    char const* const name,
+    char const* const label,
+    char const* const value
+) {
+    size_t length;
+
+    length = Metrics_string(output, name);
+
+    if (label != NULL) {
+        output[length++] = '{';
+        length += Metrics_string(output + length, label);
+        length += FORMAT_COPY(output + length, "=\"");
+        length += Metrics_string(output + length, value);
+        length += FORMAT_COPY(output + length, "\"}");
+    }
+
+    output[length++] = ' ';
+
+    return length;
+}
+
+/*
+    METHOD: Metrics_string
+    ARGUMENTS:
+        output - where a string is saved
+        string - a string to be copied
+    PURPOSE: copy of a string without its terminator
+    RETURN: length of a copied string
+*/
+static size_t Metrics_string(
+    char* const output,
+    char const* const string
+) {
+    size_t length;
+
+    length = strlen(string);
+    memcpy(output, string, length);
+
+    return length;
+}
+
+/*
+    METHOD: Metrics_start
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+    PURPOSE: start of a thread serving scrapes until Metrics_join,
+        for a tracker whose stages have threads of their own
+    RETURN: enums integer value
+*/
+int Metrics_start(
+    Metrics* const metrics
+) {
+    if (metrics == NULL) { return ERR_PARAMS; }
+    if (metrics -> thread_started) { return ERR_RUN; }
+
+    atomic_store(&(metrics -> running), true);
+
+    if (pthread_create(&(metrics -> thread), NULL, Metrics_threadf, metrics) != 0) {
+        atomic_store(&(metrics -> running), false);
+        return ERR_CREATE;
+    }
+
+    metrics -> thread_started = true;
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_threadf
+    ARGUMENTS:
+        args - a Metrics object to work on
+    PURPOSE: serving of scrapes, waiting for them without a timeout,
+        woken through wake eventfd on join
+    RETURN: nothing
+*/
+static void* Metrics_threadf(
+    void* const args
+) {
+    Metrics* metrics;
+
+    LOG_DEBUG("METRICS", "THREAD FUNCTION STARTED");
+
+    metrics = (Metrics*) args;
+
+    while (atomic_load(&(metrics -> running))) {
+        if (Metrics_serve(metrics, -1) != OK) {
+            LOG_ERROR("METRICS", "ERROR WHEN SERVING SCRAPES");
+            break;
+        }
+    }
+
+    LOG_DEBUG("METRICS", "THREAD FUNCTION FINISHED");
+
+    pthread_exit(NULL);
+}
+
+/*
+    METHOD: Metrics_join
+    ARGUMENTS:
+        metrics - a Metrics object to work on
+    PURPOSE: stop and join of a thread serving scrapes
+    RETURN: enums integer value
+*/
+int Metrics_join(
+    Metrics* const metrics
+) {
+    uint64_t const wake = 1;
+
+    if (metrics == NULL) { return ERR_PARAMS; }
+    if (!metrics -> thread_started) { return OK; }
+
+    atomic_store(&(metrics -> running), false);
+
+    if (write(metrics -> wake, &wake, sizeof(wake)) != sizeof(wake)) {
+        LOG_WARN("METRICS", "COULD NOT WAKE SERVING THREAD");
+    }
+
+    if (pthread_join(metrics -> thread, NULL) != 0) { return ERR_JOIN; }
+
+    metrics -> thread_started = false;
+
+    return OK;
+}
+
+/*
+    METHOD: Metrics_destroy
+    ARGUMENTS:
+        metrics - a Metrics object to be freed
+    PURPOSE: join of its thread, close of every connection and of
+        its sockets and free of memory taken by a given Metrics object
+    RETURN: nothing
+*/
+void Metrics_destroy(
+    Metrics* const metrics
+) {
+    if (metrics == NULL) { return; }
+
+    Metrics_join(metrics);
+
+    for (int i = 0; i < CONNECTIONS; i++) {
+        if (metrics -> connections[i].fd >= 0) { Metrics_close(&(metrics -> connections[i])); }
+    }
+
+    close(metrics -> wake);
+    close(metrics -> epoll);
+    close(metrics -> listener);
+
+    free(metrics -> snapshot);
+    free(metrics -> copy);
+    free(metrics -> responses);
+    free(metrics);
+}
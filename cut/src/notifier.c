@@ -1,26 +1,29 @@
 /*
     AUTHOR: DENIS STOCKI                  
     FILE: notifier.c                       
-    PURPOSE: implementation of notifier module
+    PURPOSE: implementation of notifier module, a lock-free heartbeat 
+        holding monotonic time of the last notification of a stage
 */
 
 // INCLUDES OF OUTSIDE LIBRARIES
-#include <pthread.h>    
+#include <stdatomic.h>    
 #include <stdlib.h>     
-#include <string.h>     
+#include <stdint.h>     
 #include <stdbool.h>     
 #include <time.h>       
-#include <sys/time.h>   
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/enums.h"
 #include "../inc/notifier.h"
 
-// STRUCTURE FOR HOLDING NOTIFIER OBJECT
+// MACRO DEFINITION
+#define NANOSECONDS 1000000000u
+
+// STRUCTURE FOR HOLDING NOTIFIER OBJECT, BEAT IS WRITTEN BY A STAGE, 
+// CHECKED BY A SINGLE CHECKING THREAD
 struct notifier {
-    pthread_mutex_t mutex;
-    bool notified;
-    char padding[7];
+    atomic_uint_fast64_t beat;
+    uint64_t checked;
 };
 
 /*
@@ -40,8 +43,8 @@ Notifier* Notifier_init(
     if (notifier == NULL) { return NULL; }
     
     *notifier = (Notifier) {
-        .mutex = PTHREAD_MUTEX_INITIALIZER,
-        .notified = false
+        .beat = 0,
+        .checked = 0
     };
 
     return notifier;
@@ -50,40 +53,65 @@ Notifier* Notifier_init(
 /*
     METHOD: Notifier_notify
     ARGUMENTS: 
-        notifier - an object which notified field will be changed on
-    PURPOSE: thread safe change of notfied field to true
+        notifier - an object which heartbeat will be updated
+    PURPOSE: a single relaxed store of current monotonic time,
+        nothing else is ordered by it, so no lock nor fence is needed
     RETURN: enums integer value
 */
 int Notifier_notify(
     Notifier* const notifier
 ) {
+    struct timespec now;
+
     if (notifier == NULL) { return ERR_PARAMS; }
-    
-    pthread_mutex_lock(&(notifier -> mutex));
-    notifier -> notified = true;
-    pthread_mutex_unlock(&(notifier -> mutex));
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    atomic_store_explicit(
+        &(notifier -> beat), 
+        (uint64_t) now.tv_sec * NANOSECONDS + (uint64_t) now.tv_nsec, 
+        memory_order_relaxed
+    );
 
     return OK;
 }
 
+/*
+    METHOD: Notifier_last
+    ARGUMENTS: 
+        notifier - an object which heartbeat will be read
+    PURPOSE: read of monotonic time of the last notification
+    RETURN: time in nanoseconds or 0 when never notified
+*/
+uint64_t Notifier_last(
+    Notifier* const notifier
+) {
+    if (notifier == NULL) { return 0; }
+
+    return atomic_load_explicit(&(notifier -> beat), memory_order_relaxed);
+}
+
 /*
     METHOD: Notifier_check
     ARGUMENTS: 
-        notifier - an object which notified field will be checked on
+        notifier - an object which heartbeat will be checked on
         notfied - a pointer to a variable which the result will be saved into
-    PURPOSE: save of notified value to a given pointer
+    PURPOSE: save of whether a given object was notified since 
+        the previous check, to be called by one thread only
     RETURN: enums integer value
 */
 int Notifier_check(
     Notifier* const notifier,
     bool* notified
 ) {
+    uint64_t beat;
+
     if (notifier == NULL || notified == NULL) { return ERR_PARAMS; }
     
-    pthread_mutex_lock(&(notifier -> mutex));
-    *notified = notifier -> notified;
-    notifier -> notified = false;
-    pthread_mutex_unlock(&(notifier -> mutex));
+    beat = Notifier_last(notifier);
+
+    *notified = beat != notifier -> checked;
+    notifier -> checked = beat;
 
     return OK;
 }
@@ -99,8 +127,6 @@ void Notifier_destroy(
     Notifier* const notifier
 ) {
     if (notifier == NULL) { return ; }
-    
-    pthread_mutex_destroy(&(notifier -> mutex));
 
     free(notifier);
 }
@@ -0,0 +1,190 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: pool.c                       
+    PURPOSE: implementation of pool module, fixed size blocks
+        allocated once and shared by threads through a lock-free
+        freelist, so steady state work does no heap allocation
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/enums.h"
+#include "../inc/pool.h"
+
+// MACRO DEFINITION
+#define CACHE_LINE 64
+
+// STRUCTURE FOR HOLDING POOL OBJECT
+struct pool {
+    uint8_t* blocks;
+    size_t size;
+    size_t count;
+    // LOW HALF IS INDEX OF FIRST FREE BLOCK PLUS ONE, HIGH HALF IS A TAG AGAINST ABA
+    _Alignas(CACHE_LINE) atomic_uint_fast64_t head;
+    atomic_size_t available;
+    // INDEX OF NEXT FREE BLOCK PLUS ONE FOR EVERY BLOCK, ZERO ENDS THE LIST
+    _Alignas(CACHE_LINE) atomic_uint next[];
+};
+
+/*
+    METHOD: Pool_init
+    ARGUMENTS:
+        size - size of a single block
+        count - number of blocks
+    PURPOSE: creation of Pool object with all blocks free,
+        blocks are aligned to cache lines so neighbours are not shared
+    RETURN: Pool object or NULL in case creation was not possible
+*/
+Pool* Pool_init(
+    size_t const size,
+    size_t const count
+) {
+    Pool* pool;
+    size_t rounded;
+    size_t bytes;
+    size_t i;
+
+    if (size == 0 || count == 0 || count >= UINT32_MAX) { return NULL; }
+
+    rounded = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    // ALIGNED MEMBERS ARE ON THEIR OWN LINES ONLY IF POOL ITSELF STARTS ON ONE
+    bytes = sizeof(Pool) + sizeof(atomic_uint) * count;
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    pool = (Pool*) aligned_alloc(CACHE_LINE, bytes);
+
+    if (pool == NULL) { return NULL; }
+
+    pool -> blocks = (uint8_t*) aligned_alloc(CACHE_LINE, rounded * count);
+
+    if (pool -> blocks == NULL) {
+        free(pool);
+        return NULL;
+    }
+
+    pool -> size = rounded;
+    pool -> count = count;
+
+    for (i = 0; i < count; i++) {
+        atomic_init(&(pool -> next[i]), i + 1 < count ? (unsigned int) (i + 2) : 0);
+    }
+
+    atomic_init(&(pool -> head), 1);
+    atomic_init(&(pool -> available), count);
+
+    return pool;
+}
+
+/*
+    METHOD: Pool_acquire
+    ARGUMENTS:
+        pool - an object from which a block will be taken
+    PURPOSE: lock-free take of a free block, never waits
+    RETURN: pointer to a block or NULL when pool is exhausted
+*/
+void* Pool_acquire(
+    Pool* const pool
+) {
+    uint_fast64_t head;
+    uint_fast64_t next;
+    unsigned int index;
+
+    if (pool == NULL) { return NULL; }
+
+    head = atomic_load_explicit(&(pool -> head), memory_order_acquire);
+
+    do {
+        index = (unsigned int) (head & UINT32_MAX);
+
+        if (index == 0) { return NULL; }
+
+        next = atomic_load_explicit(&(pool -> next[index - 1]), memory_order_relaxed);
+        next |= ((head >> 32) + 1) << 32;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &(pool -> head), &head, next, 
+        memory_order_acq_rel, memory_order_acquire
+    ));
+
+    atomic_fetch_sub_explicit(&(pool -> available), 1, memory_order_relaxed);
+
+    return &(pool -> blocks[(index - 1) * pool -> size]);
+}
+
+/*
+    METHOD: Pool_release
+    ARGUMENTS:
+        pool - an object to which a block will be given back
+        block - a block taken from a given pool
+    PURPOSE: lock-free return of a block, possibly from
+        another thread than the one which acquired it
+    RETURN: enums integer value
+*/
+int Pool_release(
+    Pool* const pool,
+    void* const block
+) {
+    uint_fast64_t head;
+    uint_fast64_t next;
+    size_t offset;
+    unsigned int index;
+
+    if (pool == NULL || block == NULL) { return ERR_PARAMS; }
+
+    offset = (size_t) ((uint8_t*) block - pool -> blocks);
+
+    if ((uint8_t*) block < pool -> blocks || offset % pool -> size != 0 || offset / pool -> size >= pool -> count) { 
+        return ERR_PARAMS; 
+    }
+
+    index = (unsigned int) (offset / pool -> size) + 1;
+
+    head = atomic_load_explicit(&(pool -> head), memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&(pool -> next[index - 1]), (unsigned int) (head & UINT32_MAX), memory_order_relaxed);
+        next = (((head >> 32) + 1) << 32) | index;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &(pool -> head), &head, next, 
+        memory_order_release, memory_order_relaxed
+    ));
+
+    atomic_fetch_add_explicit(&(pool -> available), 1, memory_order_relaxed);
+
+    return OK;
+}
+
+/*
+    METHOD: Pool_available
+    ARGUMENTS:
+        pool - an object which free blocks will be counted
+    PURPOSE: read of a number of free blocks, may be slightly stale
+    RETURN: number of free blocks
+*/
+size_t Pool_available(
+    Pool* const pool
+) {
+    if (pool == NULL) { return 0; }
+
+    return atomic_load_explicit(&(pool -> available), memory_order_relaxed);
+}
+
+/*
+    METHOD: Pool_destroy
+    ARGUMENTS:
+        pool - an object to be freed
+    PURPOSE: free of a given object's memory with all its blocks
+    RETURN: nothing
+*/
+void Pool_destroy(
+    Pool* pool
+) {
+    if (pool == NULL) { return; }
+
+    free(pool -> blocks);
+    free(pool);
+}
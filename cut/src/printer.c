@@ -10,43 +10,105 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
+#include <time.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/printer.h"
 #include "../inc/enums.h"
-#include "../inc/watchdog.h"
 #include "../inc/logger.h"
+#include "../inc/status.h"
 #include "../inc/notifier.h"
 #include "../inc/stats.h"
+#include "../inc/scheduler.h"
+#include "../inc/screen.h"
+#include "../inc/sink.h"
+
+// MACRO DEFINITION
+#define BAR 25
+#define WIDTH 128
+#define HEADER_ROWS 5
+#define FOOTER_ROWS 2
+#define BREAKDOWN_SIZE 16
+#define HISTORY 8
+#define LEVELS 8
+#define SOCKETS 16
+#define SINKS 8
+#define NO_SAMPLE UINT8_MAX
+#define TOPOLOGY "/sys/devices/system/cpu/cpu%u/topology/physical_package_id"
 
 // STRUCTURE FOR HOLDING PRINTER OBJECT
 struct printer {
-    Watchdog* watchdog;
     Notifier* notifier;
+    Screen* screen;
     Buffer* bufferAP;
+    Pool* pool;
+    Histogram* latency;
+    volatile sig_atomic_t* status;
+    uint8_t* history;
+    uint16_t* sockets;
+    uint16_t* socket_ids;
+    Sink* sinks[SINKS];
+    ScreenCell levels[LEVELS];
     pthread_t thread;
-    uint8_t proc;
+    unsigned head;
+    int layout;
+    int sink_count;
+    uint16_t proc;
     bool thread_started;
-    char padding[6];
+    char padding[5];
 };
 
+// STRUCTURE FOR HOLDING A SHAPE OF HEATMAP TILES, A SPARKLINE OF WIDTH CELLS AND A GAP
+typedef struct Tiles {
+    uint16_t width;
+    uint16_t gap;
+} Tiles;
+
 // STRUCTURE FOR HOLDING THREADPARAMS
 typedef struct ThreadParams {
     Printer* printer;
     volatile sig_atomic_t* status;
-    atomic_flag* status_watch;
 } ThreadParams;
 
 // DECLARATIONS OF PROTOTYPE FUNCTIONS
+static int Printer_spawn(Printer* const);
 static void* Printer_threadf(void* const);
-static void Printer_print(ConvertedStats* const);
-static void Printer_toScreen(float const);
+static void Printer_print(Printer* const, ConvertedStats* const);
+static void Printer_emit(Printer* const, ConvertedStats* const);
+static void Printer_bars(Printer* const, ConvertedStats* const);
+static void Printer_heatmap(Printer* const, ConvertedStats* const);
+static void Printer_record(Printer* const, ConvertedStats* const);
+static uint16_t Printer_socket(uint16_t const);
+static uint16_t Printer_groups(Printer* const, ConvertedStats* const, uint16_t* const, uint16_t* const);
+static void Printer_bar(char* const, float const);
+static unsigned Printer_hundredths(float const);
+static void Printer_breakdown(ConvertedStats* const, size_t const, char* const, size_t const);
+
+// SHORT NAMES OF COUNTER COLUMNS, IN /PROC/STAT ORDER
+static char const* const COLUMN_NAMES[COLUMNS] = {
+    "usr", "nic", "sys", "idl", "iow", "irq", "sirq", "stl", "gst", "gnc"
+};
+
+// BLOCK GLYPHS OF HEATMAP LEVELS, LOWEST TO HIGHEST, IN UTF-8
+static char const* const LEVEL_GLYPHS[LEVELS] = {
+    "\xe2\x96\x81", "\xe2\x96\x82", "\xe2\x96\x83", "\xe2\x96\x84", 
+    "\xe2\x96\x85", "\xe2\x96\x86", "\xe2\x96\x87", "\xe2\x96\x88"
+};
+
+// 256 COLOR PALETTE INDEXES OF HEATMAP LEVELS, GREEN TO RED
+static uint8_t const LEVEL_COLORS[LEVELS] = { 34, 70, 106, 142, 178, 214, 208, 196 };
+
+// SHAPES OF HEATMAP TILES, WIDEST FIRST, FIRST ONE THAT FITS TERMINAL IS USED
+static Tiles const TILES[] = { { HISTORY, 1 }, { 4, 1 }, { 2, 1 }, { 1, 1 }, { 1, 0 } };
 
 /*
     METHOD: Printer_init
     ARGUMENTS:
         bufferAP - an object of Analyzer-Printer buffer
+        pool - a pool to which printed records are released
+        latency - a histogram of time from read to print of every record
         proc - a value of computer's core count
     PURPOSE: creation of Printer object
     RETURN: Printer object or NULL in 
@@ -54,15 +116,20 @@ static void Printer_toScreen(float const);
 */
 Printer* Printer_init(
     Buffer* bufferAP,
-    uint8_t proc
+    Pool* pool,
+    Histogram* latency,
+    uint16_t proc
 ) {
-    Watchdog* watchdog;
     Notifier* notifier;
+    Screen* screen;
     Printer* printer;
+    uint8_t* history;
+    uint16_t* sockets;
+    uint16_t* socket_ids;
 
-    Logger_log("PRINTER", "INIT STARTED");
+    LOG_DEBUG("PRINTER", "INIT STARTED");
 
-    if (bufferAP == NULL || proc <= 0) { return NULL; }
+    if (bufferAP == NULL || pool == NULL || latency == NULL || proc <= 0) { return NULL; }
     
     printer = (Printer*) malloc(sizeof(Printer));
 
@@ -72,19 +139,51 @@ Printer* Printer_init(
 
     if (notifier == NULL) { return NULL; }
 
-    watchdog = Watchdog_init(notifier, "PRINTER");
+    // ROW OF EVERY CORE BETWEEN HEADER AND FOOTER, KEPT WHEN TERMINAL'S SIZE IS UNKNOWN
+    screen = Screen_init((uint16_t) (HEADER_ROWS + proc + FOOTER_ROWS), WIDTH, STDOUT_FILENO);
+
+    // HISTORY OF EVERY CORE FOR ITS SPARKLINE AND ITS SOCKET, READ ONCE PER CPU ID
+    history = (uint8_t*) malloc((size_t) proc * HISTORY);
+    sockets = (uint16_t*) malloc((size_t) proc * sizeof(uint16_t));
+    socket_ids = (uint16_t*) malloc((size_t) proc * sizeof(uint16_t));
+
+    if (screen == NULL || history == NULL || sockets == NULL || socket_ids == NULL) { 
+        free(socket_ids);
+        free(sockets);
+        free(history);
+        Screen_destroy(screen);
+        Notifier_destroy(notifier);
+        free(printer);
+        return NULL; 
+    }
 
-    if (watchdog == NULL) { return NULL; }
+    memset(history, NO_SAMPLE, (size_t) proc * HISTORY);
+
+    for (uint16_t i = 0; i < proc; i++) { socket_ids[i] = STATS_OFFLINE; }
     
     *printer = (Printer) {
-        .watchdog = watchdog,
         .notifier = notifier,
+        .screen = screen,
         .bufferAP = bufferAP,
+        .pool = pool,
+        .latency = latency,
+        .status = NULL,
+        .history = history,
+        .sockets = sockets,
+        .socket_ids = socket_ids,
+        .head = 0,
+        .sinks = { NULL },
+        .layout = PRINTER_BARS,
+        .sink_count = 0,
         .proc = proc,
         .thread_started = false
     };
 
-    Logger_log("PRINTER", "INIT FINISHED");
+    for (int level = 0; level < LEVELS; level++) {
+        printer -> levels[level] = Screen_glyph(LEVEL_GLYPHS[level], LEVEL_COLORS[level]);
+    }
+
+    LOG_DEBUG("PRINTER", "INIT FINISHED");
 
     return printer;
 }
@@ -99,36 +198,57 @@ Printer* Printer_init(
 */
 int Printer_start(
     Printer* const printer,
-    volatile sig_atomic_t* status,
-    atomic_flag* status_watch
+    volatile sig_atomic_t* status
 ) {
-    ThreadParams* params;
+    int result;
 
-    Logger_log("PRINTER", "START STARTED");
+    LOG_DEBUG("PRINTER", "START STARTED");
 
     if (
         printer == NULL ||
+        printer -> thread_started ||
         *status != RUNNING
     ) { return ERR_PARAMS; }
 
+    printer -> status = status;
+
+    result = Printer_spawn(printer);
+
+    if (result != OK) { return result; }
+
+    LOG_DEBUG("PRINTER", "START FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Printer_spawn
+    ARGUMENTS:
+        printer - a Printer object to work on
+    PURPOSE: creation of printer's thread
+    RETURN: enum integer value
+*/
+static int Printer_spawn(
+    Printer* const printer
+) {
+    ThreadParams* params;
+
     params = (ThreadParams*) malloc(sizeof(ThreadParams));
 
     if (params == NULL) { return ERR_ALLOC; }
 
     *params = (ThreadParams) {
         .printer = printer,
-        .status = status,
-        .status_watch = status_watch
+        .status = printer -> status
     };
 
     if (pthread_create(&(printer -> thread), NULL, Printer_threadf, (void*) params) != 0) {
+        free(params);
         return ERR_CREATE;
     }
 
     printer -> thread_started = true;
 
-    Logger_log("PRINTER", "START FINISHED");
-
     return OK;
 }
 
@@ -142,7 +262,7 @@ int Printer_start(
 int Printer_join(
     Printer* const printer
 ) {
-    Logger_log("PRINTER", "JOIN STARTED");
+    LOG_DEBUG("PRINTER", "JOIN STARTED");
 
     if (printer == NULL) { return ERR_PARAMS; }
     if (printer -> thread_started == false) { return ERR_PARAMS; }
@@ -150,7 +270,9 @@ int Printer_join(
         return ERR_JOIN;
     }
 
-    Logger_log("PRINTER", "JOIN FINISHED");
+    printer -> thread_started = false;
+
+    LOG_DEBUG("PRINTER", "JOIN FINISHED");
 
     return OK;
 }
@@ -159,114 +281,539 @@ int Printer_join(
     METHOD: Printer_threadf
     ARGUMENTS:
         args - a pointer to function's parameters
-    PURPOSE: acomplishing printer thread's work
+    PURPOSE: acomplishing printer thread's work, ending on its own closes the pipeline
     RETURN: nothing
 */
 static void* Printer_threadf(
     void* const args
 ) {
     ThreadParams* params;
-    ConvertedStats* converted;
 
-    Logger_log("PRINTER", "THREAD FUNCTION STARTED");
+    LOG_DEBUG("PRINTER", "THREAD FUNCTION STARTED");
 
     params = (ThreadParams*)args;
-    converted = malloc(sizeof(ConvertedStats) + sizeof(float) * params -> printer -> proc);
-
-    if (converted == NULL) {
-        pthread_exit(NULL);
-    } 
-
-    Watchdog_start(params -> printer -> watchdog, params -> status, params -> status_watch);
 
+    // DRIVEN BY RECORDS ARRIVING FROM ANALYZER, CLOSED BUFFER ENDS THE LOOP
     while (*(params -> status) == RUNNING) {
-        if (Buffer_pop(params -> printer -> bufferAP, converted) != OK) {
-            free(converted);
-            break;
-        }
+        if (Printer_step(params -> printer, true) != OK) { break; }
 
         Notifier_notify(params -> printer -> notifier);
-
-        Printer_print(converted);
-        
-        free(converted -> percentages);
-        
-        sleep(1);
     }
 
-    Watchdog_join(params -> printer -> watchdog);
+    Buffer_close(params -> printer -> bufferAP);
+    Status_set(params -> status, TERMINATED);
 
-    Logger_log("PRINTER", "THREAD FUNCTION FINISHED");
+    LOG_DEBUG("PRINTER", "THREAD FUNCTION FINISHED");
 
     free(params);
-    free(converted);
 
     pthread_exit(NULL);
 }
 
+/*
+    METHOD: Printer_step
+    ARGUMENTS:
+        printer - a Printer object to work on
+        wait - true to wait for a record, false to return 
+            at once when analyzer has not passed any
+    PURPOSE: single record of printer's stage, shared by 
+        threaded and event loop mode
+    RETURN: enums integer value, ERR_TIMEOUT when no record 
+        was waiting, ERR_CLOSED when buffer was closed
+*/
+int Printer_step(
+    Printer* const printer,
+    bool const wait
+) {
+    struct timespec const now = { 0, 0 };
+    ConvertedStats* converted;
+    int status;
+
+    if (printer == NULL) { return ERR_PARAMS; }
+
+    status = wait 
+        ? Buffer_pop(printer -> bufferAP, &converted) 
+        : Buffer_popTimed(printer -> bufferAP, &converted, &now);
+
+    if (status != OK) { return status == ERR_TIMEOUT ? ERR_TIMEOUT : ERR_CLOSED; }
+
+    Printer_print(printer, converted);
+    Printer_emit(printer, converted);
+
+    Histogram_record(printer -> latency, Scheduler_now() - converted -> timestamp);
+
+    Pool_release(printer -> pool, converted);
+
+    return OK;
+}
+
 /*
     METHOD: Printer_print
     ARGUMENTS:
+        printer - a Printer object to work on
         convertedStats - an object of convertedStats
-    PURPOSE: print of a given object to the screen
+    PURPOSE: composition of a frame of a given object in printer's 
+        layout, sent to the screen as a difference to the previous one
     RETURN: nothing
 */
 static void Printer_print(
+    Printer* const printer,
     ConvertedStats* convertedStats
 ) {
-    Logger_log("PRINTER", "PRINT STARTED");
+    LOG_TRACE("PRINTER", "PRINT STARTED");
 
-    if (convertedStats == NULL) { return; }
-    
-    printf("\033[H\033[J");
+    if (convertedStats == NULL || printer -> layout == PRINTER_NONE) { return; }
+
+    Printer_record(printer, convertedStats);
+
+    if (printer -> layout == PRINTER_HEATMAP) { Printer_heatmap(printer, convertedStats); }
+    else { Printer_bars(printer, convertedStats); }
+
+    if (Screen_render(printer -> screen) != OK) {
+        LOG_WARN("PRINTER", "FRAME NOT WRITTEN");
+    }
+
+    LOG_TRACE("PRINTER", "PRINT FINISHED");
+}
+
+/*
+    METHOD: Printer_emit
+    ARGUMENTS:
+        printer - a Printer object to work on
+        convertedStats - an object of convertedStats
+    PURPOSE: encoding of a given object by every sink, which are 
+        written once analyzer has no more records waiting, so 
+        records printed late are batched into a single write
+    RETURN: nothing
+*/
+static void Printer_emit(
+    Printer* const printer,
+    ConvertedStats* const convertedStats
+) {
+    bool flush;
+
+    if (printer -> sink_count == 0) { return; }
+
+    flush = Buffer_isEmpty(printer -> bufferAP);
+
+    for (int i = 0; i < printer -> sink_count; i++) {
+        if (
+            Sink_emit(printer -> sinks[i], &convertedStats, 1) != OK ||
+            (flush && Sink_flush(printer -> sinks[i]) != OK)
+        ) { LOG_WARN("PRINTER", "RECORD OF SINK %d NOT WRITTEN", i); }
+    }
+}
+
+/*
+    METHOD: Printer_bars
+    ARGUMENTS:
+        printer - a Printer object to work on
+        convertedStats - an object of convertedStats
+    PURPOSE: composition of a frame fitted to the terminal with 
+        a bar for every online core, cores which do not fit 
+        are counted in a row of their own instead
+    RETURN: nothing
+*/
+static void Printer_bars(
+    Printer* const printer,
+    ConvertedStats* const convertedStats
+) {
+    char bar[BAR + 1];
+    char breakdown[COLUMNS * BREAKDOWN_SIZE];
+    unsigned usage;
+    uint16_t online;
+    uint16_t fit;
+    uint16_t rows;
+    uint16_t cols;
+    uint16_t row;
+
+    // ROWS PAST TERMINAL'S HEIGHT WOULD ALL BE DRAWN OVER ITS LAST LINE
+    Screen_fit(printer -> screen);
+    Screen_size(printer -> screen, &rows, &cols);
+    Screen_clear(printer -> screen);
+
+    online = 0;
+
+    for (uint16_t i = 0; i < convertedStats -> count; i++) {
+        if (CONVERTED_IDS(convertedStats)[i + 1] != STATS_OFFLINE) { online++; }
+    }
+
+    fit = rows > HEADER_ROWS + FOOTER_ROWS ? (uint16_t) (rows - HEADER_ROWS - FOOTER_ROWS) : 0;
+
+    // LAST ROW OF CORES IS GIVEN TO A COUNT OF THOSE LEFT OUT
+    if (online > fit) { fit = fit > 0 ? (uint16_t) (fit - 1) : 0; }
+
+    Screen_line(printer -> screen, 0, "================ TRACKER ================");
+
+    usage = Printer_hundredths(convertedStats -> percentages[0]);
+
+    Printer_bar(bar, convertedStats -> percentages[0]);
+    Screen_line(printer -> screen, 2, "cpu:   [%s] %u.%02u%%", bar, usage / 100, usage % 100);
+
+    Printer_breakdown(convertedStats, 0, breakdown, sizeof(breakdown));
+    Screen_line(printer -> screen, 3, "       %s", breakdown);
+
+    row = HEADER_ROWS;
+
+    for(uint16_t i = 0; i < convertedStats -> count && row < HEADER_ROWS + fit; i++) {
+        if (CONVERTED_IDS(convertedStats)[i + 1] == STATS_OFFLINE) { continue; }
+
+        usage = Printer_hundredths(convertedStats -> percentages[i + 1]);
+
+        Printer_bar(bar, convertedStats -> percentages[i + 1]);
+        Screen_line(
+            printer -> screen, row++, "cpu%u:  [%s] %u.%02u%%", 
+            CONVERTED_IDS(convertedStats)[i + 1], bar, usage / 100, usage % 100
+        );
+    }
+
+    if (online > fit) { Screen_line(printer -> screen, row++, "+%u more", online - fit); }
+
+    Screen_line(printer -> screen, (uint16_t) (row + 1), "================ TRACKER ================");
+}
+
+/*
+    METHOD: Printer_heatmap
+    ARGUMENTS:
+        printer - a Printer object to work on
+        convertedStats - an object of convertedStats
+    PURPOSE: composition of a frame fitted to the terminal, with 
+        a tile of every online core grouped by its socket, a tile 
+        is a sparkline of recent usage, colored by heat, and shrinks 
+        down to a single cell of current usage until all cores fit
+    RETURN: nothing
+*/
+static void Printer_heatmap(
+    Printer* const printer,
+    ConvertedStats* const convertedStats
+) {
+    uint16_t groups[SOCKETS];
+    uint16_t counts[SOCKETS];
+    Tiles tiles;
+    uint16_t rows;
+    uint16_t cols;
+    uint16_t count;
+    uint16_t per_row;
+    uint16_t row;
+    uint16_t tile;
+    unsigned needed;
+    unsigned usage;
+    uint8_t sample;
+
+    Screen_fit(printer -> screen);
+    Screen_size(printer -> screen, &rows, &cols);
+    Screen_clear(printer -> screen);
+
+    count = Printer_groups(printer, convertedStats, groups, counts);
+
+    // TWO HEADER ROWS, THEN A ROW NAMING EVERY SOCKET FOLLOWED BY ROWS OF ITS TILES
+    tiles = TILES[0];
+
+    for (size_t shape = 0; shape < sizeof(TILES) / sizeof(TILES[0]); shape++) {
+        tiles = TILES[shape];
+        per_row = cols / (tiles.width + tiles.gap);
+        needed = 2;
+
+        for (uint16_t group = 0; group < count && per_row > 0; group++) {
+            needed += 1 + (counts[group] + per_row - 1u) / per_row;
+        }
+
+        if (per_row > 0 && needed <= rows) { break; }
+    }
+
+    per_row = cols / (tiles.width + tiles.gap);
+    if (per_row == 0) { per_row = 1; }
+
+    usage = Printer_hundredths(convertedStats -> percentages[0]);
+
+    Screen_line(printer -> screen, 0, "================ TRACKER ================");
+    Screen_line(printer -> screen, 1, "cpu: %u.%02u%%  cores: %u  sockets: %u", usage / 100, usage % 100, convertedStats -> count, count);
+
+    row = 2;
 
-    printf("================ TRACKER ================\n\n");
+    for (uint16_t group = 0; group < count; group++) {
+        Screen_line(printer -> screen, row++, "socket %u", groups[group]);
 
-    printf("cpu:   ");
+        tile = 0;
 
-    Printer_toScreen(convertedStats -> percentages_average);
+        for (uint16_t i = 0; i < convertedStats -> count && i < printer -> proc; i++) {
+            if (CONVERTED_IDS(convertedStats)[i + 1] == STATS_OFFLINE || printer -> sockets[i] != groups[group]) { continue; }
 
-    printf("\n");
+            for (uint16_t cell = 0; cell < tiles.width; cell++) {
+                sample = printer -> history[(size_t) i * HISTORY + (printer -> head - tiles.width + cell) % HISTORY];
 
-    for(uint8_t i = 0; i < convertedStats -> count; i++) {
-        printf("cpu%d:  ", i);
-        Printer_toScreen(convertedStats -> percentages[i]);
-        printf("\n");
+                if (sample == NO_SAMPLE) { continue; }
+
+                Screen_cell(
+                    printer -> screen, (uint16_t) (row + tile / per_row), 
+                    (uint16_t) ((tile % per_row) * (tiles.width + tiles.gap) + cell), 
+                    printer -> levels[sample * LEVELS / 101]
+                );
+            }
+
+            tile++;
+        }
+
+        row = (uint16_t) (row + (tile + per_row - 1) / per_row);
+    }
+}
+
+/*
+    METHOD: Printer_record
+    ARGUMENTS:
+        printer - a Printer object to work on
+        convertedStats - an object of convertedStats
+    PURPOSE: saving of usage of every core into its history,
+        and reading of a socket of every core whose cpu id changed
+    RETURN: nothing
+*/
+static void Printer_record(
+    Printer* const printer,
+    ConvertedStats* const convertedStats
+) {
+    uint16_t id;
+    unsigned usage;
+
+    for (uint16_t i = 0; i < convertedStats -> count && i < printer -> proc; i++) {
+        id = CONVERTED_IDS(convertedStats)[i + 1];
+        usage = Printer_hundredths(convertedStats -> percentages[i + 1]) / 100;
+
+        printer -> history[(size_t) i * HISTORY + printer -> head % HISTORY] = 
+            id == STATS_OFFLINE ? NO_SAMPLE : (uint8_t) (usage > 100 ? 100 : usage);
+
+        if (id != STATS_OFFLINE && id != printer -> socket_ids[i]) {
+            printer -> sockets[i] = Printer_socket(id);
+            printer -> socket_ids[i] = id;
+        }
+    }
+
+    printer -> head++;
+}
+
+/*
+    METHOD: Printer_socket
+    ARGUMENTS:
+        id - cpu id of a core
+    PURPOSE: reading of a physical package a given core belongs to
+    RETURN: socket of a given core, 0 when it is not known
+*/
+static uint16_t Printer_socket(
+    uint16_t const id
+) {
+    char path[96];
+    FILE* file;
+    int socket;
+
+    snprintf(path, sizeof(path), TOPOLOGY, id);
+
+    file = fopen(path, "r");
+
+    if (file == NULL) { return 0; }
+
+    if (fscanf(file, "%d", &socket) != 1 || socket < 0 || socket >= UINT16_MAX) { socket = 0; }
+
+    fclose(file);
+
+    return (uint16_t) socket;
+}
+
+/*
+    METHOD: Printer_groups
+    ARGUMENTS:
+        printer - a Printer object to work on
+        convertedStats - an object of convertedStats
+        groups - where sockets of online cores are saved, ascending
+        counts - where number of online cores of every socket is saved
+    PURPOSE: grouping of online cores by socket, cores of sockets 
+        past SOCKETS are put into the last group
+    RETURN: number of groups
+*/
+static uint16_t Printer_groups(
+    Printer* const printer,
+    ConvertedStats* const convertedStats,
+    uint16_t* const groups,
+    uint16_t* const counts
+) {
+    uint16_t count;
+    uint16_t group;
+    uint16_t socket;
+
+    count = 0;
+
+    for (uint16_t i = 0; i < convertedStats -> count && i < printer -> proc; i++) {
+        if (CONVERTED_IDS(convertedStats)[i + 1] == STATS_OFFLINE) { continue; }
+
+        socket = printer -> sockets[i];
+
+        for (group = 0; group < count && groups[group] < socket; group++) {}
+
+        if (group < count && groups[group] == socket) {
+            counts[group]++;
+            continue;
+        }
+
+        if (count == SOCKETS) {
+            printer -> sockets[i] = groups[SOCKETS - 1];
+            counts[SOCKETS - 1]++;
+            continue;
+        }
+
+        memmove(groups + group + 1, groups + group, (size_t) (count - group) * sizeof(uint16_t));
+        memmove(counts + group + 1, counts + group, (size_t) (count - group) * sizeof(uint16_t));
+
+        groups[group] = socket;
+        counts[group] = 1;
+        count++;
     }
 
-    printf("\n");
-    printf("================ TRACKER ================\n");
+    return count;
+}
+
+/*
+    METHOD: Printer_breakdown
+    ARGUMENTS:
+        convertedStats - an object of processed stats
+        row - row of a given stats, 0 for aggregate cpu, N + 1 for core N
+        output - where a breakdown is saved
+        size - size of a given output
+    PURPOSE: composition of a given row's percentage of every counter
+    RETURN: nothing
+*/
+static void Printer_breakdown(
+    ConvertedStats* const convertedStats,
+    size_t const row,
+    char* const output,
+    size_t const size
+) {
+    size_t length;
+    int written;
+
+    length = 0;
+    output[0] = '\0';
+
+    for (int column = 0; column < COLUMNS && length < size; column++) {
+        written = snprintf(output + length, size - length, "%s %0.1f%s", 
+            COLUMN_NAMES[column], 
+            (double) CONVERTED_COLUMN(convertedStats, column)[row],
+            column + 1 < COLUMNS ? "  " : "");
+
+        if (written < 0) { break; }
 
-    Logger_log("PRINTER", "PRINT FINISHED");
+        length += (size_t) written;
+    }
 }
 
 /*
-    METHOD: Printer_toScreen
+    METHOD: Printer_bar
     ARGUMENTS:
+        bar - where a bar of BAR cells is saved, null terminated
         percentage - a percentage value to be visualised on the screen
-    PURPOSE: visualisation of a given percentage value on the screen
+    PURPOSE: visualisation of a given percentage value as a bar, 
+        a cell for every 4 percent
     RETURN: nothing
 */
-static void Printer_toScreen(
+static void Printer_bar(
+    char* const bar,
     float const percentage
 ) {
     int progress;
 
     progress = (int)(percentage / 4.0f);
-    
-    Logger_log("PRINTER", "TOSCREEN STARTED");
-    
-    printf("[");
 
-    for(int i = 0; i < progress; i++)
-        printf("%s", "#");
+    if (progress < 0) { progress = 0; }
+    if (progress > BAR) { progress = BAR; }
+
+    memset(bar, '#', (size_t) progress);
+    memset(bar + progress, ' ', (size_t) (BAR - progress));
+    bar[BAR] = '\0';
+}
+
+/*
+    METHOD: Printer_hundredths
+    ARGUMENTS:
+        percentage - a percentage value to be printed
+    PURPOSE: rounding of a given percentage to hundredths, printed 
+        as integers since every row of every frame has one
+    RETURN: a given percentage in hundredths, 0 for negative ones
+*/
+static unsigned Printer_hundredths(
+    float const percentage
+) {
+    if (!(percentage > 0.0f)) { return 0; }
+
+    return (unsigned) (percentage * 100.0f + 0.5f);
+}
+
+/*
+    METHOD: Printer_setLayout
+    ARGUMENTS:
+        printer - a Printer object which was not started yet
+        layout - PRINTER_BARS, PRINTER_HEATMAP or PRINTER_NONE
+    PURPOSE: choice of a layout of printed frames
+    RETURN: enum integer value
+*/
+int Printer_setLayout(
+    Printer* const printer,
+    int const layout
+) {
+    if (printer == NULL || layout < PRINTER_BARS || layout > PRINTER_NONE) { return ERR_PARAMS; }
+    if (printer -> thread_started) { return ERR_RUN; }
+
+    printer -> layout = layout;
+
+    return OK;
+}
+
+/*
+    METHOD: Printer_addSink
+    ARGUMENTS:
+        printer - a Printer object which was not started yet
+        sink - an opened Sink object, closed by printer once added
+    PURPOSE: addition of a sink every printed record is emitted to,
+        next to frames, up to SINKS of them
+    RETURN: enum integer value
+*/
+int Printer_addSink(
+    Printer* const printer,
+    Sink* const sink
+) {
+    if (printer == NULL || sink == NULL || printer -> sink_count == SINKS) { return ERR_PARAMS; }
+    if (printer -> thread_started) { return ERR_RUN; }
 
-    for(int i = progress; i < 25; i++)
-        printf(" ");
+    printer -> sinks[printer -> sink_count++] = sink;
 
-    printf("] %0.2f%%", (double)percentage);
+    return OK;
+}
 
-    Logger_log("PRINTER", "TOSCREEN FINISHED");
+/*
+    METHOD: Printer_notifier
+    ARGUMENTS:
+        printer - a Printer object to work on
+    PURPOSE: access to a heartbeat notified by a given object's thread 
+        on every unit of work, to be watched by a supervisor
+    RETURN: Notifier object or NULL
+*/
+Notifier* Printer_notifier(
+    Printer* const printer
+) {
+    if (printer == NULL) { return NULL; }
+
+    return printer -> notifier;
+}
+
+/*
+    METHOD: Printer_screen
+    ARGUMENTS:
+        printer - a Printer object to work on
+    PURPOSE: access to a screen frames are rendered to, for its counters
+    RETURN: Screen object or NULL
+*/
+Screen* Printer_screen(
+    Printer* const printer
+) {
+    if (printer == NULL) { return NULL; }
+
+    return printer -> screen;
 }
 
 /*
@@ -280,14 +827,22 @@ static void Printer_toScreen(
 void Printer_destroy(
     Printer* printer
 ) {
-    Logger_log("PRINTER", "DESTROY STARTED");
+    LOG_DEBUG("PRINTER", "DESTROY STARTED");
 
     if (printer == NULL) { return; }
 
-    Watchdog_destroy(printer -> watchdog);
+    for (int i = 0; i < printer -> sink_count; i++) {
+        if (Sink_close(printer -> sinks[i]) != OK) { LOG_WARN("PRINTER", "SINK %d NOT CLOSED CLEANLY", i); }
+    }
+
     Notifier_destroy(printer -> notifier);
+    Screen_destroy(printer -> screen);
+
+    free(printer -> history);
+    free(printer -> sockets);
+    free(printer -> socket_ids);
     
     free(printer);
 
-    Logger_log("PRINTER", "DESTROY FINISHED");
+    LOG_DEBUG("PRINTER", "DESTROY FINISHED");
 }
@@ -8,85 +8,245 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/reader.h"
 #include "../inc/enums.h"
-#include "../inc/watchdog.h"
 #include "../inc/notifier.h"
 #include "../inc/logger.h"
 #include "../inc/stats.h"
+#include "../inc/scheduler.h"
+#include "../inc/status.h"
 
 // MACRO DEFINITION
-#define PATH "/proc/stat"
-
-// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
-int Reader_read(ProcessorStats* const, const uint8_t);
-static void* Reader_threadf(void* const);
+#define LINE_SIZE 256
+#define ONLINE_PATH "/sys/devices/system/cpu/online"
+#define ONLINE_SIZE 4096
+#define STALE_LIMIT 4
+#define PUBLISH_WAIT 10
+
+// STRUCTURE FOR HOLDING WHAT READS WORK ON, OWNED BY ONE THREAD GENERATION,
+// SO A REPLACED THREAD STILL STUCK IN A READ SHARES NOTHING WITH ITS SUCCESSOR
+typedef struct ReaderState {
+    char* data;
+    size_t data_size;
+    uint16_t* slots;
+    size_t slots_size;
+    bool* present;
+    int fd;
+    uint16_t mapped;
+    char padding[2];
+} ReaderState;
 
 // STRUCTURE FOR HOLDING READER OBJECT
 struct reader {
-    Watchdog* watchdog;
     Notifier* notifier;
     Buffer* buffer;
+    Scheduler* scheduler;
+    volatile sig_atomic_t* status;
+    char const* path;
+    ReaderState* state;
+    pthread_mutex_t mutex;
     pthread_t thread;
-    uint8_t proc;
-    char padding[7];
+    int mode;
+    atomic_uint generation;
+    atomic_uint stale;
+    uint16_t proc;
+    bool thread_started;
+    char padding[1];
 };
 
 // STRUCTURE FOR HOLDING PARAMS PASSED TO READER THREAD FUNCTION
 typedef struct ThreadParams {
     Reader* reader;
     volatile sig_atomic_t* status;
-    atomic_flag* status_watch;
+    ReaderState* state;
+    ProcessorStats* stats;
+    unsigned generation;
+    char padding[4];
 } ThreadParams;
 
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static ReaderState* Reader_openState(Reader* const, ReaderState* const);
+static void Reader_closeState(ReaderState* const);
+static int Reader_spawn(Reader* const);
+static void* Reader_threadf(void* const);
+static int Reader_publish(ThreadParams* const, bool* const);
+static int Reader_load(Reader* const, ReaderState* const, ProcessorStats* const);
+static int Reader_readStream(Reader* const, ReaderState* const, ProcessorStats* const);
+static int Reader_readPersistent(Reader* const, ReaderState* const, ProcessorStats* const);
+static int Reader_parse(Reader* const, ReaderState* const, size_t const, ProcessorStats* const, bool const);
+static void Reader_begin(Reader* const, ProcessorStats* const);
+static char const* Reader_store(Reader* const, ReaderState* const, char const*, char const* const, ProcessorStats* const);
+static int Reader_map(Reader* const, ReaderState* const, long const, uint16_t* const);
+static int Reader_finish(Reader* const, ReaderState* const, ProcessorStats* const);
+static int Reader_crossCheck(ReaderState* const, ProcessorStats* const, uint16_t const);
+static char const* Reader_scanName(char const*, char const* const, long* const);
+static char const* Reader_scanLine(char const*, char const* const, uint64_t* const, size_t const);
+
 /*
     METHOD: Reader_init
     ARGUMENTS:
         buffer - buffer object to work on
-        proc - number of computer's cores
+        scheduler - scheduler ticking reader's thread, 
+            may be NULL when only Reader_read is used
+        proc - number of rows given to cores, cpus beyond it are skipped
+        path - path of a stat file to be read, normally /proc/stat
+        mode - READER_STREAM or READER_PERSISTENT
     PURPOSE: creation of Reader object
     RETURN: Reader object or NULL in case creation was not possible 
 */
 Reader* Reader_init(
     Buffer* const buffer,
-    const uint8_t proc
+    Scheduler* const scheduler,
+    const uint16_t proc,
+    char const* const path,
+    int const mode
 ) {
-    Watchdog* watchdog;
-    Notifier* notifier;
     Reader* reader;
 
-    Logger_log("READER", "INIT STARTED");
+    LOG_DEBUG("READER", "INIT STARTED");
+
+    if (
+        proc <= 0 || 
+        buffer == NULL || 
+        path == NULL ||
+        (mode != READER_STREAM && mode != READER_PERSISTENT)
+    ) { return NULL; }
 
-    if (proc <= 0 || buffer == NULL) { return NULL; }
-    
     reader = (Reader*) malloc(sizeof(Reader));
-    
+
     if (reader == NULL) { return NULL; }
 
-    notifier = Notifier_init();
+    *reader = (Reader) { 
+        .notifier = NULL,
+        .buffer = buffer,
+        .scheduler = scheduler,
+        .status = NULL,
+        .path = path,
+        .state = NULL,
+        .mode = mode,
+        .generation = ATOMIC_VAR_INIT(0),
+        .stale = ATOMIC_VAR_INIT(0),
+        .proc = proc,
+        .thread_started = false
+    };
 
-    if (notifier == NULL) { return NULL; }
+    if (pthread_mutex_init(&(reader -> mutex), NULL) != 0) { goto err_mutex_init; }
 
-    watchdog = Watchdog_init(notifier, "READER");
+    reader -> state = Reader_openState(reader, NULL);
+    if (reader -> state == NULL) { goto err_state_init; }
 
-    if (watchdog == NULL) { return NULL; }
-    
+    reader -> notifier = Notifier_init();
+    if (reader -> notifier == NULL) { goto err_notifier_init; }
 
-    *reader = (Reader) { 
-        .watchdog = watchdog,
-        .notifier = notifier,
-        .buffer = buffer,
-        .proc = proc
+    LOG_DEBUG("READER", "INIT FINISHED");
+
+    return reader;
+
+    err_notifier_init:
+        Reader_closeState(reader -> state);
+    err_state_init:
+        pthread_mutex_destroy(&(reader -> mutex));
+    err_mutex_init:
+        free(reader);
+        return NULL;
+}
+
+/*
+    METHOD: Reader_openState
+    ARUGMENTS:
+        reader - reader object to work on
+        from - a state which cpu map is kept, NULL for an empty map
+    PURPOSE: creation of a state for reads, persistent mode gets
+        its own freshly opened file and read buffer
+    RETURN: ReaderState object or NULL in case creation was not possible
+*/
+static ReaderState* Reader_openState(
+    Reader* const reader,
+    ReaderState* const from
+) {
+    ReaderState* state;
+    bool mapped;
+
+    state = (ReaderState*) malloc(sizeof(ReaderState));
+
+    if (state == NULL) { return NULL; }
+
+    // IDS ARE USUALLY BELOW CORE COUNT, MAP GROWS WHEN A HIGHER ONE SHOWS UP
+    *state = (ReaderState) {
+        .data = NULL,
+        .data_size = 0,
+        .slots = NULL,
+        .slots_size = reader -> proc,
+        .present = NULL,
+        .fd = -1,
+        .mapped = 0
     };
 
-    Logger_log("READER", "INIT FINISHED");
+    if (reader -> mode == READER_PERSISTENT) {
+        state -> fd = open(reader -> path, O_RDONLY | O_CLOEXEC);
+        state -> data_size = LINE_SIZE * ((size_t) reader -> proc + 1);
+        state -> data = (char*) malloc(state -> data_size);
 
-    return reader;
+        if (state -> fd < 0 || state -> data == NULL) { goto err_state; }
+    }
+
+    // A REPLACED GENERATION MAY STILL MAP A CPU, WHICH IT DOES UNDER MUTEX
+    if (from != NULL) { 
+        pthread_mutex_lock(&(reader -> mutex)); 
+        state -> slots_size = from -> slots_size;
+    }
+
+    state -> slots = (uint16_t*) calloc(state -> slots_size, sizeof(uint16_t));
+    state -> present = (bool*) calloc((size_t) reader -> proc + 1, sizeof(bool));
+    mapped = state -> slots != NULL && state -> present != NULL;
+
+    if (from != NULL && mapped) {
+        memcpy(state -> slots, from -> slots, state -> slots_size * sizeof(uint16_t));
+        memcpy(state -> present, from -> present, ((size_t) reader -> proc + 1) * sizeof(bool));
+        state -> mapped = from -> mapped;
+    }
+
+    if (from != NULL) { pthread_mutex_unlock(&(reader -> mutex)); }
+
+    if (!mapped) { goto err_state; }
+
+    return state;
+
+    err_state:
+        Reader_closeState(state);
+        return NULL;
+}
+
+/*
+    METHOD: Reader_closeState
+    ARUGMENTS:
+        state - a state to be freed
+    PURPOSE: frees a given state and closes its file
+    RETURN: nothing
+*/
+static void Reader_closeState(
+    ReaderState* const state
+) {
+    if (state == NULL) { return; }
+    if (state -> fd >= 0) { close(state -> fd); }
+
+    free(state -> data);
+    free(state -> slots);
+    free(state -> present);
+    free(state);
 }
 
 /*
@@ -99,33 +259,126 @@ Reader* Reader_init(
 */
 int Reader_start(
     Reader* const reader,
-    volatile sig_atomic_t* status,
-    atomic_flag* status_watch
+    volatile sig_atomic_t* status
 ) {
-    ThreadParams* params;
+    int result;
 
-    Logger_log("READER", "START STARTED");
+    LOG_DEBUG("READER", "START STARTED");
 
     if (
         reader == NULL ||
+        reader -> scheduler == NULL ||
+        reader -> thread_started ||
         *status != RUNNING
     ) { return ERR_PARAMS; }
 
+    reader -> status = status;
+
+    result = Reader_spawn(reader);
+
+    if (result != OK) { return result; }
+
+    LOG_DEBUG("READER", "START FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Reader_restart
+    ARUGMENTS:
+        reader - a started reader object to work on
+    PURPOSE: replacement of a stalled reader's thread without waiting 
+        for it, the old one is detached and left with its own state, 
+        ending on its own once its read returns, and a new one reads 
+        through a fresh state, with a freshly opened file and the same 
+        cpu map, and keeps schedule, which counts ticks missed while stalled
+    RETURN: OK, ERR_TIMEOUT when too many replaced threads are still stuck,
+        in which case next call tries again
+*/
+int Reader_restart(
+    Reader* const reader
+) {
+    ReaderState* state;
+    ReaderState* old;
+    bool started;
+
+    LOG_DEBUG("READER", "RESTART STARTED");
+
+    if (reader == NULL || reader -> status == NULL) { return ERR_PARAMS; }
+
+    if (atomic_load(&(reader -> stale)) >= STALE_LIMIT) {
+        LOG_WARN("READER", "OLD THREADS STILL STUCK");
+        return ERR_TIMEOUT;
+    }
+
+    state = Reader_openState(reader, reader -> state);
+
+    if (state == NULL) { return ERR_ALLOC; }
+
+    // AN OLD THREAD CHECKS ITS GENERATION UNDER MUTEX BEFORE IT PUBLISHES OR ENDS,
+    // FROM THEN ON IT OWNS ITS STATE AND NEVER TOUCHES A BUFFER OR STATUS AGAIN
+    pthread_mutex_lock(&(reader -> mutex));
+
+    atomic_fetch_add(&(reader -> generation), 1);
+    old = reader -> state;
+    reader -> state = state;
+    started = reader -> thread_started;
+
+    if (started) {
+        atomic_fetch_add(&(reader -> stale), 1);
+        pthread_detach(reader -> thread);
+        reader -> thread_started = false;
+    }
+
+    pthread_mutex_unlock(&(reader -> mutex));
+
+    // WITH NO OLD THREAD, AFTER A FAILED SPAWN, NO ONE ELSE OWNS AN OLD STATE
+    if (!started) { Reader_closeState(old); }
+
+    if (Reader_spawn(reader) != OK) { return ERR_CREATE; }
+
+    LOG_DEBUG("READER", "RESTART FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Reader_spawn
+    ARUGMENTS:
+        reader - reader object to work on
+    PURPOSE: creation of a thread for reader's current generation and state,
+        with its own record a sample is read into before it is published
+    RETURN: enums integer value
+*/
+static int Reader_spawn(
+    Reader* const reader
+) {
+    ThreadParams* params;
+
     params = (ThreadParams*) malloc(sizeof(ThreadParams));
 
     if (params == NULL) { return ERR_ALLOC; }
 
     *params = (ThreadParams) {
         .reader = reader,
-        .status = status,
-        .status_watch = status_watch
+        .status = reader -> status,
+        .state = reader -> state,
+        .stats = (ProcessorStats*) malloc(STATS_SIZE(reader -> proc)),
+        .generation = atomic_load(&(reader -> generation))
     };
 
+    if (params -> stats == NULL) {
+        free(params);
+        return ERR_ALLOC;
+    }
+
     if (pthread_create(&(reader -> thread), NULL, Reader_threadf, (void*) params) != 0) {
+        free(params -> stats);
+        free(params);
         return ERR_CREATE;
     }
 
-    Logger_log("READER", "START FINISHED");
+    reader -> thread_started = true;
 
     return OK;
 }
@@ -134,18 +387,51 @@ int Reader_start(
     METHOD: Reader_join
     ARUGMENTS:
         reader - reader object to work on
-    PURPOSE: join of a given object's thread to its parent thread
-    RETURN: enums integer value
+        timeout - longest wait in milliseconds for replaced threads
+    PURPOSE: join of a given object's thread to its parent thread, if it 
+        has one after a failed restart, followed by a wait for every 
+        replaced thread, which uses reader until it ends
+    RETURN: enums integer value, ERR_TIMEOUT when a replaced thread 
+        is still stuck, so Reader_destroy leaves reader to it
 */
 int Reader_join(
-    Reader* const reader
+    Reader* const reader,
+    long const timeout
 ) {
-    Logger_log("READER", "JOIN STARTED");
+    struct timespec deadline;
+    unsigned stale;
+    long result;
 
-    if (reader == NULL) { return ERR_PARAMS; }
-    if (pthread_join(reader -> thread, NULL) != 0) { return ERR_JOIN; }
+    LOG_DEBUG("READER", "JOIN STARTED");
+
+    if (reader == NULL || (!reader -> thread_started && atomic_load(&(reader -> stale)) == 0)) { return ERR_PARAMS; }
+
+    if (reader -> thread_started) {
+        if (pthread_join(reader -> thread, NULL) != 0) { return ERR_JOIN; }
+
+        reader -> thread_started = false;
+    }
+
+    Status_deadline(&deadline, timeout);
+
+    while ((stale = atomic_load(&(reader -> stale))) > 0) {
+        result = syscall(
+            SYS_futex, 
+            (unsigned int*) &(reader -> stale), 
+            FUTEX_WAIT_BITSET_PRIVATE, 
+            stale, 
+            &deadline, 
+            NULL, 
+            FUTEX_BITSET_MATCH_ANY
+        );
+
+        if (result != 0 && errno == ETIMEDOUT) {
+            LOG_WARN("READER", "%u REPLACED THREADS STILL STUCK, READER IS LEFT TO THEM", stale);
+            return ERR_TIMEOUT;
+        }
+    }
 
-    Logger_log("READER", "JOIN FINISHED");
+    LOG_DEBUG("READER", "JOIN FINISHED");
 
     return OK;
 }
@@ -154,170 +440,714 @@ int Reader_join(
     METHOD: Reader_threadf
     ARUGMENTS:
         args - a pointer to function's parameters
-    PURPOSE: acomplishing reader's thread work
+    PURPOSE: acomplishing reader's thread work, until its generation
+        is replaced by a restart, ending on its own closes the pipeline
     RETURN: enums integer value
 */
 static void* Reader_threadf(
     void* const args
 ) {
     ThreadParams* params;
-    ProcessorStats stats;
+    Reader* reader;
+    bool replaced;
 
-    Logger_log("READER", "THREAD FUNCTION STARTED");
+    LOG_DEBUG("READER", "THREAD FUNCTION STARTED");
 
     params = (ThreadParams*) args;
-
-    Logger_log("READER", "STARTING WATCHDOG THREAD");
-
-    if (Watchdog_start(params -> reader -> watchdog, params -> status, params -> status_watch) != OK) {
-        Logger_log("READER", "COULD NOT START WATCHDOG THREAD");
-        free(params);
-        pthread_exit(NULL);
-    }
-
-    while (*(params -> status) == RUNNING) {
-        if (Reader_read(&stats, params -> reader -> proc) != OK) {
-            Logger_log("READER", "READ FAILED");
+    reader = params -> reader;
+    replaced = false;
+
+    // READS HAPPEN ON SCHEDULER TICKS, NOT AFTER A SLEEP FOLLOWING PREVIOUS READ
+    while (Scheduler_wait(reader -> scheduler, params -> status) == OK) {
+        // READ TAKES NO LOCK, SO A THREAD STUCK IN IT NEVER HOLDS UP ITS SUCCESSOR
+        if (Reader_load(reader, params -> state, params -> stats) != OK) {
+            LOG_ERROR("READER", "READ FAILED");
             break;
         }
-        
-        if (Buffer_push(params -> reader -> buffer, &stats) != OK) {
-            Logger_log("READER", "PUSH FAILED");
-            free(stats.cores);
+
+        if (Reader_publish(params, &replaced) != OK) {
+            LOG_ERROR("READER", "PUBLISH FAILED");
             break;
         }
 
-        if (Notifier_notify(params -> reader -> notifier) != OK) {
-            Logger_log("READER", "NOTIFY FAILED");
-            free(stats.cores);
+        if (replaced) { break; }
+
+        if (Notifier_notify(reader -> notifier) != OK) {
+            LOG_ERROR("READER", "NOTIFY FAILED");
             break;
         }
+    }
+
+    pthread_mutex_lock(&(reader -> mutex));
+
+    replaced = atomic_load(&(reader -> generation)) != params -> generation;
 
-        sleep(1);
+    if (!replaced) {
+        Buffer_close(reader -> buffer);
+        Status_set(params -> status, TERMINATED);
     }
 
-    Logger_log("READER", "JOINING WATCHDOG THREAD");
+    pthread_mutex_unlock(&(reader -> mutex));
 
-    Watchdog_join(params -> reader -> watchdog);
+    free(params -> stats);
+
+    // A REPLACED THREAD IS DETACHED, SO ITS LAST TOUCH OF READER IS A WAKE OF READER_JOIN
+    if (replaced) {
+        Reader_closeState(params -> state);
+        atomic_fetch_sub(&(reader -> stale), 1);
+        syscall(SYS_futex, (unsigned int*) &(reader -> stale), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
 
     free(params);
 
-    Logger_log("READER", "THREAD FUNCTION FINISHED");
+    LOG_DEBUG("READER", "THREAD FUNCTION FINISHED");
 
     pthread_exit(NULL);
 }
 
+/*
+    METHOD: Reader_publish
+    ARUGMENTS:
+        params - parameters of a thread which read a sample
+        replaced - set to true when a given thread's generation was replaced
+    PURPOSE: push of a thread's sample into reader's buffer, only while its 
+        generation is current, mutex is let go between short waits for 
+        a free slot, so a restart never waits long for it
+    RETURN: enums integer value
+*/
+static int Reader_publish(
+    ThreadParams* const params,
+    bool* const replaced
+) {
+    struct timespec deadline;
+    Reader* reader;
+    int result;
+
+    reader = params -> reader;
+
+    do {
+        Status_deadline(&deadline, PUBLISH_WAIT);
+
+        pthread_mutex_lock(&(reader -> mutex));
+
+        *replaced = atomic_load(&(reader -> generation)) != params -> generation;
+        result = *replaced ? OK : Buffer_pushTimed(reader -> buffer, params -> stats, &deadline);
+
+        pthread_mutex_unlock(&(reader -> mutex));
+    } while (result == ERR_TIMEOUT && *(params -> status) == RUNNING);
+
+    return result;
+}
+
+/*
+    METHOD: Reader_step
+    ARUGMENTS:
+        reader - reader object to work on
+    PURPOSE: single tick of reader's stage, reads a sample straight 
+        into reader's buffer, used by event loop mode
+    RETURN: enums integer value
+*/
+int Reader_step(
+    Reader* const reader
+) {
+    ProcessorStats* stats;
+
+    if (reader == NULL) { return ERR_PARAMS; }
+
+    if (Buffer_reserve(reader -> buffer, (void**) &stats) != OK) {
+        LOG_ERROR("READER", "RESERVE FAILED");
+        return ERR_PUSH;
+    }
+
+    if (Reader_read(reader, stats) != OK) {
+        Buffer_cancel(reader -> buffer);
+        LOG_ERROR("READER", "READ FAILED");
+        return ERR_READ;
+    }
+    
+    if (Buffer_commit(reader -> buffer) != OK) {
+        LOG_ERROR("READER", "COMMIT FAILED");
+        return ERR_PUSH;
+    }
+
+    return OK;
+}
+
 /*
     METHOD: Reader_read
     ARUGMENTS:
-        processorStats - object that data will be saved to
-        proc - computer's core count
-    PURPOSE: reads all required data from a saved file field
+        reader - reader object to work on
+        processorStats - object that data will be saved to, 
+            with room for reader's core count
+    PURPOSE: reads all required data from a saved file field, 
+        stamped with monotonic time of the read
     RETURN: enums integer value
 */
 int Reader_read(
-    ProcessorStats* const processorStats,
-    const uint8_t proc
+    Reader* const reader,
+    ProcessorStats* const processorStats
+) {
+    if (reader == NULL || processorStats == NULL) { return ERR_PARAMS; }
+
+    return Reader_load(reader, reader -> state, processorStats);
+}
+
+/*
+    METHOD: Reader_load
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state a read works on
+        processorStats - object that data will be saved to
+    PURPOSE: read of a sample through a given state, 
+        stamped with monotonic time of the read
+    RETURN: enums integer value
+*/
+static int Reader_load(
+    Reader* const reader,
+    ReaderState* const state,
+    ProcessorStats* const processorStats
+) {
+    processorStats -> timestamp = Scheduler_now();
+
+    if (reader -> mode == READER_PERSISTENT) {
+        return Reader_readPersistent(reader, state, processorStats);
+    }
+
+    return Reader_readStream(reader, state, processorStats);
+}
+
+/*
+    METHOD: Reader_readStream
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state a read works on
+        processorStats - object that data will be saved to
+    PURPOSE: reads stats by opening and scanning the file line by line on every call
+    RETURN: enums integer value
+*/
+static int Reader_readStream(
+    Reader* const reader,
+    ReaderState* const state,
+    ProcessorStats* const processorStats
 ) {
     FILE* file;
-    uint8_t coreCount;
+    char line[LINE_SIZE];
 
-    Logger_log("READER", "READ STARTED");
+    LOG_TRACE("READER", "READ STARTED");
 
-    if (processorStats == NULL || proc <= 0) { return ERR_PARAMS; }
-    
-    file = fopen(PATH, "r");
+    file = fopen(reader -> path, "r");
 
     if (file == NULL) {
         return ERR_FILE_OPEN; 
     }
 
-    Logger_log("READER", "READLINE STARTED");
-
-    if (fscanf(
-            file, 
-            "cpu %d %d %d %d %d %d %d %d %*d %*d\n",
-            &(processorStats -> cores_average.user), 
-            &(processorStats -> cores_average.nice), 
-            &(processorStats -> cores_average.system),
-            &(processorStats -> cores_average.idle), 
-            &(processorStats -> cores_average.iowait), 
-            &(processorStats -> cores_average.irq), 
-            &(processorStats -> cores_average.sortirq),
-            &(processorStats -> cores_average.steal)
-        ) != 8
-    ) {
-        Logger_log("READER", "READLINE FAILED");
-        return ERR_FILE_READ;
+    Reader_begin(reader, processorStats);
+
+    while (fgets(line, LINE_SIZE, file) != NULL) {
+        if (strncmp(line, "cpu", 3) != 0) { break; }
+
+        LOG_TRACE("READER", "READLINE STARTED");
+
+        if (Reader_store(reader, state, line, line + strlen(line), processorStats) == NULL) {
+            LOG_ERROR("READER", "READLINE FAILED");
+            fclose(file);
+            return ERR_FILE_READ;
+        }
+
+        LOG_TRACE("READER", "READLINE FINISHED");
+    }
+
+    fclose(file);
+
+    LOG_TRACE("READER", "READ FINISHED");
+
+    return Reader_finish(reader, state, processorStats); 
+}
+
+/*
+    METHOD: Reader_readPersistent
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state a read works on
+        processorStats - object that data will be saved to
+    PURPOSE: reads stats by re-reading the kept open file 
+        into a preallocated buffer and scanning it by hand,
+        buffer grows only when the cpu lines do not fit in it
+    RETURN: enums integer value
+*/
+static int Reader_readPersistent(
+    Reader* const reader,
+    ReaderState* const state,
+    ProcessorStats* const processorStats
+) {
+    ssize_t result;
+    size_t length;
+    char* data;
+    int status;
+
+    LOG_TRACE("READER", "READ STARTED");
+
+    while (true) {
+        length = 0;
+
+        while (length < state -> data_size) {
+            result = pread(
+                state -> fd, 
+                state -> data + length, 
+                state -> data_size - length, 
+                (off_t) length
+            );
+
+            if (result < 0) { return ERR_FILE_READ; }
+            if (result == 0) { break; }
+
+            length += (size_t) result;
+        }
+
+        status = Reader_parse(reader, state, length, processorStats, length < state -> data_size);
+
+        if (status == OK || length < state -> data_size) { break; }
+
+        LOG_WARN("READER", "READ BUFFER TOO SMALL, GROWING");
+
+        data = (char*) realloc(state -> data, state -> data_size * 2);
+
+        if (data == NULL) { return ERR_ALLOC; }
+
+        state -> data = data;
+        state -> data_size *= 2;
     }
 
-    Logger_log("READER", "READLINE FINISHED");
+    LOG_TRACE("READER", "READ FINISHED");
 
-    processorStats -> cores = (CoreStats*) malloc(sizeof(CoreStats) * proc);
+    return status;
+}
 
-    if (processorStats -> cores == NULL) {
-        fclose(file);
-        return ERR_ALLOC; 
+/*
+    METHOD: Reader_parse
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state holding contents of a stat file
+        length - length of a given contents
+        processorStats - object that data will be saved to
+        complete - true when a given contents is the whole file
+    PURPOSE: parses aggregate cpu line and every cpuN line,
+        stops right after the last cpu line
+    RETURN: enums integer value
+*/
+static int Reader_parse(
+    Reader* const reader,
+    ReaderState* const state,
+    size_t const length,
+    ProcessorStats* const processorStats,
+    bool const complete
+) {
+    char const* cursor;
+    char const* end;
+
+    cursor = state -> data;
+    end = state -> data + length;
+
+    Reader_begin(reader, processorStats);
+
+    while (end - cursor >= 3 && strncmp(cursor, "cpu", 3) == 0) {
+        cursor = Reader_store(reader, state, cursor, end, processorStats);
+
+        if (cursor == NULL) { return ERR_FILE_READ; }
     }
 
-    coreCount = 0;
-
-    while (coreCount < proc) {
-        Logger_log("READER", "READLINE STARTED");
-
-        if (fscanf(
-                file, 
-                "cpu%*d %d %d %d %d %d %d %d %d %*d %*d\n",
-                &(processorStats -> cores[coreCount].user), 
-                &(processorStats -> cores[coreCount].nice), 
-                &(processorStats -> cores[coreCount].system),
-                &(processorStats -> cores[coreCount].idle), 
-                &(processorStats -> cores[coreCount].iowait), 
-                &(processorStats -> cores[coreCount].irq), 
-                &(processorStats -> cores[coreCount].sortirq),
-                &(processorStats -> cores[coreCount].steal)
-            ) != 8
-        ) {
-            Logger_log("READER", "READLINE FAILED");
-            fclose(file);
-            free(processorStats -> cores);
-            return ERR_FILE_READ;
+    // CUT OFF CONTENTS MAY STILL HAVE CPU LINES AFTER ITS END
+    if (!complete && end - cursor < 3) { return ERR_FILE_READ; }
+
+    return Reader_finish(reader, state, processorStats);
+}
+
+/*
+    METHOD: Reader_begin
+    ARUGMENTS:
+        reader - reader object to work on
+        processorStats - object that data will be saved to
+    PURPOSE: marks every row of a given stats as not present,
+        until its cpu line is found
+    RETURN: nothing
+*/
+static void Reader_begin(
+    Reader* const reader,
+    ProcessorStats* const processorStats
+) {
+    uint16_t* ids;
+
+    processorStats -> count = reader -> proc;
+    ids = STATS_IDS(processorStats);
+
+    for (size_t row = 0; row <= reader -> proc; row++) { ids[row] = STATS_OFFLINE; }
+}
+
+/*
+    METHOD: Reader_store
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state a read works on
+        cursor - beginning of a cpu line
+        end - end of scanned data
+        processorStats - object that data will be saved to
+    PURPOSE: scans a single cpu line into the row its cpu id 
+        is mapped to, lines of cpus with no free row are skipped
+    RETURN: beginning of the next line or NULL when line is malformed
+*/
+static char const* Reader_store(
+    Reader* const reader,
+    ReaderState* const state,
+    char const* cursor,
+    char const* const end,
+    ProcessorStats* const processorStats
+) {
+    long id;
+    uint16_t row;
+
+    cursor = Reader_scanName(cursor, end, &id);
+
+    if (cursor == NULL) { return NULL; }
+
+    row = 0;
+
+    if (id >= 0 && Reader_map(reader, state, id, &row) != OK) {
+        LOG_WARN("READER", "NO ROW FOR CPU, LINE SKIPPED");
+
+        while (cursor < end && *cursor != '\n') { cursor++; }
+
+        return cursor == end ? NULL : cursor + 1;
+    }
+
+    STATS_IDS(processorStats)[row] = id >= 0 ? (uint16_t) id : 0;
+
+    return Reader_scanLine(cursor, end, &(processorStats -> columns[row]), STATS_STRIDE(processorStats));
+}
+
+/*
+    METHOD: Reader_map
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state which cpu map is used
+        id - cpu id found in a stat file
+        row - row a given id is mapped to
+    PURPOSE: looks up a row of a given cpu id, a cpu seen for the first 
+        time gets the next free row and keeps it while going offline 
+        and back, so other rows are never moved
+    RETURN: enums integer value
+*/
+static int Reader_map(
+    Reader* const reader,
+    ReaderState* const state,
+    long const id,
+    uint16_t* const row
+) {
+    uint16_t* slots;
+    size_t size;
+    int result;
+
+    if (id >= STATS_OFFLINE) { return ERR_PARAMS; }
+
+    // ROW 0 BELONGS TO AGGREGATE CPU, SO IT MARKS AN UNMAPPED ID
+    if ((size_t) id < state -> slots_size && state -> slots[id] != 0) {
+        *row = state -> slots[id];
+        return OK;
+    }
+
+    // A RESTART MAY BE COPYING THIS MAP INTO A NEW GENERATION'S STATE
+    pthread_mutex_lock(&(reader -> mutex));
+
+    result = OK;
+
+    if ((size_t) id >= state -> slots_size) {
+        size = state -> slots_size;
+
+        while (size <= (size_t) id) { size *= 2; }
+
+        slots = (uint16_t*) realloc(state -> slots, size * sizeof(uint16_t));
+
+        if (slots == NULL) { 
+            result = ERR_ALLOC; 
+        } else {
+            memset(slots + state -> slots_size, 0, (size - state -> slots_size) * sizeof(uint16_t));
+
+            state -> slots = slots;
+            state -> slots_size = size;
+        }
+    }
+
+    if (result == OK && state -> mapped == reader -> proc) { result = ERR_PARAMS; }
+
+    if (result == OK) {
+        LOG_DEBUG("READER", "NEW CPU MAPPED");
+
+        state -> slots[id] = ++(state -> mapped);
+        *row = state -> slots[id];
+    }
+
+    pthread_mutex_unlock(&(reader -> mutex));
+
+    return result;
+}
+
+/*
+    METHOD: Reader_finish
+    ARUGMENTS:
+        reader - reader object to work on
+        state - a state which set of present cpus is updated
+        processorStats - object that data was saved to
+    PURPOSE: zeroes rows of cpus missing from a sample and, when 
+        the set of present cpus changed, checks it against sysfs
+    RETURN: enums integer value
+*/
+static int Reader_finish(
+    Reader* const reader,
+    ReaderState* const state,
+    ProcessorStats* const processorStats
+) {
+    uint16_t const* ids;
+    size_t stride;
+    uint16_t online;
+    bool changed;
+    bool present;
+    int status;
+
+    ids = STATS_IDS(processorStats);
+    stride = STATS_STRIDE(processorStats);
+
+    if (ids[0] == STATS_OFFLINE) { return ERR_FILE_READ; }
+
+    online = 0;
+    changed = false;
+
+    for (uint16_t row = 1; row <= reader -> proc; row++) {
+        present = ids[row] != STATS_OFFLINE;
+
+        if (present) {
+            online++;
+        } else {
+            for (int column = 0; column < COLUMNS; column++) {
+                processorStats -> columns[(size_t) column * stride + row] = 0;
+            }
+        }
+
+        if (present != state -> present[row]) { changed = true; }
+    }
+
+    if (changed) {
+        LOG_INFO("READER", "SET OF CPUS CHANGED");
+
+        // A RESTART MAY BE COPYING THIS SET INTO A NEW GENERATION'S STATE
+        pthread_mutex_lock(&(reader -> mutex));
+
+        for (uint16_t row = 1; row <= reader -> proc; row++) { 
+            state -> present[row] = ids[row] != STATS_OFFLINE; 
         }
 
-        coreCount++;
+        pthread_mutex_unlock(&(reader -> mutex));
+
+        status = Reader_crossCheck(state, processorStats, online);
 
-        Logger_log("READER", "READLINE FINISHED");
+        if (status == ERR_FILE_OPEN) { 
+            LOG_WARN("READER", "ONLINE LIST UNAVAILABLE"); 
+        } else if (status == OK) {
+            LOG_DEBUG("READER", "ONLINE CROSS-CHECK PASSED");
+        } else {
+            LOG_WARN("READER", "ONLINE CROSS-CHECK FAILED");
+        }
     }
 
+    return OK;
+}
+
+/*
+    METHOD: Reader_crossCheck
+    ARUGMENTS:
+        state - a state which cpu map is checked
+        processorStats - object that data was saved to
+        online - number of cpus present in a given stats
+    PURPOSE: checks that cpus listed as online by sysfs, 
+        like 0-3,6,8-9, are exactly cpus present in a given stats
+    RETURN: OK, ERR_FILE_OPEN when list could not be read 
+        or ERR_FILE_READ when it does not match
+*/
+static int Reader_crossCheck(
+    ReaderState* const state,
+    ProcessorStats* const processorStats,
+    uint16_t const online
+) {
+    FILE* file;
+    char list[ONLINE_SIZE];
+    char* cursor;
+    uint16_t const* ids;
+    unsigned long first;
+    unsigned long last;
+    size_t listed;
+
+    file = fopen(ONLINE_PATH, "r");
+
+    if (file == NULL) { return ERR_FILE_OPEN; }
+
+    cursor = fgets(list, ONLINE_SIZE, file);
+
     fclose(file);
 
-    processorStats -> count = coreCount;
+    if (cursor == NULL) { return ERR_FILE_OPEN; }
+
+    ids = STATS_IDS(processorStats);
+    listed = 0;
 
-    Logger_log("READER", "READ FINISHED");
+    while (*cursor >= '0' && *cursor <= '9') {
+        first = strtoul(cursor, &cursor, 10);
+        last = *cursor == '-' ? strtoul(cursor + 1, &cursor, 10) : first;
 
-    return OK; 
+        for (unsigned long id = first; id <= last; id++, listed++) {
+            if (
+                id >= state -> slots_size || 
+                state -> slots[id] == 0 || 
+                ids[state -> slots[id]] != id
+            ) { return ERR_FILE_READ; }
+        }
+
+        if (*cursor == ',') { cursor++; }
+    }
+
+    if (*cursor != '\n' && *cursor != '\0') { return ERR_FILE_READ; }
+
+    return listed == online ? OK : ERR_FILE_READ;
+}
+
+/*
+    METHOD: Reader_scanName
+    ARUGMENTS:
+        cursor - beginning of a line to be scanned
+        end - end of scanned data
+        id - cpu id of a given line, -1 for aggregate cpu line
+    PURPOSE: scans name of a single cpu line
+    RETURN: end of a name or NULL when line is malformed
+*/
+static char const* Reader_scanName(
+    char const* cursor,
+    char const* const end,
+    long* const id
+) {
+    if (
+        end - cursor < 4 || 
+        cursor[0] != 'c' || 
+        cursor[1] != 'p' || 
+        cursor[2] != 'u'
+    ) { return NULL; }
+
+    cursor += 3;
+    *id = -1;
+
+    if (*cursor >= '0' && *cursor <= '9') {
+        *id = 0;
+
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            if (*id < STATS_OFFLINE) { *id = *id * 10 + (*cursor - '0'); }
+            cursor++;
+        }
+    }
+
+    if (cursor == end || *cursor != ' ') { return NULL; }
+
+    return cursor;
+}
+
+/*
+    METHOD: Reader_scanLine
+    ARUGMENTS:
+        cursor - end of a name of a line to be scanned
+        end - end of scanned data
+        row - first column's cell that counters will be saved to
+        stride - distance between columns
+    PURPOSE: scans counters of a single cpu line, counters missing 
+        on older kernels are set to zero
+    RETURN: beginning of the next line or NULL when line is malformed
+*/
+static char const* Reader_scanLine(
+    char const* cursor,
+    char const* const end,
+    uint64_t* const row,
+    size_t const stride
+) {
+    uint64_t value;
+    int column;
+
+    for (column = 0; column < COLUMNS; column++) {
+        while (cursor < end && *cursor == ' ') { cursor++; }
+
+        if (cursor == end) { return NULL; }
+        if (*cursor == '\n') { break; }
+        if (*cursor < '0' || *cursor > '9') { return NULL; }
+
+        value = 0;
+
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+            value = value * 10 + (uint64_t) (*cursor - '0');
+            cursor++;
+        }
+
+        row[(size_t) column * stride] = value;
+    }
+
+    for (; column < COLUMNS; column++) { row[(size_t) column * stride] = 0; }
+
+    while (cursor < end && *cursor != '\n') { cursor++; }
+
+    if (cursor == end) { return NULL; }
+
+    return cursor + 1;
+}
+
+/*
+    METHOD: Reader_notifier
+    ARGUMENTS:
+        reader - a Reader object to work on
+    PURPOSE: access to a heartbeat notified by a given object's thread 
+        on every unit of work, to be watched by a supervisor
+    RETURN: Notifier object or NULL
+*/
+Notifier* Reader_notifier(
+    Reader* const reader
+) {
+    if (reader == NULL) { return NULL; }
+
+    return reader -> notifier;
 }
 
 /*
     METHOD: Reader_destroy
     ARGUMENTS:
         reader - a Reader object to be freed
-    PURPOSE: frees reserved memory for a given Reader 'object' and its nested 'objects'
+    PURPOSE: frees reserved memory for a given Reader 'object' and its nested 'objects',
+        a reader still used by a replaced thread stuck past Reader_join's 
+        timeout is leaked on purpose, as that thread locks its mutex 
+        and wakes its stale counter once its read returns
     RETURN: Reader 'object' or NULL in 
         case creation was not possible 
 */
 void Reader_destroy(
     Reader* const reader
 ) {
-    Logger_log("READER", "DESTROY STARTED");
+    LOG_DEBUG("READER", "DESTROY STARTED");
 
     if (reader == NULL) { return; }
 
-    Watchdog_destroy(reader -> watchdog);
+    // REPLACED THREADS NEVER TOUCH NOTIFIER OR CURRENT STATE, ONLY READER ITSELF
     Notifier_destroy(reader -> notifier);
+    Reader_closeState(reader -> state);
+
+    if (atomic_load(&(reader -> stale)) > 0) {
+        LOG_WARN("READER", "LEAKED TO REPLACED THREADS STILL STUCK");
+        return;
+    }
+
+    pthread_mutex_destroy(&(reader -> mutex));
     reader -> proc = 0;
 
     free(reader);
 
-    Logger_log("READER", "DESTROY FINISHED");
+    LOG_DEBUG("READER", "DESTROY FINISHED");
 }
@@ -0,0 +1,224 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scheduler.c                       
+    PURPOSE: implementation of scheduler module, ticks at absolute 
+        CLOCK_MONOTONIC deadlines so work time never shifts the period,
+        ticks which could not be kept are counted and skipped
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/enums.h"
+#include "../inc/status.h"
+#include "../inc/scheduler.h"
+
+// MACRO DEFINITION
+#define NANOSECONDS 1000000000u
+
+// STRUCTURE FOR HOLDING SCHEDULER OBJECT
+struct scheduler {
+    uint64_t interval;
+    uint64_t next;
+    atomic_uint_fast64_t missed;
+    int fd;
+    char padding[4];
+};
+
+/*
+    METHOD: Scheduler_init
+    ARGUMENTS:
+        interval - period of ticks in milliseconds, between 
+            SCHEDULER_MIN_INTERVAL and SCHEDULER_MAX_INTERVAL
+    PURPOSE: creation of Scheduler object, its first tick is immediate
+    RETURN: Scheduler object or NULL in case creation was not possible 
+*/
+Scheduler* Scheduler_init(
+    long const interval
+) {
+    Scheduler* scheduler;
+
+    if (interval < SCHEDULER_MIN_INTERVAL || interval > SCHEDULER_MAX_INTERVAL) { return NULL; }
+
+    scheduler = (Scheduler*) malloc(sizeof(Scheduler));
+
+    if (scheduler == NULL) { return NULL; }
+
+    *scheduler = (Scheduler) {
+        .interval = (uint64_t) interval * 1000000u,
+        .next = 0,
+        .missed = 0,
+        .fd = -1
+    };
+
+    return scheduler;
+}
+
+/*
+    METHOD: Scheduler_wait
+    ARGUMENTS:
+        scheduler - an object which tick will be waited for
+        status - a status variable which change cuts the wait short
+    PURPOSE: sleep until the next tick, when whole periods already 
+        passed since it, they are counted as missed and skipped 
+        instead of being fired one after another
+    RETURN: OK on tick or ERR_CLOSED when status changed
+*/
+int Scheduler_wait(
+    Scheduler* const scheduler,
+    volatile sig_atomic_t* const status
+) {
+    struct timespec deadline;
+    uint64_t now;
+    uint64_t missed;
+
+    if (scheduler == NULL || status == NULL) { return ERR_PARAMS; }
+
+    now = Scheduler_now();
+
+    if (scheduler -> next == 0) {
+        scheduler -> next = now;
+        return *status == RUNNING ? OK : ERR_CLOSED;
+    }
+
+    scheduler -> next += scheduler -> interval;
+
+    if (now >= scheduler -> next + scheduler -> interval) {
+        missed = (now - scheduler -> next) / scheduler -> interval;
+
+        scheduler -> next += missed * scheduler -> interval;
+        atomic_fetch_add_explicit(&(scheduler -> missed), missed, memory_order_relaxed);
+    }
+
+    deadline = (struct timespec) {
+        .tv_sec = (time_t) (scheduler -> next / NANOSECONDS),
+        .tv_nsec = (long) (scheduler -> next % NANOSECONDS)
+    };
+
+    return Status_sleepUntil(status, &deadline);
+}
+
+/*
+    METHOD: Scheduler_arm
+    ARGUMENTS:
+        scheduler - an object which ticks will be delivered by a timerfd
+    PURPOSE: creation of a non blocking timerfd expiring at absolute 
+        CLOCK_MONOTONIC deadlines of a given scheduler, first one being 
+        immediate, for callers waiting on many descriptors at once
+    RETURN: descriptor readable on every tick or -1 when it could not be created
+*/
+int Scheduler_arm(
+    Scheduler* const scheduler
+) {
+    struct itimerspec timer;
+    uint64_t now;
+
+    if (scheduler == NULL || scheduler -> fd >= 0) { return -1; }
+
+    scheduler -> fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if (scheduler -> fd < 0) { return -1; }
+
+    now = Scheduler_now();
+
+    timer = (struct itimerspec) {
+        .it_value = {
+            .tv_sec = (time_t) (now / NANOSECONDS),
+            .tv_nsec = (long) (now % NANOSECONDS)
+        },
+        .it_interval = {
+            .tv_sec = (time_t) (scheduler -> interval / NANOSECONDS),
+            .tv_nsec = (long) (scheduler -> interval % NANOSECONDS)
+        }
+    };
+
+    if (timerfd_settime(scheduler -> fd, TFD_TIMER_ABSTIME, &timer, NULL) != 0) {
+        close(scheduler -> fd);
+        scheduler -> fd = -1;
+        return -1;
+    }
+
+    return scheduler -> fd;
+}
+
+/*
+    METHOD: Scheduler_expire
+    ARGUMENTS:
+        scheduler - an object which timerfd became readable
+    PURPOSE: consumption of a tick of an armed scheduler, expirations 
+        beyond the first one were not kept and are counted as missed
+    RETURN: OK on tick, ERR_TIMEOUT when no tick is due 
+        or ERR_READ when timerfd could not be read
+*/
+int Scheduler_expire(
+    Scheduler* const scheduler
+) {
+    uint64_t expirations;
+
+    if (scheduler == NULL || scheduler -> fd < 0) { return ERR_PARAMS; }
+
+    if (read(scheduler -> fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return errno == EAGAIN ? ERR_TIMEOUT : ERR_READ;
+    }
+
+    if (expirations > 1) {
+        atomic_fetch_add_explicit(&(scheduler -> missed), expirations - 1, memory_order_relaxed);
+    }
+
+    return OK;
+}
+
+/*
+    METHOD: Scheduler_missed
+    ARGUMENTS:
+        scheduler - an object which missed ticks will be read
+    PURPOSE: read of a number of ticks skipped so far
+    RETURN: number of missed ticks
+*/
+uint64_t Scheduler_missed(
+    Scheduler* const scheduler
+) {
+    if (scheduler == NULL) { return 0; }
+
+    return atomic_load_explicit(&(scheduler -> missed), memory_order_relaxed);
+}
+
+/*
+    METHOD: Scheduler_now
+    ARGUMENTS: none
+    PURPOSE: read of monotonic clock, the one ticks are scheduled on
+    RETURN: current monotonic time in nanoseconds
+*/
+uint64_t Scheduler_now(
+    void
+) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * NANOSECONDS + (uint64_t) now.tv_nsec;
+}
+
+/*
+    METHOD: Scheduler_destroy
+    ARGUMENTS:
+        scheduler - an object to be freed
+    PURPOSE: free of a given object's memory
+    RETURN: nothing
+*/
+void Scheduler_destroy(
+    Scheduler* scheduler
+) {
+    if (scheduler == NULL) { return; }
+
+    if (scheduler -> fd >= 0) { close(scheduler -> fd); }
+
+    free(scheduler);
+}
@@ -0,0 +1,613 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: screen.c                       
+    PURPOSE: implementation of screen module, a terminal frame 
+        composed in memory and sent as a difference to the frame
+        shown before, with a single write
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/screen.h"
+#include "../inc/enums.h"
+#include "../inc/format.h"
+
+// MACRO DEFINITION
+#define CLEAR "\033[H\033[2J"
+#define DEFAULT_COLOR "\033[39m"
+#define ESCAPE_SIZE 16
+#define CELL_SIZE 14
+#define GAP 6
+#define BLANK ((ScreenCell) ' ')
+
+// STRUCTURE FOR HOLDING SCREEN OBJECT, FRAME IS BEING COMPOSED,
+// SHOWN IS WHAT TERMINAL DISPLAYS, BOTH ROWS TIMES COLS CELLS
+struct screen {
+    ScreenCell* frame;
+    ScreenCell* shown;
+    char* line;
+    char* output;
+    uint64_t frames;
+    uint64_t bytes;
+    size_t last;
+    int fd;
+    uint16_t rows;
+    uint16_t cols;
+    bool valid;
+    char padding[7];
+};
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static int Screen_allocate(Screen* const, uint16_t const, uint16_t const);
+static void Screen_terminal(Screen* const, uint16_t* const, uint16_t* const);
+static size_t Screen_next(ScreenCell const* const, ScreenCell const* const, size_t const, size_t const);
+static size_t Screen_run(char* const, ScreenCell const* const, size_t const, uint8_t* const);
+static size_t Screen_move(char* const, uint16_t const, uint16_t const);
+static int Screen_write(Screen* const, size_t const);
+
+/*
+    METHOD: Screen_init
+    ARGUMENTS:
+        rows - number of rows of a frame
+        cols - number of columns of a frame
+        fd - descriptor of a terminal frames are written to
+    PURPOSE: creation of Screen object, with every buffer
+        a frame needs allocated up front
+    RETURN: Screen object or NULL in
+        case creation was not possible
+*/
+Screen* Screen_init(
+    uint16_t const rows,
+    uint16_t const cols,
+    int const fd
+) {
+    Screen* screen;
+
+    if (rows == 0 || cols == 0 || fd < 0) { return NULL; }
+
+    screen = (Screen*) calloc(1, sizeof(Screen));
+
+    if (screen == NULL) { return NULL; }
+
+    screen -> fd = fd;
+
+    if (Screen_allocate(screen, rows, cols) != OK) {
+        free(screen);
+        return NULL;
+    }
+
+    return screen;
+}
+
+/*
+    METHOD: Screen_allocate
+    ARGUMENTS:
+        screen - a Screen object to work on
+        rows - number of rows of a frame
+        cols - number of columns of a frame
+    PURPOSE: allocation of every buffer of a frame of a given size,
+        old ones are kept when it fails, next frame is sent whole
+    RETURN: enums integer value
+*/
+static int Screen_allocate(
+    Screen* const screen,
+    uint16_t const rows,
+    uint16_t const cols
+) {
+    ScreenCell* frame;
+    ScreenCell* shown;
+    char* line;
+    char* output;
+    size_t cells;
+
+    cells = (size_t) rows * cols;
+
+    // WORST FRAME MOVES CURSOR BEFORE EVERY RUN OF CELLS, AT MOST ONE RUN PER GAP,
+    // AND CHANGES COLOR BEFORE EVERY CELL
+    frame = (ScreenCell*) malloc(cells * sizeof(ScreenCell));
+    shown = (ScreenCell*) malloc(cells * sizeof(ScreenCell));
+    line = (char*) malloc((size_t) cols + 1);
+    output = (char*) malloc(sizeof(CLEAR) + sizeof(DEFAULT_COLOR) + cells * CELL_SIZE + (cells / GAP + rows + 1) * ESCAPE_SIZE);
+
+    if (frame == NULL || shown == NULL || line == NULL || output == NULL) {
+        free(frame);
+        free(shown);
+        free(line);
+        free(output);
+        return ERR_ALLOC;
+    }
+
+    free(screen -> frame);
+    free(screen -> shown);
+    free(screen -> line);
+    free(screen -> output);
+
+    screen -> frame = frame;
+    screen -> shown = shown;
+    screen -> line = line;
+    screen -> output = output;
+    screen -> rows = rows;
+    screen -> cols = cols;
+    screen -> valid = false;
+
+    Screen_clear(screen);
+
+    return OK;
+}
+
+/*
+    METHOD: Screen_fit
+    ARGUMENTS:
+        screen - a Screen object to work on
+    PURPOSE: resizing of a frame to the size of a terminal, 
+        read with TIOCGWINSZ, or from LINES and COLUMNS when 
+        output is not a terminal, a frame of another size is 
+        started blank and sent whole
+    RETURN: enums integer value
+*/
+int Screen_fit(
+    Screen* const screen
+) {
+    uint16_t rows;
+    uint16_t cols;
+
+    if (screen == NULL) { return ERR_PARAMS; }
+
+    rows = screen -> rows;
+    cols = screen -> cols;
+
+    Screen_terminal(screen, &rows, &cols);
+
+    if (rows == screen -> rows && cols == screen -> cols) { return OK; }
+
+    return Screen_allocate(screen, rows, cols);
+}
+
+/*
+    METHOD: Screen_terminal
+    ARGUMENTS:
+        screen - a Screen object to work on
+        rows - where number of rows is saved, kept when unknown
+        cols - where number of columns is saved, kept when unknown
+    PURPOSE: reading of a size of a terminal a given screen writes to
+    RETURN: nothing
+*/
+static void Screen_terminal(
+    Screen* const screen,
+    uint16_t* const rows,
+    uint16_t* const cols
+) {
+    struct winsize size;
+    char const* variable;
+    long value;
+
+    if (ioctl(screen -> fd, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+        *rows = size.ws_row;
+        *cols = size.ws_col;
+        return;
+    }
+
+    variable = getenv("LINES");
+    value = variable == NULL ? 0 : strtol(variable, NULL, 10);
+    if (value > 0 && value <= UINT16_MAX) { *rows = (uint16_t) value; }
+
+    variable = getenv("COLUMNS");
+    value = variable == NULL ? 0 : strtol(variable, NULL, 10);
+    if (value > 0 && value <= UINT16_MAX) { *cols = (uint16_t) value; }
+}
+
+/*
+    METHOD: Screen_size
+    ARGUMENTS:
+        screen - a Screen object to work on
+        rows - where number of rows is saved
+        cols - where number of columns is saved
+    PURPOSE: read of a size of a frame
+    RETURN: nothing
+*/
+void Screen_size(
+    Screen* const screen,
+    uint16_t* const rows,
+    uint16_t* const cols
+) {
+    if (screen == NULL || rows == NULL || cols == NULL) { return; }
+
+    *rows = screen -> rows;
+    *cols = screen -> cols;
+}
+
+/*
+    METHOD: Screen_clear
+    ARGUMENTS:
+        screen - a Screen object to work on
+    PURPOSE: start of a new frame with every cell blank
+    RETURN: nothing
+*/
+void Screen_clear(
+    Screen* const screen
+) {
+    size_t const cells = screen == NULL ? 0 : (size_t) screen -> rows * screen -> cols;
+
+    for (size_t i = 0; i < cells; i++) { screen -> frame[i] = BLANK; }
+}
+
+/*
+    METHOD: Screen_line
+    ARGUMENTS:
+        screen - a Screen object to work on
+        row - row of a frame to be set
+        format - printf format of a given row, followed by its arguments
+    PURPOSE: setting of a row of a frame to ascii text of default 
+        color, cut at frame's width, cells after it are left as they are
+    RETURN: enums integer value
+*/
+int Screen_line(
+    Screen* const screen,
+    uint16_t const row,
+    char const* const format,
+    ...
+) {
+    ScreenCell* cells;
+    va_list args;
+    int written;
+    size_t length;
+
+    if (screen == NULL || format == NULL || row >= screen -> rows) { return ERR_PARAMS; }
+
+    va_start(args, format);
+    written = vsnprintf(screen -> line, (size_t) screen -> cols + 1, format, args);
+    va_end(args);
+
+    if (written < 0) { return ERR_PARAMS; }
+
+    length = (size_t) written < screen -> cols ? (size_t) written : screen -> cols;
+    cells = screen -> frame + (size_t) row * screen -> cols;
+
+    for (size_t i = 0; i < length; i++) { cells[i] = (ScreenCell) (unsigned char) screen -> line[i]; }
+
+    return OK;
+}
+
+/*
+    METHOD: Screen_glyph
+    ARGUMENTS:
+        glyph - a single utf-8 character, at most 3 bytes long
+        color - index of 256 color palette, 0 for default color
+    PURPOSE: encoding of a cell, done once for cells set often
+    RETURN: an encoded cell, blank one for a glyph too long
+*/
+ScreenCell Screen_glyph(
+    char const* const glyph,
+    uint8_t const color
+) {
+    ScreenCell cell;
+    size_t length;
+
+    if (glyph == NULL || (length = strlen(glyph)) == 0 || length > 3) { return BLANK; }
+
+    cell = (ScreenCell) color << 24;
+
+    for (size_t i = 0; i < length; i++) { cell |= (ScreenCell) (unsigned char) glyph[i] << (8 * i); }
+
+    return cell;
+}
+
+/*
+    METHOD: Screen_cell
+    ARGUMENTS:
+        screen - a Screen object to work on
+        row - row of a cell
+        col - column of a cell
+        cell - a cell encoded by Screen_glyph
+    PURPOSE: setting of a single cell of a frame
+    RETURN: enums integer value
+*/
+int Screen_cell(
+    Screen* const screen,
+    uint16_t const row,
+    uint16_t const col,
+    ScreenCell const cell
+) {
+    if (screen == NULL || row >= screen -> rows || col >= screen -> cols) { return ERR_PARAMS; }
+
+    screen -> frame[(size_t) row * screen -> cols + col] = cell;
+
+    return OK;
+}
+
+/*
+    METHOD: Screen_render
+    ARGUMENTS:
+        screen - a Screen object to work on
+    PURPOSE: sending of cells which differ from shown frame, each run
+        of them after a cursor move, runs apart by only a few cells
+        are joined as resending those is shorter than another move,
+        a whole frame is written with a single write,
+        nothing at all when no cell changed
+    RETURN: enums integer value, ERR_RUN when terminal
+        could not be written, in which case next frame is sent whole
+*/
+int Screen_render(
+    Screen* const screen
+) {
+    ScreenCell const* frame;
+    ScreenCell const* shown;
+    size_t length;
+    size_t start;
+    size_t end;
+    size_t next;
+    uint8_t color;
+
+    if (screen == NULL) { return ERR_PARAMS; }
+
+    length = 0;
+    color = 0;
+
+    // TERMINAL IS CLEARED FIRST, SO BLANK CELLS OF A WHOLE FRAME NEED NOT BE SENT
+    if (!screen -> valid) {
+        memcpy(screen -> output, CLEAR, sizeof(CLEAR) - 1);
+        length = sizeof(CLEAR) - 1;
+
+        for (size_t i = 0; i < (size_t) screen -> rows * screen -> cols; i++) { screen -> shown[i] = BLANK; }
+    }
+
+    for (uint16_t row = 0; row < screen -> rows; row++) {
+        frame = screen -> frame + (size_t) row * screen -> cols;
+        shown = screen -> shown + (size_t) row * screen -> cols;
+
+        next = Screen_next(frame, shown, 0, screen -> cols);
+
+        while (next < screen -> cols) {
+            start = next;
+            end = next;
+
+            while ((next = Screen_next(frame, shown, end + 1, screen -> cols)) < screen -> cols && next - end <= GAP) {
+                end = next;
+            }
+
+            length += Screen_move(screen -> output + length, row, (uint16_t) start);
+            length += Screen_run(screen -> output + length, frame + start, end - start + 1, &color);
+        }
+    }
+
+    if (length == 0) {
+        screen -> frames++;
+        screen -> last = 0;
+        return OK;
+    }
+
+    // COLOR IS RESET, SO ANYTHING ELSE PRINTED AND NEXT FRAME START FROM DEFAULT ONE
+    if (color != 0) {
+        memcpy(screen -> output + length, DEFAULT_COLOR, sizeof(DEFAULT_COLOR) - 1);
+        length += sizeof(DEFAULT_COLOR) - 1;
+    }
+
+    // CURSOR IS LEFT BELOW A FRAME, WHERE ANYTHING ELSE PRINTED DOES NOT COVER IT
+    length += Screen_move(screen -> output + length, screen -> rows, 0);
+
+    return Screen_write(screen, length);
+}
+
+/*
+    METHOD: Screen_next
+    ARGUMENTS:
+        frame - a row of a composed frame
+        shown - the same row of shown frame
+        from - first column to be compared
+        to - number of columns of a row
+    PURPOSE: search of the next changed cell, equal cells 
+        are skipped four at a time
+    RETURN: column of the next changed cell, to when there is none
+*/
+static size_t Screen_next(
+    ScreenCell const* const frame,
+    ScreenCell const* const shown,
+    size_t const from,
+    size_t const to
+) {
+    uint64_t composed[2];
+    uint64_t displayed[2];
+    size_t col;
+
+    col = from;
+
+    while (col + 4 <= to) {
+        memcpy(composed, frame + col, sizeof(composed));
+        memcpy(displayed, shown + col, sizeof(displayed));
+
+        if (((composed[0] ^ displayed[0]) | (composed[1] ^ displayed[1])) != 0) { break; }
+
+        col += 4;
+    }
+
+    while (col < to && frame[col] == shown[col]) { col++; }
+
+    return col;
+}
+
+/*
+    METHOD: Screen_run
+    ARGUMENTS:
+        output - where a run is saved
+        cells - first cell of a run
+        count - number of cells of a run
+        color - color terminal currently writes with, 
+            updated by color changes of a run
+    PURPOSE: composition of glyphs of a run of cells,
+        a color escape is put only where color changes
+    RETURN: length of a composed run
+*/
+static size_t Screen_run(
+    char* const output,
+    ScreenCell const* const cells,
+    size_t const count,
+    uint8_t* const color
+) {
+    ScreenCell cell;
+    size_t length;
+    uint8_t next;
+
+    length = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        cell = cells[i];
+        next = (uint8_t) (cell >> 24);
+
+        if (next != *color) {
+            if (next == 0) {
+                memcpy(output + length, DEFAULT_COLOR, sizeof(DEFAULT_COLOR) - 1);
+                length += sizeof(DEFAULT_COLOR) - 1;
+            } else {
+                memcpy(output + length, "\033[38;5;", 7);
+                length += 7;
+                length += Format_unsigned(output + length, next);
+                output[length++] = 'm';
+            }
+
+            *color = next;
+        }
+
+        output[length++] = (char) (cell & 0xFF);
+
+        if ((cell >> 8) & 0xFF) { output[length++] = (char) ((cell >> 8) & 0xFF); }
+        if ((cell >> 16) & 0xFF) { output[length++] = (char) ((cell >> 16) & 0xFF); }
+    }
+
+    return length;
+}
+
+/*
+    METHOD: Screen_write
+    ARGUMENTS:
+        screen - a Screen object to work on
+        length - number of bytes of output to be written
+    PURPOSE: writing of a rendered difference, repeated only for what
+        a short write left out, frame becomes shown once written
+    RETURN: enums integer value
+*/
+static int Screen_write(
+    Screen* const screen,
+    size_t const length
+) {
+    ssize_t written;
+    size_t done;
+
+    done = 0;
+
+    while (done < length) {
+        written = write(screen -> fd, screen -> output + done, length - done);
+
+        if (written < 0 && errno == EINTR) { continue; }
+
+        if (written <= 0) {
+            screen -> valid = false;
+            return ERR_RUN;
+        }
+
+        done += (size_t) written;
+    }
+
+    memcpy(screen -> shown, screen -> frame, (size_t) screen -> rows * screen -> cols * sizeof(ScreenCell));
+
+    screen -> valid = true;
+    screen -> frames++;
+    screen -> bytes += length;
+    screen -> last = length;
+
+    return OK;
+}
+
+/*
+    METHOD: Screen_move
+    ARGUMENTS:
+        output - where an escape is saved
+        row - zero based row the cursor is moved to
+        col - zero based column the cursor is moved to
+    PURPOSE: composition of cursor addressing escape
+    RETURN: length of a composed escape
+*/
+static size_t Screen_move(
+    char* const output,
+    uint16_t const row,
+    uint16_t const col
+) {
+    size_t length;
+
+    output[0] = '\033';
+    output[1] = '[';
+    length = 2;
+
+    length += Format_unsigned(output + length, (unsigned) row + 1);
+    output[length++] = ';';
+    length += Format_unsigned(output + length, (unsigned) col + 1);
+    output[length++] = 'H';
+
+    return length;
+}
+
+/*
+    METHOD: Screen_invalidate
+    ARGUMENTS:
+        screen - a Screen object to work on
+    PURPOSE: forgetting of what terminal shows, so next frame is
+        sent whole, after anything else was written to it
+    RETURN: nothing
+*/
+void Screen_invalidate(
+    Screen* const screen
+) {
+    if (screen == NULL) { return; }
+
+    screen -> valid = false;
+}
+
+/*
+    METHOD: Screen_stats
+    ARGUMENTS:
+        screen - a Screen object to work on
+        stats - an object where counters will be saved
+    PURPOSE: read of rendered frames and bytes sent
+    RETURN: enums integer value
+*/
+int Screen_stats(
+    Screen* const screen,
+    ScreenStats* const stats
+) {
+    if (screen == NULL || stats == NULL) { return ERR_PARAMS; }
+
+    *stats = (ScreenStats) {
+        .frames = screen -> frames,
+        .bytes = screen -> bytes,
+        .last = screen -> last
+    };
+
+    return OK;
+}
+
+/*
+    METHOD: Screen_destroy
+    ARGUMENTS:
+        screen - a Screen object to be freed
+    PURPOSE: free of memory taken by a given Screen object
+    RETURN: nothing
+*/
+void Screen_destroy(
+    Screen* const screen
+) {
+    if (screen == NULL) { return; }
+
+    free(screen -> frame);
+    free(screen -> shown);
+    free(screen -> line);
+    free(screen -> output);
+    free(screen);
+}
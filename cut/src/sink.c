@@ -0,0 +1,488 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink.c                       
+    PURPOSE: implementation of sink module, records of converted
+        stats encoded as JSON Lines, CSV or fixed binary rows into
+        a buffer allocated up front, written when it fills or is flushed
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/sink.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+#include "../inc/format.h"
+
+// MACRO DEFINITION
+#define SINK_BUFFER (64u << 10)
+#define JSON_RECORD_SIZE 64
+#define JSON_ROW_SIZE 288
+#define CSV_ROW_SIZE 160
+#define CSV_HEAD "timestamp,cpu,usage,user,nice,system,idle,iowait,irq,softirq,steal,guest,guest_nice\n"
+
+// KEY OF JSON SINK WITH A SEPARATOR BEFORE IT, AND ITS LENGTH
+#define JSON_KEY(name) { ",\"" name "\":", sizeof(",\"" name "\":") - 1 }
+
+// STRUCTURE FOR HOLDING AN ENCODER, HEAD IS WRITTEN ONCE WHEN A SINK IS OPENED,
+// A RECORD TAKES AT MOST RECORD_SIZE BYTES AND ROW_SIZE MORE FOR EVERY ROW
+typedef struct SinkEncoder {
+    size_t (*head)(char* const);
+    size_t (*record)(ConvertedStats const* const, char* const);
+    size_t record_size;
+    size_t row_size;
+} SinkEncoder;
+
+// STRUCTURE FOR HOLDING A KEY OF JSON SINK WITH ITS LENGTH
+typedef struct SinkKey {
+    char const* key;
+    size_t length;
+} SinkKey;
+
+// STRUCTURE FOR HOLDING SINK OBJECT, OUTPUT HOLDS LENGTH BYTES NOT WRITTEN YET
+struct sink {
+    SinkEncoder const* encoder;
+    char* output;
+    size_t capacity;
+    size_t length;
+    uint64_t records;
+    uint64_t bytes;
+    uint64_t writes;
+    int fd;
+    bool owned;
+    char padding[3];
+};
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static size_t Sink_json(ConvertedStats const* const, char* const);
+static size_t Sink_jsonRow(ConvertedStats const* const, size_t const, char* const);
+static size_t Sink_csvHead(char* const);
+static size_t Sink_csv(ConvertedStats const* const, char* const);
+static size_t Sink_csvRow(ConvertedStats const* const, size_t const, char* const);
+static size_t Sink_binary(ConvertedStats const* const, char* const);
+
+// KEYS OF COUNTER COLUMNS OF JSON SINK, WITH A SEPARATOR BEFORE EACH, IN /PROC/STAT ORDER
+static SinkKey const JSON_KEYS[COLUMNS] = {
+    JSON_KEY("user"), JSON_KEY("nice"), JSON_KEY("system"), JSON_KEY("idle"), JSON_KEY("iowait"),
+    JSON_KEY("irq"), JSON_KEY("softirq"), JSON_KEY("steal"), JSON_KEY("guest"), JSON_KEY("guest_nice")
+};
+
+// ENCODERS IN SINK_* ORDER
+static SinkEncoder const ENCODERS[] = {
+    { NULL, Sink_json, JSON_RECORD_SIZE, JSON_ROW_SIZE },
+    { Sink_csvHead, Sink_csv, 0, CSV_ROW_SIZE },
+    { NULL, Sink_binary, sizeof(SinkHeader), sizeof(SinkRow) }
+};
+
+/*
+    METHOD: Sink_open
+    ARGUMENTS:
+        format - SINK_JSON, SINK_CSV or SINK_BINARY
+        path - a file records are written to, truncated when
+            it exists, NULL or "-" for standard output
+        proc - most cores a single record has
+    PURPOSE: creation of Sink object, with a buffer big enough
+        for a record of proc cores allocated up front
+    RETURN: Sink object or NULL in
+        case creation was not possible
+*/
+Sink* Sink_open(
+    int const format,
+    char const* const path,
+    uint16_t const proc
+) {
+    SinkEncoder const* encoder;
+    Sink* sink;
+    char* output;
+    size_t capacity;
+    bool owned;
+    int fd;
+
+    if (format < SINK_JSON || format > SINK_BINARY || proc == 0) { return NULL; }
+
+    encoder = &ENCODERS[format];
+
+    capacity = encoder -> record_size + encoder -> row_size * ((size_t) proc + 1);
+    if (capacity < SINK_BUFFER) { capacity = SINK_BUFFER; }
+
+    sink = (Sink*) malloc(sizeof(Sink));
+    if (sink == NULL) { goto err_sink_alloc; }
+
+    output = (char*) malloc(capacity);
+    if (output == NULL) { goto err_output_alloc; }
+
+    owned = path != NULL && strcmp(path, "-") != 0;
+    fd = owned ? open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) : STDOUT_FILENO;
+    if (fd < 0) { goto err_file_open; }
+
+    *sink = (Sink) {
+        .encoder = encoder,
+        .output = output,
+        .capacity = capacity,
+        .length = 0,
+        .records = 0,
+        .bytes = 0,
+        .writes = 0,
+        .fd = fd,
+        .owned = owned
+    };
+
+    if (encoder -> head != NULL) { sink -> length = encoder -> head(output); }
+
+    return sink;
+
+    err_file_open:
+        free(output);
+    err_output_alloc:
+        free(sink);
+    err_sink_alloc:
+        return NULL;
+}
+
+/*
+    METHOD: Sink_emit
+    ARGUMENTS:
+        sink - a Sink object to work on
+        batch - records to be encoded, oldest first
+        count - number of records of a given batch
+    PURPOSE: encoding of a batch of records into sink's buffer,
+        which is written whenever the next record would not fit,
+        nothing is allocated, so it can run on every sample
+    RETURN: enums integer value, ERR_PARAMS when a record had more
+        cores than a sink was opened for and was skipped, ERR_RUN
+        when a write failed and what was buffered was lost
+*/
+int Sink_emit(
+    Sink* const sink,
+    ConvertedStats* const* const batch,
+    size_t const count
+) {
+    SinkEncoder const* encoder;
+    size_t bound;
+    int result;
+
+    if (sink == NULL || (batch == NULL && count > 0)) { return ERR_PARAMS; }
+
+    encoder = sink -> encoder;
+    result = OK;
+
+    for (size_t i = 0; i < count; i++) {
+        if (batch[i] == NULL) {
+            result = ERR_PARAMS;
+            continue;
+        }
+
+        bound = encoder -> record_size + encoder -> row_size * ((size_t) batch[i] -> count + 1);
+
+        if (bound > sink -> capacity) {
+            result = ERR_PARAMS;
+            continue;
+        }
+
+        if (sink -> length + bound > sink -> capacity && Sink_flush(sink) != OK) { result = ERR_RUN; }
+
+        sink -> length += encoder -> record(batch[i], sink -> output + sink -> length);
+        sink -> records++;
+    }
+
+    return result;
+}
+
+/*
+    METHOD: Sink_flush
+    ARGUMENTS:
+        sink - a Sink object to work on
+    PURPOSE: writing of everything encoded so far, repeated only
+        for what a short write left out, buffer is emptied either way
+    RETURN: enums integer value
+*/
+int Sink_flush(
+    Sink* const sink
+) {
+    ssize_t written;
+    size_t done;
+
+    if (sink == NULL) { return ERR_PARAMS; }
+
+    done = 0;
+
+    while (done < sink -> length) {
+        written = write(sink -> fd, sink -> output + done, sink -> length - done);
+
+        if (written < 0 && errno == EINTR) { continue; }
+
+        if (written <= 0) {
+            sink -> length = 0;
+            return ERR_RUN;
+        }
+
+        done += (size_t) written;
+    }
+
+    if (done > 0) { sink -> writes++; }
+
+    sink -> bytes += done;
+    sink -> length = 0;
+
+    return OK;
+}
+
+/*
+    METHOD: Sink_json
+    ARGUMENTS:
+        stats - a record to be encoded
+        output - where a line is saved
+    PURPOSE: encoding of a record as a JSON object on a line of its own,
+        aggregate cpu under "all" and every online core in "cores"
+    RETURN: length of an encoded line
+*/
+static size_t Sink_json(
+    ConvertedStats const* const stats,
+    char* const output
+) {
+    uint16_t const* ids;
+    size_t length;
+    bool first;
+
+    ids = CONVERTED_IDS(stats);
+
+    length = FORMAT_COPY(output, "{\"timestamp\":");
+    length += Format_unsigned(output + length, stats -> timestamp);
+    length += FORMAT_COPY(output + length, ",\"all\":{");
+    length += Sink_jsonRow(stats, 0, output + length);
+    length += FORMAT_COPY(output + length, "},\"cores\":[");
+
+    first = true;
+
+    for (size_t row = 1; row <= stats -> count; row++) {
+        if (ids[row] == STATS_OFFLINE) { continue; }
+
+        if (!first) { output[length++] = ','; }
+
+        length += FORMAT_COPY(output + length, "{\"id\":");
+        length += Format_unsigned(output + length, ids[row]);
+        output[length++] = ',';
+        length += Sink_jsonRow(stats, row, output + length);
+        output[length++] = '}';
+
+        first = false;
+    }
+
+    length += FORMAT_COPY(output + length, "]}\n");
+
+    return length;
+}
+
+/*
+    METHOD: Sink_jsonRow
+    ARGUMENTS:
+        stats - a record to be encoded
+        row - row of a given record, 0 for aggregate cpu
+        output - where members are saved
+    PURPOSE: encoding of usage and every counter of a row as JSON members
+    RETURN: length of encoded members
+*/
+static size_t Sink_jsonRow(
+    ConvertedStats const* const stats,
+    size_t const row,
+    char* const output
+) {
+    size_t length;
+
+    length = FORMAT_COPY(output, "\"usage\":");
+    length += Format_float(output + length, stats -> percentages[row]);
+
+    for (int column = 0; column < COLUMNS; column++) {
+        memcpy(output + length, JSON_KEYS[column].key, JSON_KEYS[column].length);
+        length += JSON_KEYS[column].length;
+        length += Format_float(output + length, CONVERTED_COLUMN(stats, column)[row]);
+    }
+
+    return length;
+}
+
+/*
+    METHOD: Sink_csvHead
+    ARGUMENTS:
+        output - where a header is saved
+    PURPOSE: composition of a header line naming every column of CSV sink
+    RETURN: length of a header line
+*/
+static size_t Sink_csvHead(
+    char* const output
+) {
+    return FORMAT_COPY(output, CSV_HEAD);
+}
+
+/*
+    METHOD: Sink_csv
+    ARGUMENTS:
+        stats - a record to be encoded
+        output - where lines are saved
+    PURPOSE: encoding of a record as a CSV line for aggregate cpu,
+        named "all", and a line for every online core
+    RETURN: length of encoded lines
+*/
+static size_t Sink_csv(
+    ConvertedStats const* const stats,
+    char* const output
+) {
+    uint16_t const* ids;
+    size_t length;
+    size_t stamp;
+
+    ids = CONVERTED_IDS(stats);
+
+    // TIMESTAMP OF EVERY LINE IS THE SAME, SO IT IS ENCODED ONCE AND COPIED
+    stamp = Format_unsigned(output, stats -> timestamp);
+    output[stamp++] = ',';
+
+    length = stamp;
+    length += FORMAT_COPY(output + length, "all");
+    length += Sink_csvRow(stats, 0, output + length);
+
+    for (size_t row = 1; row <= stats -> count; row++) {
+        if (ids[row] == STATS_OFFLINE) { continue; }
+
+        memcpy(output + length, output, stamp);
+        length += stamp;
+        length += Format_unsigned(output + length, ids[row]);
+        length += Sink_csvRow(stats, row, output + length);
+    }
+
+    return length;
+}
+
+/*
+    METHOD: Sink_csvRow
+    ARGUMENTS:
+        stats - a record to be encoded
+        row - row of a given record, 0 for aggregate cpu
+        output - where fields are saved
+    PURPOSE: encoding of usage and every counter of a row as CSV fields
+        ending a line
+    RETURN: length of encoded fields
+*/
+static size_t Sink_csvRow(
+    ConvertedStats const* const stats,
+    size_t const row,
+    char* const output
+) {
+    size_t length;
+
+    length = 0;
+    output[length++] = ',';
+    length += Format_float(output + length, stats -> percentages[row]);
+
+    for (int column = 0; column < COLUMNS; column++) {
+        output[length++] = ',';
+        length += Format_float(output + length, CONVERTED_COLUMN(stats, column)[row]);
+    }
+
+    output[length++] = '\n';
+
+    return length;
+}
+
+/*
+    METHOD: Sink_binary
+    ARGUMENTS:
+        stats - a record to be encoded
+        output - where a record is saved
+    PURPOSE: encoding of a record as a SinkHeader followed by a SinkRow
+        of aggregate cpu and of every online core, in host byte order
+    RETURN: length of an encoded record
+*/
+static size_t Sink_binary(
+    ConvertedStats const* const stats,
+    char* const output
+) {
+    uint16_t const* ids;
+    SinkHeader header;
+    SinkRow line;
+    size_t length;
+
+    ids = CONVERTED_IDS(stats);
+    length = sizeof(SinkHeader);
+
+    memset(&line, 0, sizeof(SinkRow));
+
+    for (size_t row = 0; row <= stats -> count; row++) {
+        if (row > 0 && ids[row] == STATS_OFFLINE) { continue; }
+
+        line.id = row == 0 ? SINK_AGGREGATE : ids[row];
+        line.percentages[0] = stats -> percentages[row];
+
+        for (int column = 0; column < COLUMNS; column++) {
+            line.percentages[column + 1] = CONVERTED_COLUMN(stats, column)[row];
+        }
+
+        memcpy(output + length, &line, sizeof(SinkRow));
+        length += sizeof(SinkRow);
+    }
+
+    header = (SinkHeader) {
+        .magic = SINK_MAGIC,
+        .rows = (uint16_t) ((length - sizeof(SinkHeader)) / sizeof(SinkRow)),
+        .columns = COLUMNS + 1,
+        .timestamp = stats -> timestamp
+    };
+
+    memcpy(output, &header, sizeof(SinkHeader));
+
+    return length;
+}
+
+/*
+    METHOD: Sink_stats
+    ARGUMENTS:
+        sink - a Sink object to work on
+        stats - where counters are saved
+    PURPOSE: access to counters of records encoded and bytes written
+    RETURN: enums integer value
+*/
+int Sink_stats(
+    Sink* const sink,
+    SinkStats* const stats
+) {
+    if (sink == NULL || stats == NULL) { return ERR_PARAMS; }
+
+    *stats = (SinkStats) {
+        .records = sink -> records,
+        .bytes = sink -> bytes,
+        .writes = sink -> writes
+    };
+
+    return OK;
+}
+
+/*
+    METHOD: Sink_close
+    ARGUMENTS:
+        sink - a Sink object to be closed
+    PURPOSE: flush of what was not written yet, close of its file
+        and free of memory taken by a given Sink object
+    RETURN: enums integer value of the last flush
+*/
+int Sink_close(
+    Sink* const sink
+) {
+    int result;
+
+    if (sink == NULL) { return ERR_PARAMS; }
+
+    result = Sink_flush(sink);
+
+    if (sink -> owned && close(sink -> fd) != 0) { result = ERR_RUN; }
+
+    free(sink -> output);
+    free(sink);
+
+    return result;
+}
@@ -0,0 +1,116 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: status.c                       
+    PURPOSE: implementation of status module, sleeps of 
+        threads which are cut short once status changes
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/enums.h"
+#include "../inc/status.h"
+
+/*
+    METHOD: Status_set
+    ARGUMENTS:
+        status - a status variable to be changed
+        value - new value of a given status
+    PURPOSE: change of status and wake of all threads sleeping on it,
+        async-signal-safe so it can be used from signal handlers
+    RETURN: nothing
+*/
+void Status_set(
+    volatile sig_atomic_t* const status,
+    int const value
+) {
+    if (status == NULL) { return; }
+
+    *status = value;
+
+    atomic_thread_fence(memory_order_seq_cst);
+
+    syscall(SYS_futex, (int*) status, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/*
+    METHOD: Status_sleep
+    ARGUMENTS:
+        status - a status variable which change ends the sleep
+        milliseconds - length of the sleep
+    PURPOSE: sleep which ends early when status stops being RUNNING
+    RETURN: OK when whole time was slept, ERR_CLOSED when status changed
+*/
+int Status_sleep(
+    volatile sig_atomic_t* const status,
+    long const milliseconds
+) {
+    struct timespec deadline;
+
+    Status_deadline(&deadline, milliseconds);
+
+    return Status_sleepUntil(status, &deadline);
+}
+
+/*
+    METHOD: Status_sleepUntil
+    ARGUMENTS:
+        status - a status variable which change ends the sleep
+        deadline - absolute CLOCK_MONOTONIC time the sleep ends at
+    PURPOSE: sleep which ends early when status stops being RUNNING
+    RETURN: OK when deadline was reached, ERR_CLOSED when status changed
+*/
+int Status_sleepUntil(
+    volatile sig_atomic_t* const status,
+    struct timespec const* const deadline
+) {
+    long result;
+
+    if (status == NULL || deadline == NULL) { return ERR_PARAMS; }
+
+    while (*status == RUNNING) {
+        result = syscall(
+            SYS_futex, 
+            (int*) status, 
+            FUTEX_WAIT_BITSET_PRIVATE, 
+            RUNNING, 
+            deadline, 
+            NULL, 
+            FUTEX_BITSET_MATCH_ANY
+        );
+
+        if (result != 0 && errno == ETIMEDOUT) { return OK; }
+    }
+
+    return ERR_CLOSED;
+}
+
+/*
+    METHOD: Status_deadline
+    ARGUMENTS:
+        deadline - a timespec where deadline will be saved
+        milliseconds - distance of deadline from now
+    PURPOSE: computation of absolute CLOCK_MONOTONIC deadline
+    RETURN: nothing
+*/
+void Status_deadline(
+    struct timespec* const deadline,
+    long const milliseconds
+) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+
+    deadline -> tv_sec += milliseconds / 1000;
+    deadline -> tv_nsec += (milliseconds % 1000) * 1000000;
+
+    if (deadline -> tv_nsec >= 1000000000) {
+        deadline -> tv_sec++;
+        deadline -> tv_nsec -= 1000000000;
+    }
+}
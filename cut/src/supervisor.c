@@ -0,0 +1,531 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: supervisor.c                       
+    PURPOSE: implementation of supervisor module, a single thread 
+        watching heartbeats of many stages, each with its own deadline
+        and policy, sleeping until the earliest moment any of them 
+        could expire or be restarted again
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "../inc/supervisor.h"
+#include "../inc/enums.h"
+#include "../inc/logger.h"
+#include "../inc/scheduler.h"
+#include "../inc/status.h"
+
+// MACRO DEFINITION
+#define NANOSECONDS 1000000000u
+#define MILLISECONDS 1000000u
+
+// STRUCTURE FOR HOLDING A WATCHED STAGE
+typedef struct Stage {
+    Notifier* notifier;
+    char const* name;
+    SupervisorRestart restart;
+    void* context;
+    uint64_t deadline;
+    uint64_t since;
+    uint64_t backoff;
+    uint64_t delay;
+    uint64_t retry;
+    atomic_uint_fast64_t stalls;
+    atomic_uint_fast64_t restarts;
+    atomic_uint_fast64_t stalled;
+    int action;
+    int attempts;
+    int limit;
+    bool stalling;
+    char padding[3];
+} Stage;
+
+// STRUCTURE FOR HOLDING SUPERVISOR OBJECT
+struct supervisor {
+    Stage stages[SUPERVISOR_STAGES];
+    volatile sig_atomic_t* status;
+    FILE* console;
+    pthread_t thread;
+    int count;
+    bool thread_started;
+    char padding[3];
+};
+
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static void* Supervisor_threadf(void* const);
+static int Supervisor_check(Supervisor* const, uint64_t* const);
+static int Supervisor_stall(Supervisor* const, Stage* const, uint64_t const, uint64_t const, uint64_t* const);
+static int Supervisor_restart(Supervisor* const, Stage* const, uint64_t const, uint64_t* const);
+static void Supervisor_report(Supervisor* const, Stage* const, char const* const);
+
+/*
+    METHOD: Supervisor_init
+    ARGUMENTS: none
+    PURPOSE: creation of Supervisor object with no stages watched
+    RETURN: Supervisor object or NULL in case creation was not possible 
+*/
+Supervisor* Supervisor_init(
+    void
+) {
+    Supervisor* supervisor;
+
+    LOG_DEBUG("SUPERVISOR", "INIT STARTED");
+
+    supervisor = (Supervisor*) calloc(1, sizeof(Supervisor));
+
+    if (supervisor == NULL) { return NULL; }
+
+    supervisor -> console = stderr;
+
+    LOG_DEBUG("SUPERVISOR", "INIT FINISHED");
+
+    return supervisor;
+}
+
+/*
+    METHOD: Supervisor_watch
+    ARGUMENTS:
+        supervisor - an object to work on
+        notifier - heartbeat of a stage to be watched
+        name - name of a stage used in reports, a static string
+        deadline - longest time in milliseconds a stage may go 
+            without a heartbeat, may be below a second
+        action - SUPERVISOR_TERMINATE to end everything on a stall,
+            SUPERVISOR_IGNORE to only count it or SUPERVISOR_RESTART,
+            which also needs Supervisor_onRestart
+    PURPOSE: registration of a stage, before supervisor is started
+    RETURN: index of a registered stage or -1 when it could not be registered
+*/
+int Supervisor_watch(
+    Supervisor* const supervisor,
+    Notifier* const notifier,
+    char const* const name,
+    long const deadline,
+    int const action
+) {
+    if (
+        supervisor == NULL || 
+        notifier == NULL || 
+        name == NULL || 
+        deadline <= 0 ||
+        (action != SUPERVISOR_TERMINATE && action != SUPERVISOR_RESTART && action != SUPERVISOR_IGNORE) ||
+        supervisor -> thread_started ||
+        supervisor -> count == SUPERVISOR_STAGES
+    ) { return -1; }
+
+    supervisor -> stages[supervisor -> count] = (Stage) {
+        .notifier = notifier,
+        .name = name,
+        .restart = NULL,
+        .context = NULL,
+        .deadline = (uint64_t) deadline * MILLISECONDS,
+        .stalls = ATOMIC_VAR_INIT(0),
+        .restarts = ATOMIC_VAR_INIT(0),
+        .stalled = ATOMIC_VAR_INIT(0),
+        .action = action,
+        .stalling = false
+    };
+
+    return supervisor -> count++;
+}
+
+/*
+    METHOD: Supervisor_onRestart
+    ARGUMENTS:
+        supervisor - an object to work on
+        stage - index of a stage returned by Supervisor_watch
+        restart - callback recreating a stage's thread, given context,
+            without waiting for the old one to end, returning OK 
+            or an error when a new one could not be started yet
+        context - a stage object passed to a given callback
+        backoff - milliseconds before the first retry of a restart,
+            doubled on every next one until a stage beats again
+        limit - most restart attempts in a stage's lifetime, 
+            after which its stall terminates everything
+    PURPOSE: configuration of restarting a stage, before supervisor is started
+    RETURN: enums integer value
+*/
+int Supervisor_onRestart(
+    Supervisor* const supervisor,
+    int const stage,
+    SupervisorRestart const restart,
+    void* const context,
+    long const backoff,
+    int const limit
+) {
+    Stage* watched;
+
+    if (
+        supervisor == NULL || 
+        stage < 0 || 
+        stage >= supervisor -> count ||
+        restart == NULL ||
+        backoff <= 0 ||
+        limit < 0 ||
+        supervisor -> thread_started
+    ) { return ERR_PARAMS; }
+
+    watched = &(supervisor -> stages[stage]);
+
+    if (watched -> action != SUPERVISOR_RESTART) { return ERR_PARAMS; }
+
+    watched -> restart = restart;
+    watched -> context = context;
+    watched -> backoff = (uint64_t) backoff * MILLISECONDS;
+    watched -> delay = watched -> backoff;
+    watched -> limit = limit;
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_setConsole
+    ARGUMENTS:
+        supervisor - an object which was not started yet
+        console - a stream stalls and restarts are shown on next to 
+            the log, standard error by default, NULL keeps them 
+            in the log alone, as when frames are drawn on a terminal
+    PURPOSE: choice of where supervisor's reports are shown
+    RETURN: enums integer value
+*/
+int Supervisor_setConsole(
+    Supervisor* const supervisor,
+    FILE* const console
+) {
+    if (supervisor == NULL) { return ERR_PARAMS; }
+    if (supervisor -> thread_started) { return ERR_RUN; }
+
+    supervisor -> console = console;
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_start
+    ARGUMENTS:
+        supervisor - an object to work on
+        status - a status variable which is set to TERMINATED 
+            when a stage stalls past its policy and which change ends watching
+    PURPOSE: start of supervisor thread, stages get their 
+        deadline counted from now until their first heartbeat
+    RETURN: enums integer value
+*/
+int Supervisor_start(
+    Supervisor* const supervisor,
+    volatile sig_atomic_t* const status
+) {
+    uint64_t now;
+
+    LOG_DEBUG("SUPERVISOR", "START STARTED");
+
+    if (supervisor == NULL || status == NULL || supervisor -> thread_started) { return ERR_PARAMS; }
+
+    for (int i = 0; i < supervisor -> count; i++) {
+        if (
+            supervisor -> stages[i].action == SUPERVISOR_RESTART && 
+            supervisor -> stages[i].restart == NULL
+        ) { return ERR_PARAMS; }
+    }
+
+    supervisor -> status = status;
+    now = Scheduler_now();
+
+    for (int i = 0; i < supervisor -> count; i++) { supervisor -> stages[i].since = now; }
+
+    if (pthread_create(&(supervisor -> thread), NULL, Supervisor_threadf, supervisor) != 0) {
+        return ERR_CREATE;
+    }
+
+    supervisor -> thread_started = true;
+
+    LOG_DEBUG("SUPERVISOR", "START FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_threadf
+    ARGUMENTS:
+        args - a supervisor to work on
+    PURPOSE: one timed wait until the earliest possible expiry 
+        or restart of any stage, repeated until a stall terminates 
+        everything or status changes
+    RETURN: NULL
+*/
+static void* Supervisor_threadf(
+    void* const args
+) {
+    Supervisor* supervisor;
+    struct timespec deadline;
+    uint64_t next;
+
+    supervisor = (Supervisor*) args;
+
+    LOG_DEBUG("SUPERVISOR", "THREAD FUNCTION STARTED");
+
+    while (*(supervisor -> status) == RUNNING) {
+        if (Supervisor_check(supervisor, &next) != OK) {
+            Status_set(supervisor -> status, TERMINATED);
+            break;
+        }
+
+        deadline = (struct timespec) {
+            .tv_sec = (time_t) (next / NANOSECONDS),
+            .tv_nsec = (long) (next % NANOSECONDS)
+        };
+
+        Status_sleepUntil(supervisor -> status, &deadline);
+    }
+
+    LOG_DEBUG("SUPERVISOR", "THREAD FUNCTION FINISHED");
+
+    return NULL;
+}
+
+/*
+    METHOD: Supervisor_check
+    ARGUMENTS:
+        supervisor - an object to work on
+        next - the earliest time any stage could expire at
+    PURPOSE: check of every stage's heartbeat against its deadline,
+        a stage beating again after a stall has its backoff reset
+    RETURN: OK or ERR_RUN when a stall should terminate everything
+*/
+static int Supervisor_check(
+    Supervisor* const supervisor,
+    uint64_t* const next
+) {
+    Stage* stage;
+    uint64_t now;
+    uint64_t last;
+    int result;
+
+    result = OK;
+    now = Scheduler_now();
+    *next = UINT64_MAX;
+
+    for (int i = 0; i < supervisor -> count; i++) {
+        stage = &(supervisor -> stages[i]);
+        last = Notifier_last(stage -> notifier);
+
+        // A BEAT AFTER START OR LAST RESTART MEANS A STAGE IS DOING ITS WORK
+        if (last > stage -> since) { stage -> delay = stage -> backoff; }
+        if (last < stage -> since) { last = stage -> since; }
+
+        if (now - last < stage -> deadline) {
+            if (stage -> stalling) { Supervisor_report(supervisor, stage, "RECOVERED"); }
+
+            stage -> stalling = false;
+
+            if (last + stage -> deadline < *next) { *next = last + stage -> deadline; }
+
+            continue;
+        }
+
+        if (Supervisor_stall(supervisor, stage, now, last, next) != OK) { result = ERR_RUN; }
+    }
+
+    return result;
+}
+
+/*
+    METHOD: Supervisor_stall
+    ARGUMENTS:
+        supervisor - an object to work on
+        stage - a stage past its deadline
+        now - current time
+        last - time of a given stage's last heartbeat, start or restart
+        next - the earliest time any stage needs a check at
+    PURPOSE: counting and report of a stall, once per stall,
+        followed by an action of a given stage's policy
+    RETURN: OK or ERR_RUN when a stall should terminate everything
+*/
+static int Supervisor_stall(
+    Supervisor* const supervisor,
+    Stage* const stage,
+    uint64_t const now,
+    uint64_t const last,
+    uint64_t* const next
+) {
+    atomic_store_explicit(&(stage -> stalled), now - last, memory_order_relaxed);
+
+    if (!stage -> stalling) {
+        stage -> stalling = true;
+        stage -> retry = now;
+
+        atomic_fetch_add_explicit(&(stage -> stalls), 1, memory_order_relaxed);
+
+        LOG_WARN(
+            "SUPERVISOR", "%s STALLED FOR %" PRIu64 " MS, DEADLINE %" PRIu64 " MS", 
+            stage -> name, (now - last) / MILLISECONDS, stage -> deadline / MILLISECONDS
+        );
+
+        if (supervisor -> console != NULL) {
+            fprintf(
+                supervisor -> console, "[SUPERVISOR]: %s STALLED FOR %" PRIu64 " MS, DEADLINE %" PRIu64 " MS\n", 
+                stage -> name, (now - last) / MILLISECONDS, stage -> deadline / MILLISECONDS
+            );
+        }
+    }
+
+    if (stage -> action == SUPERVISOR_TERMINATE) { return ERR_RUN; }
+
+    if (stage -> action == SUPERVISOR_RESTART) { return Supervisor_restart(supervisor, stage, now, next); }
+
+    // IGNORED STAGE IS LOOKED AT AGAIN ONLY TO NOTICE IT RECOVERED
+    if (now + stage -> deadline < *next) { *next = now + stage -> deadline; }
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_restart
+    ARGUMENTS:
+        supervisor - an object to work on
+        stage - a stalled stage with SUPERVISOR_RESTART policy
+        now - current time
+        next - the earliest time any stage needs a check at
+    PURPOSE: attempt of a restart once a stage's backoff has passed,
+        a failed one, as when old threads are still stuck, leaves a restart 
+        pending until next attempt, a successful one gives a stage a whole new deadline
+    RETURN: OK or ERR_RUN when a stage ran out of restart attempts
+*/
+static int Supervisor_restart(
+    Supervisor* const supervisor,
+    Stage* const stage,
+    uint64_t const now,
+    uint64_t* const next
+) {
+    int result;
+
+    if (now >= stage -> retry) {
+        if (stage -> attempts == stage -> limit) {
+            Supervisor_report(supervisor, stage, "RESTARTS EXHAUSTED");
+            return ERR_RUN;
+        }
+
+        // ONCE TERMINATION BEGAN, A STAGE IS LEFT TO END ON ITS OWN
+        if (*(supervisor -> status) != RUNNING) { return OK; }
+
+        stage -> attempts++;
+
+        result = stage -> restart(stage -> context);
+
+        stage -> retry = Scheduler_now() + stage -> delay;
+        stage -> delay *= 2;
+
+        if (result == OK) {
+            atomic_fetch_add_explicit(&(stage -> restarts), 1, memory_order_relaxed);
+
+            stage -> since = Scheduler_now();
+            stage -> stalling = false;
+
+            Supervisor_report(supervisor, stage, "RESTARTED");
+
+            if (stage -> since + stage -> deadline < *next) { *next = stage -> since + stage -> deadline; }
+
+            return OK;
+        }
+
+        Supervisor_report(supervisor, stage, "RESTART PENDING");
+    }
+
+    if (stage -> retry < *next) { *next = stage -> retry; }
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_report
+    ARGUMENTS:
+        supervisor - an object to work on
+        stage - a stage an event happened to
+        event - description of an event, a static string
+    PURPOSE: logging of a stage's event, also shown on 
+        supervisor's console when it has one
+    RETURN: nothing
+*/
+static void Supervisor_report(
+    Supervisor* const supervisor,
+    Stage* const stage,
+    char const* const event
+) {
+    LOG_WARN("SUPERVISOR", "%s %s", stage -> name, event);
+
+    if (supervisor -> console != NULL) { fprintf(supervisor -> console, "[SUPERVISOR]: %s %s\n", stage -> name, event); }
+}
+
+/*
+    METHOD: Supervisor_stats
+    ARGUMENTS:
+        supervisor - an object to work on
+        stage - index of a stage returned by Supervisor_watch
+        stats - where counters of a given stage are saved
+    PURPOSE: read of how many times a stage stalled and was restarted 
+        and how long it went without a heartbeat when last checked 
+        as stalled, safe to call while supervisor runs
+    RETURN: enums integer value
+*/
+int Supervisor_stats(
+    Supervisor* const supervisor,
+    int const stage,
+    SupervisorStats* const stats
+) {
+    Stage* watched;
+
+    if (supervisor == NULL || stats == NULL || stage < 0 || stage >= supervisor -> count) { return ERR_PARAMS; }
+
+    watched = &(supervisor -> stages[stage]);
+
+    *stats = (SupervisorStats) {
+        .stalls = atomic_load_explicit(&(watched -> stalls), memory_order_relaxed),
+        .restarts = atomic_load_explicit(&(watched -> restarts), memory_order_relaxed),
+        .stalled = atomic_load_explicit(&(watched -> stalled), memory_order_relaxed)
+    };
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_join
+    ARGUMENTS:
+        supervisor - an object which thread will be joined
+    PURPOSE: join of supervisor thread, which ends once status changes
+    RETURN: enums integer value
+*/
+int Supervisor_join(
+    Supervisor* const supervisor
+) {
+    LOG_DEBUG("SUPERVISOR", "JOIN STARTED");
+
+    if (supervisor == NULL || !supervisor -> thread_started) { return ERR_PARAMS; }
+    if (pthread_join(supervisor -> thread, NULL) != 0) { return ERR_JOIN; }
+
+    supervisor -> thread_started = false;
+
+    LOG_DEBUG("SUPERVISOR", "JOIN FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Supervisor_destroy
+    ARGUMENTS:
+        supervisor - an object to be freed
+    PURPOSE: free of a given object, watched notifiers belong to their stages
+    RETURN: nothing
+*/
+void Supervisor_destroy(
+    Supervisor* supervisor
+) {
+    free(supervisor);
+}
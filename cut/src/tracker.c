@@ -6,104 +6,262 @@
 
 // INCLUDES OF OUTSIDE LIBRARIES
 #include <stdatomic.h>  
+#include <stdbool.h>
 #include <pthread.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <time.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/eventfd.h>
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "../inc/analyzer.h"
 #include "../inc/printer.h"
 #include "../inc/buffer.h"
+#include "../inc/pool.h"
+#include "../inc/scheduler.h"
+#include "../inc/histogram.h"
+#include "../inc/supervisor.h"
 #include "../inc/logger.h"
 #include "../inc/reader.h"
 #include "../inc/enums.h"
 #include "../inc/stats.h"
 #include "../inc/tracker.h"
+#include "../inc/status.h"
+#include "../inc/sink.h"
+#include "../inc/metrics.h"
+
+// MACRO DEFINITION
+#define BUFFER_CAPACITY 32
+#define STALL_TICKS 3
+#define RESTART_LIMIT 5
+#define STAGES 3
+#define SHUTDOWN_WAIT 100
 
 // STRUCTURE FOR HOLDING TRACKER OBJECT
 struct tracker {
     Buffer* bufferRA;
     Buffer* bufferAP;
+    Pool* pool;
+    Scheduler* scheduler;
+    Histogram* latency;
     Reader* reader;
     Analyzer* analyzer;
     Printer* printer;
+    Supervisor* supervisor;
+    Metrics* metrics;
+    FILE* console;
+    int mode;
+    int wake;
     volatile sig_atomic_t status;
-    atomic_flag status_watch;
-    char padding[3];
+    uint16_t proc;
+    char padding[2];
 };
 
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static void Tracker_drop(void* const, void* const);
+static int Tracker_restartReader(void* const);
+static int Tracker_runThreaded(Tracker* const);
+static int Tracker_runEvent(Tracker* const);
+static int Tracker_tick(Tracker* const);
+static void Tracker_logStats(char* const, Buffer* const);
+static void Tracker_logMissed(Scheduler* const);
+static void Tracker_logSupervised(Supervisor* const);
+
+// NAMES OF STAGES IN ORDER THEY ARE WATCHED BY SUPERVISOR
+static char* const STAGE_NAMES[STAGES] = { "READER", "ANALYZER", "PRINTER" };
+
+/*
+    METHOD: Tracker_drop
+    ARGUMENTS:
+        element - a slot of bufferAP holding a pointer to converted stats
+        context - a pool which record came from
+    PURPOSE: release of converted stats overwritten by analyzer 
+        or never printed before shutdown
+    RETURN: nothing
+*/
+static void Tracker_drop(
+    void* const element,
+    void* const context
+) {
+    Pool_release((Pool*) context, *(ConvertedStats**) element);
+}
+
+/*
+    METHOD: Tracker_restartReader
+    ARGUMENTS:
+        context - a reader which stalled
+    PURPOSE: restart of reader's thread on supervisor's request
+    RETURN: enums integer value
+*/
+static int Tracker_restartReader(
+    void* const context
+) {
+    return Reader_restart((Reader*) context);
+}
+
 /*
     METHOD: Tracker_init
-    ARGUMENTS: none
+    ARGUMENTS:
+        interval - sampling interval in milliseconds, between 
+            SCHEDULER_MIN_INTERVAL and SCHEDULER_MAX_INTERVAL
+        mode - TRACKER_THREADED for a thread per stage or TRACKER_EVENT
+            for all stages run inline by an event loop of Tracker_start,
+            TRACKER_HEADLESS for an event loop of reader and analyzer, 
+            with no printer, its buffer, pool or supervisor built at all,
+            supervisor is built for TRACKER_THREADED alone
     PURPOSE: creation of Tracker object
     RETURN: Tracker object or NULL in 
         case creation was not possible 
 */
 Tracker* Tracker_init(
-    void
+    long const interval,
+    int const mode
 ) {
     Tracker* tracker;
     Buffer* bufferRA;
     Buffer* bufferAP;
+    Pool* pool;
+    Scheduler* scheduler;
+    Histogram* latency;
     Reader* reader;
     Analyzer* analyzer;
     Printer* printer;
-    uint8_t proc;
+    Supervisor* supervisor;
+    uint16_t proc;
+    long configured;
+    bool headless;
+    int wake;
 
-    Logger_log("TRACKER", "INIT STARTED");
+    LOG_DEBUG("TRACKER", "INIT STARTED");
+
+    if (mode != TRACKER_THREADED && mode != TRACKER_EVENT && mode != TRACKER_HEADLESS) { return NULL; }
 
     tracker = (Tracker*) malloc(sizeof(Tracker));
 
     if (tracker == NULL) { return NULL; }
 
-    proc = (uint8_t) sysconf(_SC_NPROCESSORS_ONLN);
-    if (proc <= 0) { goto err_proc_load; }
+    // A ROW IS KEPT FOR EVERY CONFIGURED CPU, SO HOT-ADDED ONES FIT WITHOUT A RESTART,
+    // CHECKED BEFORE NARROWING, SO A HOST WITH TOO MANY CPUS IS REFUSED INSTEAD OF MISREAD
+    configured = sysconf(_SC_NPROCESSORS_CONF);
+    if (configured < sysconf(_SC_NPROCESSORS_ONLN)) { configured = sysconf(_SC_NPROCESSORS_ONLN); }
+    if (configured <= 0 || configured >= STATS_OFFLINE) { goto err_proc_load; }
+
+    proc = (uint16_t) configured;
+
+    scheduler = Scheduler_init(interval);
+    if (scheduler == NULL) { goto err_proc_load; }
 
-    bufferRA = Buffer_init(sizeof(ProcessorStats) + sizeof(CoreStats) * proc, 32);
-    if (bufferRA == NULL) { goto err_proc_load; }
+    bufferRA = Buffer_init(STATS_SIZE(proc), BUFFER_CAPACITY, BUFFER_SPSC);
+    if (bufferRA == NULL) { goto err_scheduler_init; }
     
-    reader = Reader_init(bufferRA, proc);
+    reader = Reader_init(bufferRA, scheduler, proc, "/proc/stat", READER_PERSISTENT);
     if (reader == NULL) { goto err_reader_init; }
 
-    bufferAP = Buffer_init(sizeof(ConvertedStats) + sizeof(float) * proc, 32);
-    if (bufferAP == NULL) { goto err_bufferAP_init; }
+    // HEADLESS TRACKER ONLY BUILDS WHAT SINKS NEED, ANALYZER WRITES TO THEM ITSELF
+    headless = mode == TRACKER_HEADLESS;
+    pool = NULL;
+    bufferAP = NULL;
+    latency = NULL;
+    printer = NULL;
+    supervisor = NULL;
+
+    if (!headless) {
+        // RECORDS IN BUFFER, ONE BEING WRITTEN BY ANALYZER AND ONE BEING PRINTED
+        pool = Pool_init(CONVERTED_SIZE(proc), BUFFER_CAPACITY + 2);
+        if (pool == NULL) { goto err_bufferAP_init; }
+
+        // OVERWRITING OLDEST RECORDS SO A SLOW DISPLAY NEVER THROTTLES READER
+        bufferAP = Buffer_init(sizeof(ConvertedStats*), BUFFER_CAPACITY, BUFFER_OVERWRITE);
+        if (bufferAP == NULL) { goto err_pool_init; }
 
-    analyzer = Analyzer_init(bufferRA, bufferAP, proc);
+        Buffer_onDrop(bufferAP, Tracker_drop, pool);
+    }
+
+    analyzer = Analyzer_init(bufferRA, bufferAP, pool, proc);
     if (analyzer == NULL) { goto err_analyzer_init; }
 
-    printer = Printer_init(bufferAP, proc);
-    if (printer == NULL) { goto err_printer_init; }
+    if (!headless) {
+        latency = Histogram_init();
+        if (latency == NULL) { goto err_latency_init; }
+
+        printer = Printer_init(bufferAP, pool, latency, proc);
+        if (printer == NULL) { goto err_printer_init; }
+    }
+
+    // AN EVENT LOOP RUNS EVERY STAGE ON ONE THREAD, A STALL OF IT WOULD STOP ITS CHECKS TOO, SO NONE IS BUILT
+    if (mode == TRACKER_THREADED) {
+        // EVERY STAGE BEATS ONCE A TICK, FIRST RECORD IS PRINTED ONE TICK AFTER BASELINE,
+        // ANALYZER AND PRINTER WAIT FOR THEIR INPUT, SO THEIR STALLS FOLLOW READER'S ONE 
+        // AND ARE ONLY COUNTED, READER OUT OF RESTARTS TERMINATES EVERYTHING,
+        // WHILE FRAMES ARE DRAWN REPORTS GO TO LOG ALONE, SO THEY DO NOT TEAR THEM
+        supervisor = Supervisor_init();
+        if (supervisor == NULL) { goto err_supervisor_init; }
+
+        if (
+            Supervisor_watch(supervisor, Reader_notifier(reader), STAGE_NAMES[0], interval * STALL_TICKS, SUPERVISOR_RESTART) < 0 ||
+            Supervisor_watch(supervisor, Analyzer_notifier(analyzer), STAGE_NAMES[1], interval * STALL_TICKS, SUPERVISOR_IGNORE) < 0 ||
+            Supervisor_watch(supervisor, Printer_notifier(printer), STAGE_NAMES[2], interval * STALL_TICKS, SUPERVISOR_IGNORE) < 0 ||
+            Supervisor_onRestart(supervisor, 0, Tracker_restartReader, reader, interval * STALL_TICKS, RESTART_LIMIT) != OK ||
+            Supervisor_setConsole(supervisor, NULL) != OK
+        ) { goto err_supervisor_watch; }
+    }
+
+    // EVENT LOOP IS WOKEN THROUGH IT ON TERMINATION, WRITING TO IT IS SAFE IN A SIGNAL HANDLER
+    wake = mode != TRACKER_THREADED ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+    if (mode != TRACKER_THREADED && wake < 0) { goto err_wake_init; }
     
     *tracker = (Tracker) {
         .reader = reader,
         .bufferRA = bufferRA,
         .analyzer = analyzer,
         .bufferAP = bufferAP,
+        .pool = pool,
+        .scheduler = scheduler,
+        .latency = latency,
         .printer = printer,
+        .supervisor = supervisor,
+        .metrics = NULL,
+        .console = headless ? stderr : stdout,
+        .mode = mode,
+        .wake = wake,
         .status = ATOMIC_VAR_INIT(CREATED),
-        .status_watch = ATOMIC_FLAG_INIT
+        .proc = proc
     };
 
-    Logger_log("TRACKER", "INIT FINISHED");
+    LOG_DEBUG("TRACKER", "INIT FINISHED");
 
     return tracker;
 
+    err_wake_init:
+    err_supervisor_watch:
+        Supervisor_destroy(supervisor);
+    err_supervisor_init:
+        Printer_destroy(printer);
     err_printer_init:
+        Histogram_destroy(latency);
+    err_latency_init:
         Analyzer_destroy(analyzer);
     err_analyzer_init:
         Buffer_destroy(bufferAP);
+    err_pool_init:
+        Pool_destroy(pool);
     err_bufferAP_init:
         Reader_destroy(reader);
     err_reader_init:
         Buffer_destroy(bufferRA);
+    err_scheduler_init:
+        Scheduler_destroy(scheduler);
     err_proc_load:
         free(tracker);
 
-    Logger_log("TRACKER", "INIT MEMORY ALLOC ERROR");
+    LOG_ERROR("TRACKER", "INIT MEMORY ALLOC ERROR");
 
     return NULL;
 }
@@ -112,7 +270,8 @@ Tracker* Tracker_init(
     METHOD: Tracker_start
     ARGUMENTS:
         tracker - reference to an object which Tracker_start function is going to work on
-    PURPOSE: start of whole Tracker object's thread work
+    PURPOSE: start of whole Tracker object's work in its mode, 
+        returns when tracker is terminated
     RETURN: enums integer value
 */
 int Tracker_start(
@@ -121,59 +280,388 @@ int Tracker_start(
     if (tracker == NULL) { return ERR_PARAMS; }
     if (tracker -> status != CREATED) { return ERR_PARAMS; }
 
-    Logger_log("TRACKER", "START STARTING");
+    LOG_DEBUG("TRACKER", "START STARTING");
 
     tracker -> status = RUNNING;
 
-    Logger_log("TRACKER", "STARTING READER");
+    if (tracker -> mode != TRACKER_THREADED) { return Tracker_runEvent(tracker); }
+
+    return Tracker_runThreaded(tracker);
+}
+
+/*
+    METHOD: Tracker_runThreaded
+    ARGUMENTS:
+        tracker - reference to an object to work on
+    PURPOSE: start of a thread per stage and of a supervisor 
+        watching their heartbeats, wait for termination and join of all of them
+    RETURN: enums integer value
+*/
+static int Tracker_runThreaded(
+    Tracker* const tracker
+) {
+    int result;
+
+    LOG_DEBUG("TRACKER", "STARTING READER");
+
+    if (Reader_start(tracker -> reader, &(tracker -> status)) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN STARTING READER");
+        Tracker_destroy(tracker);
+        return ERR_RUN;
+    }
+
+    LOG_DEBUG("TRACKER", "STARTING ANALYZER");
 
-    if (Reader_start(tracker -> reader, &(tracker -> status), &(tracker -> status_watch)) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN STARTING READER");
+    if (Analyzer_start(tracker -> analyzer, &(tracker -> status)) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN STARTING ANALYZER");
         Tracker_destroy(tracker);
         return ERR_RUN;
     }
 
-    Logger_log("TRACKER", "STARTING ANALYZER");
+    LOG_DEBUG("TRACKER", "STARTING PRINTER");
 
-    if (Analyzer_start(tracker -> analyzer, &(tracker -> status), &(tracker -> status_watch)) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN STARTING ANALYZER");
+    if (Printer_start(tracker -> printer, &(tracker -> status)) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN STARTING PRINTER");
         Tracker_destroy(tracker);
         return ERR_RUN;
     }
 
-    Logger_log("TRACKER", "STARTING PRINTER");
+    LOG_DEBUG("TRACKER", "STARTING SUPERVISOR");
 
-    if (Printer_start(tracker -> printer, &(tracker -> status), &(tracker -> status_watch)) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN STARTING PRINTER");
+    if (Supervisor_start(tracker -> supervisor, &(tracker -> status)) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN STARTING SUPERVISOR");
         Tracker_destroy(tracker);
         return ERR_RUN;
     }
 
-    Logger_log("TRACKER", "JOINING READER");
+    LOG_DEBUG("TRACKER", "STARTING METRICS");
 
-    if (Reader_join(tracker -> reader) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN JOINING READER");
+    if (tracker -> metrics != NULL && Metrics_start(tracker -> metrics) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN STARTING METRICS");
+        Tracker_destroy(tracker);
+        return ERR_RUN;
+    }
+
+    // SUPERVISOR MAY REPLACE A STAGE'S THREAD, SO STAGES ARE JOINED ONLY AFTER IT,
+    // ANY STAGE ENDING ON ITS OWN, SUPERVISOR OR A SIGNAL ENDS THIS WAIT
+    while (Status_sleep(&(tracker -> status), SCHEDULER_MAX_INTERVAL) == OK) {}
+
+    Buffer_close(tracker -> bufferRA);
+    Buffer_close(tracker -> bufferAP);
+
+    LOG_DEBUG("TRACKER", "JOINING METRICS");
+
+    if (tracker -> metrics != NULL && Metrics_join(tracker -> metrics) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN JOINING METRICS");
+        Tracker_destroy(tracker);
+        return ERR_JOIN;
+    }
+
+    LOG_DEBUG("TRACKER", "JOINING SUPERVISOR");
+
+    if (Supervisor_join(tracker -> supervisor) != OK) {
+        LOG_ERROR("TRACKER", "ERROR WHEN JOINING SUPERVISOR");
         Tracker_destroy(tracker);
         return ERR_JOIN;
     }
 
-    Logger_log("TRACKER", "JOINING ANALYZER");
+    LOG_DEBUG("TRACKER", "JOINING READER");
+
+    // A REPLACED READER STUCK IN A READ PAST SHUTDOWN IS LEFT BEHIND, NOT WAITED FOR
+    result = Reader_join(tracker -> reader, SHUTDOWN_WAIT);
+
+    if (result != OK && result != ERR_TIMEOUT) {
+        LOG_ERROR("TRACKER", "ERROR WHEN JOINING READER");
+        Tracker_destroy(tracker);
+        return ERR_JOIN;
+    }
+
+    LOG_DEBUG("TRACKER", "JOINING ANALYZER");
 
     if (Analyzer_join(tracker -> analyzer) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN JOINING ANALYZER");
+        LOG_ERROR("TRACKER", "ERROR WHEN JOINING ANALYZER");
         Tracker_destroy(tracker);
         return ERR_JOIN;
     }
 
-    Logger_log("TRACKER", "JOINING PRINTER");
+    LOG_DEBUG("TRACKER", "JOINING PRINTER");
 
     if (Printer_join(tracker -> printer) != OK) {
-        Logger_log("TRACKER", "ERROR WHEN JOINING PRINTER");
+        LOG_ERROR("TRACKER", "ERROR WHEN JOINING PRINTER");
         Tracker_destroy(tracker);
         return ERR_JOIN;
     }
 
-    Logger_log("TRACKER", "START FINISHED");
+    LOG_DEBUG("TRACKER", "START FINISHED");
+
+    return OK;
+}
+
+/*
+    METHOD: Tracker_runEvent
+    ARGUMENTS:
+        tracker - reference to an object to work on
+    PURPOSE: running of read, analyze and print inline on a calling 
+        thread, woken by epoll on scheduler's timerfd, on a signalfd
+        of SIGINT and SIGTERM and on termination, logs are written after every wake up,
+        once tick's work is done, no supervisor is built for a single thread,
+        scrapes of metrics are served inline too, between ticks
+    RETURN: enums integer value
+*/
+static int Tracker_runEvent(
+    Tracker* const tracker
+) {
+    struct epoll_event events[4];
+    struct signalfd_siginfo signal;
+    uint64_t wakes;
+    sigset_t signals;
+    sigset_t previous;
+    int served;
+    int timer;
+    int signaled;
+    int epoll;
+    int ready;
+    int result;
+
+    LOG_DEBUG("TRACKER", "STARTING EVENT LOOP");
+
+    result = ERR_RUN;
+
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+
+    // SIGNALS ARE DELIVERED THROUGH SIGNALFD ONLY WHILE THEY ARE BLOCKED
+    if (pthread_sigmask(SIG_BLOCK, &signals, &previous) != 0) { return ERR_RUN; }
+
+    signaled = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signaled < 0) { goto err_signalfd_init; }
+
+    timer = Scheduler_arm(tracker -> scheduler);
+    if (timer < 0) { goto err_timerfd_init; }
+
+    epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll < 0) { goto err_epoll_init; }
+
+    events[0] = (struct epoll_event) { .events = EPOLLIN, .data.fd = timer };
+    events[1] = (struct epoll_event) { .events = EPOLLIN, .data.fd = signaled };
+    events[2] = (struct epoll_event) { .events = EPOLLIN, .data.fd = tracker -> wake };
+
+    // EPOLL DESCRIPTOR OF METRICS IS READABLE WHENEVER A SCRAPE HAS WORK, -1 WITHOUT METRICS
+    served = Metrics_fd(tracker -> metrics);
+    events[3] = (struct epoll_event) { .events = EPOLLIN, .data.fd = served };
+
+    if (
+        epoll_ctl(epoll, EPOLL_CTL_ADD, timer, &events[0]) != 0 ||
+        epoll_ctl(epoll, EPOLL_CTL_ADD, signaled, &events[1]) != 0 ||
+        epoll_ctl(epoll, EPOLL_CTL_ADD, tracker -> wake, &events[2]) != 0 ||
+        (served >= 0 && epoll_ctl(epoll, EPOLL_CTL_ADD, served, &events[3]) != 0)
+    ) { goto err_epoll_ctl; }
+
+    result = OK;
+
+    while (tracker -> status == RUNNING) {
+        ready = epoll_wait(epoll, events, 4, -1);
+
+        if (ready < 0 && errno == EINTR) { continue; }
+        if (ready < 0) { 
+            result = ERR_RUN;
+            break; 
+        }
+
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.fd == signaled) {
+                while (read(signaled, &signal, sizeof(signal)) == sizeof(signal)) {
+                    LOG_INFO("TRACKER", "SIGNAL RECEIVED");
+                    fprintf(tracker -> console, "\n");
+                    Tracker_terminate(tracker);
+                }
+            } else if (events[i].data.fd == tracker -> wake) {
+                while (read(tracker -> wake, &wakes, sizeof(wakes)) == sizeof(wakes)) {}
+            } else if (events[i].data.fd == served) {
+                if (Metrics_serve(tracker -> metrics, 0) != OK) { LOG_WARN("TRACKER", "ERROR WHEN SERVING METRICS"); }
+            } else if (
+                tracker -> status == RUNNING &&
+                Scheduler_expire(tracker -> scheduler) == OK && 
+                Tracker_tick(tracker) != OK &&
+                tracker -> status == RUNNING
+            ) {
+                LOG_ERROR("TRACKER", "ERROR WHEN RUNNING A TICK");
+                Tracker_terminate(tracker);
+                result = ERR_RUN;
+            }
+        }
+
+        Logger_flush();
+    }
+
+    LOG_DEBUG("TRACKER", "EVENT LOOP FINISHED");
+
+    err_epoll_ctl:
+        close(epoll);
+    err_epoll_init:
+    err_timerfd_init:
+        close(signaled);
+    err_signalfd_init:
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+    return result;
+}
+
+/*
+    METHOD: Tracker_tick
+    ARGUMENTS:
+        tracker - reference to an object to work on
+    PURPOSE: single tick of event loop mode, the same stage 
+        functions threaded mode runs, called one after another
+    RETURN: enums integer value
+*/
+static int Tracker_tick(
+    Tracker* const tracker
+) {
+    int result;
+
+    if (Reader_step(tracker -> reader) != OK) { return ERR_READ; }
+    if (Analyzer_step(tracker -> analyzer) != OK) { return ERR_RUN; }
+
+    // FIRST SAMPLE ONLY SETS A BASELINE, SO THERE MAY BE NO RECORD TO PRINT,
+    // HEADLESS ANALYZER HAS ALREADY WRITTEN ITS RECORD TO SINKS
+    if (tracker -> printer == NULL) { return OK; }
+
+    while ((result = Printer_step(tracker -> printer, false)) == OK) {}
+
+    return result == ERR_TIMEOUT ? OK : ERR_RUN;
+}
+
+/*
+    METHOD: Tracker_setLayout
+    ARGUMENTS: 
+        tracker - a Tracker object which was not started yet
+        layout - PRINTER_BARS, PRINTER_HEATMAP or PRINTER_NONE
+    PURPOSE: choice of a layout printed frames are drawn in, without
+        frames standard output is left to sinks and everything else 
+        tracker prints goes to standard error, supervisor's reports
+        are shown there too, with frames they stay in the log
+    RETURN: enum integer value
+*/
+int Tracker_setLayout(
+    Tracker* const tracker,
+    int const layout
+) {
+    int result;
+
+    if (tracker == NULL) { return ERR_PARAMS; }
+
+    result = Printer_setLayout(tracker -> printer, layout);
+
+    if (result != OK) { return result; }
+
+    tracker -> console = layout == PRINTER_NONE ? stderr : stdout;
+
+    if (tracker -> supervisor != NULL) { 
+        result = Supervisor_setConsole(tracker -> supervisor, layout == PRINTER_NONE ? stderr : NULL); 
+    }
+
+    return result;
+}
+
+/*
+    METHOD: Tracker_addSink
+    ARGUMENTS: 
+        tracker - a Tracker object which was not started yet
+        format - SINK_JSON, SINK_CSV or SINK_BINARY
+        path - a file records are written to, NULL or "-" for standard output
+    PURPOSE: opening of a sink every printed record is emitted to, 
+        or every analyzed one when headless, sized for every 
+        configured cpu, several may run at once
+    RETURN: enum integer value
+*/
+int Tracker_addSink(
+    Tracker* const tracker,
+    int const format,
+    char const* const path
+) {
+    Sink* sink;
+    int result;
+
+    if (tracker == NULL) { return ERR_PARAMS; }
+
+    sink = Sink_open(format, path, tracker -> proc);
+
+    if (sink == NULL) { return ERR_FILE_OPEN; }
+
+    result = tracker -> printer == NULL 
+        ? Analyzer_addSink(tracker -> analyzer, sink) 
+        : Printer_addSink(tracker -> printer, sink);
+
+    if (result != OK) { Sink_close(sink); }
+
+    return result;
+}
+
+/*
+    METHOD: Tracker_serveMetrics
+    ARGUMENTS: 
+        tracker - a Tracker object which was not started yet
+        address - a local IPv4 address scrapes are served on
+        port - a port scrapes are served on
+    PURPOSE: start of listening for scrapes of /metrics, served with 
+        usage of every cpu from the last analyzed record and with counters
+        of buffers, supervised stages and scheduler, on a thread of its own
+        when threaded, inline by an event loop otherwise
+    RETURN: enum integer value
+*/
+int Tracker_serveMetrics(
+    Tracker* const tracker,
+    char const* const address,
+    uint16_t const port
+) {
+    Metrics* metrics;
+
+    if (tracker == NULL || address == NULL) { return ERR_PARAMS; }
+    if (tracker -> metrics != NULL || tracker -> status != CREATED) { return ERR_PARAMS; }
+
+    metrics = Metrics_init(address, port, tracker -> proc);
+
+    if (metrics == NULL) { return ERR_INIT; }
+
+    // HEADLESS TRACKER HAS NO BUFFERAP AND NO SUPERVISOR, SO THEY ARE LEFT OUT
+    if (
+        Metrics_watchBuffer(metrics, "reader_analyzer", tracker -> bufferRA) != OK ||
+        (tracker -> bufferAP != NULL && Metrics_watchBuffer(metrics, "analyzer_printer", tracker -> bufferAP) != OK) ||
+        (tracker -> supervisor != NULL && Metrics_watchSupervisor(metrics, tracker -> supervisor, STAGE_NAMES, STAGES) != OK) ||
+        Metrics_watchScheduler(metrics, tracker -> scheduler) != OK ||
+        Analyzer_setMetrics(tracker -> analyzer, metrics) != OK
+    ) {
+        Metrics_destroy(metrics);
+        return ERR_INIT;
+    }
+
+    tracker -> metrics = metrics;
+
+    return OK;
+}
+
+/*
+    METHOD: Tracker_signal
+    ARGUMENTS: 
+        tracker - reference to an object which Tracker_signal function is going to work on
+    PURPOSE: sets status on a given tracker to TERMINATED and wakes sleeping stages 
+        and an event loop, async-signal-safe so it can be used from signal handlers,
+        buffers are closed by a thread which waits for this status
+    RETURN: enums integer value
+*/
+int Tracker_signal(
+    Tracker* const tracker
+) {
+    uint64_t const wake = 1;
+
+    if (tracker == NULL) { return ERR_PARAMS; }
+    if (tracker -> status == TERMINATED) { return ERR_PARAMS; }
+
+    Status_set(&(tracker -> status), TERMINATED);
+
+    if (tracker -> wake >= 0 && write(tracker -> wake, &wake, sizeof(wake)) != sizeof(wake)) { return ERR_RUN; }
 
     return OK;
 }
@@ -182,24 +670,85 @@ int Tracker_start(
     METHOD: Tracker_terminate
     ARGUMENTS: 
         tracker - reference to an object which Tracker_terminate function is going to work on
-    PURPOSE: sets status on a given tracker to TERMINATED if possible
-    RETURN: nothing
+    PURPOSE: sets status on a given tracker to TERMINATED if possible,
+        wakes sleeping stages and closes buffers so blocked ones return
+    RETURN: enums integer value
 */
 int Tracker_terminate(
     Tracker* const tracker
 ) {
-    Logger_log("TRACKER", "TERMINATE STARTED");
+    int result;
+
+    LOG_DEBUG("TRACKER", "TERMINATE STARTED");
 
     if (tracker == NULL) { return ERR_PARAMS; }
-    if (tracker -> status == TERMINATED) { return ERR_PARAMS; }
 
-    tracker -> status = TERMINATED;
+    result = Tracker_signal(tracker);
+    if (result == ERR_PARAMS) { return ERR_PARAMS; }
+    if (result != OK) { LOG_WARN("TRACKER", "COULD NOT WAKE EVENT LOOP"); }
 
-    Logger_log("TRACKER", "TERMINATE FINISHED");
+    Buffer_close(tracker -> bufferRA);
+    Buffer_close(tracker -> bufferAP);
+
+    LOG_DEBUG("TRACKER", "TERMINATE FINISHED");
 
     return OK;
 }
 
+/*
+    METHOD: Tracker_logStats
+    ARGUMENTS:
+        name - a name of a buffer used in a log message
+        buffer - a buffer which counters will be logged
+    PURPOSE: logging of buffer occupancy and loss counters
+    RETURN: nothing
+*/
+static void Tracker_logStats(
+    char* const name,
+    Buffer* const buffer
+) {
+    BufferStats stats;
+
+    if (Buffer_stats(buffer, &stats) != OK) { return; }
+
+    LOG_INFO(
+        name, "HIGH WATER %zu/%zu, DROPS %zu, OVERWRITES %zu", 
+        stats.high_water, stats.capacity, stats.drops, stats.overwrites
+    );
+}
+
+/*
+    METHOD: Tracker_logMissed
+    ARGUMENTS:
+        scheduler - a scheduler which missed ticks will be logged
+    PURPOSE: logging of sampling ticks which could not be kept
+    RETURN: nothing
+*/
+static void Tracker_logMissed(
+    Scheduler* const scheduler
+) {
+    LOG_INFO("SCHEDULER", "MISSED TICKS %" PRIu64, Scheduler_missed(scheduler));
+}
+
+/*
+    METHOD: Tracker_logSupervised
+    ARGUMENTS:
+        supervisor - a supervisor which stage counters will be logged
+    PURPOSE: logging of stalls and restarts of every watched stage
+    RETURN: nothing
+*/
+static void Tracker_logSupervised(
+    Supervisor* const supervisor
+) {
+    SupervisorStats stats;
+
+    for (int stage = 0; stage < STAGES; stage++) {
+        if (Supervisor_stats(supervisor, stage, &stats) != OK) { continue; }
+
+        LOG_INFO(STAGE_NAMES[stage], "STALLS %" PRIu64 ", RESTARTS %" PRIu64, stats.stalls, stats.restarts);
+    }
+}
+
 /*
     METHOD: Tracker_destroy
     ARGUMENTS: 
@@ -210,35 +759,34 @@ int Tracker_terminate(
 void Tracker_destroy(
     Tracker* const tracker
 ) {
-    ProcessorStats popRA;
-    ConvertedStats popAP;
-
-    Logger_log("TRACKER", "DESTROY STARTED");
+    LOG_DEBUG("TRACKER", "DESTROY STARTED");
 
     if (tracker == NULL) { return; }
-    
-    Logger_log("TRACKER", "POPPING BUFFER R-A ELEMENTS");
-
-    while(!Buffer_isEmpty(tracker -> bufferRA)) {
-        Buffer_pop(tracker -> bufferRA, &popRA);
-        free(popRA.cores);
-    }
 
-    Logger_log("TRACKER", "POPPING BUFFER A-P ELEMENTS");
+    Tracker_logStats("BUFFER RA", tracker -> bufferRA);
+    Tracker_logStats("BUFFER AP", tracker -> bufferAP);
+    Tracker_logMissed(tracker -> scheduler);
+    Tracker_logSupervised(tracker -> supervisor);
 
-    while(!Buffer_isEmpty(tracker -> bufferAP)) {
-        Buffer_pop(tracker -> bufferAP, &popAP);
-        free(popAP.percentages);
-    }
+    // READ TO PRINT LATENCY OF EVERY SHOWN SAMPLE, PRINTED BELOW LAST FRAME
+    Histogram_print(tracker -> latency, "LATENCY", tracker -> console);
     
+    // SCRAPES READ BUFFERS, SUPERVISOR AND SCHEDULER, SO METRICS GO FIRST
+    Metrics_destroy(tracker -> metrics);
     Reader_destroy(tracker -> reader);
     Analyzer_destroy(tracker -> analyzer);
     Printer_destroy(tracker -> printer);
     Buffer_destroy(tracker -> bufferRA);
     Buffer_destroy(tracker -> bufferAP);
+    Pool_destroy(tracker -> pool);
+    Scheduler_destroy(tracker -> scheduler);
+    Histogram_destroy(tracker -> latency);
+    Supervisor_destroy(tracker -> supervisor);
+
+    if (tracker -> wake >= 0) { close(tracker -> wake); }
 
     free(tracker);
 
-    Logger_log("TRACKER", "DESTROY FINISHED");
+    LOG_DEBUG("TRACKER", "DESTROY FINISHED");
 
 }
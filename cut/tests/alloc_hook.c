@@ -0,0 +1,73 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: alloc_hook.c                       
+    PURPOSE: counting heap allocations of tested modules, test binary 
+        is linked with --wrap so their malloc calls land here
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdatomic.h>
+#include <stddef.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "alloc_hook.h"
+
+// DECLARATIONS OF WRAPPED FUNCTIONS
+void* __real_malloc(size_t);
+void* __real_calloc(size_t, size_t);
+void* __real_realloc(void*, size_t);
+void* __real_aligned_alloc(size_t, size_t);
+void* __wrap_malloc(size_t);
+void* __wrap_calloc(size_t, size_t);
+void* __wrap_realloc(void*, size_t);
+void* __wrap_aligned_alloc(size_t, size_t);
+
+// GLOBAL VARIABLE COUNTING ALLOCATIONS
+static atomic_size_t allocations = 0;
+
+/*
+    METHOD: test_allocations
+    ARGUMENTS: none
+    PURPOSE: read of a number of allocations done so far
+    RETURN: number of allocations
+*/
+size_t test_allocations(
+    void
+) {
+    return atomic_load(&allocations);
+}
+
+void* __wrap_malloc(
+    size_t size
+) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(
+    size_t count,
+    size_t size
+) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(
+    void* pointer,
+    size_t size
+) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+
+    return __real_realloc(pointer, size);
+}
+
+void* __wrap_aligned_alloc(
+    size_t alignment,
+    size_t size
+) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+
+    return __real_aligned_alloc(alignment, size);
+}
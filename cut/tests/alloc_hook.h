@@ -0,0 +1,16 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: alloc_hook.h                       
+    PURPOSE: interface for allocation counting hook 
+*/
+
+#ifndef ALLOC_HOOK
+#define ALLOC_HOOK
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stddef.h>
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+size_t test_allocations(void);
+
+#endif
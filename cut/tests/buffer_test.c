@@ -0,0 +1,283 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: buffer_test.c                       
+    PURPOSE: testing buffer module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <assert.h>     
+#include <stdbool.h> 
+#include <pthread.h> 
+#include <unistd.h> 
+#include <time.h> 
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "buffer_test.h"
+#include "../inc/buffer.h"
+#include "../inc/enums.h"
+#include "../inc/status.h"
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* test_buffer_popper(void* const);
+static void test_buffer_type(int const, char const* const);
+static long test_buffer_since(struct timespec const* const);
+static void test_buffer_dropped(void* const, void* const);
+static void test_buffer_overwrite(void);
+static void* test_buffer_reserver(void* const);
+static void test_buffer_contended(void);
+
+/*
+    METHOD: test_buffer_since
+    ARGUMENTS:
+        start - a moment measured from
+    PURPOSE: measuring milliseconds elapsed since a given moment
+    RETURN: elapsed milliseconds
+*/
+static long test_buffer_since(
+    struct timespec const* const start
+) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (now.tv_sec - start -> tv_sec) * 1000 
+        + (now.tv_nsec - start -> tv_nsec) / 1000000;
+}
+
+/*
+    METHOD: test_buffer_popper
+    ARGUMENTS:
+        args - a buffer to pop from
+    PURPOSE: thread blocking on an empty buffer until it gets closed
+    RETURN: nothing
+*/
+static void* test_buffer_popper(
+    void* const args
+) {
+    static int result;
+    int element;
+
+    result = Buffer_pop((Buffer*) args, &element);
+
+    return &result;
+}
+
+/*
+    METHOD: test_buffer_type
+    ARGUMENTS:
+        type - buffer type to be tested
+        name - name of a tested type
+    PURPOSE: testing timed and cancellable waits of a given buffer type
+    RETURN: nothing
+*/
+static void test_buffer_type(
+    int const type,
+    char const* const name
+) {
+    Buffer* buffer;
+    pthread_t thread;
+    struct timespec start;
+    struct timespec deadline;
+    void* result;
+    void* slot;
+    int element;
+
+    buffer = Buffer_init(sizeof(int), 2, type);
+    assert(buffer != NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Status_deadline(&deadline, 50);
+
+    assert(Buffer_popTimed(buffer, &element, &deadline) == ERR_TIMEOUT);
+    assert(test_buffer_since(&start) >= 50);
+    printf("%s pop timeout test success...\n", name);
+
+    element = 7;
+    assert(Buffer_push(buffer, &element) == OK);
+    assert(Buffer_push(buffer, &element) == OK);
+
+    Status_deadline(&deadline, 50);
+
+    assert(Buffer_pushTimed(buffer, &element, &deadline) == ERR_TIMEOUT);
+    printf("%s push timeout test success...\n", name);
+
+    assert(Buffer_pop(buffer, &element) == OK && element == 7);
+    assert(Buffer_pop(buffer, &element) == OK && element == 7);
+
+    assert(Buffer_reserve(buffer, &slot) == OK);
+    assert(Buffer_cancel(buffer) == OK);
+    assert(Buffer_isEmpty(buffer));
+
+    Status_deadline(&deadline, 50);
+
+    assert(Buffer_pushTimed(buffer, &element, &deadline) == OK);
+    assert(Buffer_pop(buffer, &element) == OK && element == 7);
+    printf("%s cancel of reservation test success...\n", name);
+
+    assert(pthread_create(&thread, NULL, test_buffer_popper, buffer) == 0);
+
+    usleep(20000);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    Buffer_close(buffer);
+
+    assert(pthread_join(thread, &result) == 0);
+    assert(*(int*) result == ERR_CLOSED);
+    assert(test_buffer_since(&start) < 20);
+    printf("%s close wakes consumer test success...\n", name);
+
+    assert(Buffer_push(buffer, &element) == ERR_CLOSED);
+    printf("%s push after close test success...\n", name);
+
+    Buffer_destroy(buffer);
+}
+
+/*
+    METHOD: test_buffer_dropped
+    ARGUMENTS:
+        element - a dropped element
+        context - a counter of dropped elements
+    PURPOSE: counting elements passed to a drop callback
+    RETURN: nothing
+*/
+static void test_buffer_dropped(
+    void* const element,
+    void* const context
+) {
+    (void) element;
+
+    (*(int*) context)++;
+}
+
+/*
+    METHOD: test_buffer_overwrite
+    ARGUMENTS: none
+    PURPOSE: testing overwrite of the oldest elements and buffer counters
+    RETURN: nothing
+*/
+static void test_buffer_overwrite(
+    void
+) {
+    Buffer* buffer;
+    BufferStats stats;
+    int dropped;
+    int element;
+
+    dropped = 0;
+
+    buffer = Buffer_init(sizeof(int), 2, BUFFER_OVERWRITE);
+    assert(buffer != NULL);
+    assert(Buffer_onDrop(buffer, test_buffer_dropped, &dropped) == OK);
+
+    for (element = 1; element <= 5; element++) {
+        assert(Buffer_tryPush(buffer, &element) == OK);
+    }
+
+    assert(dropped == 3);
+    assert(Buffer_pop(buffer, &element) == OK && element == 4);
+    assert(Buffer_pop(buffer, &element) == OK && element == 5);
+    printf("OVERWRITE oldest element test success...\n");
+
+    assert(Buffer_stats(buffer, &stats) == OK);
+    assert(stats.count == 0 && stats.capacity == 2);
+    assert(stats.high_water == 2 && stats.overwrites == 3 && stats.drops == 0);
+    printf("OVERWRITE counters test success...\n");
+
+    assert(Buffer_push(buffer, &element) == OK);
+    Buffer_destroy(buffer);
+
+    assert(dropped == 4);
+    printf("OVERWRITE drop on destroy test success...\n");
+
+    buffer = Buffer_init(sizeof(int), 2, BUFFER_SPSC);
+    assert(buffer != NULL);
+
+    assert(Buffer_tryPush(buffer, &element) == OK);
+    assert(Buffer_tryPush(buffer, &element) == OK);
+    assert(Buffer_tryPush(buffer, &element) == ERR_TIMEOUT);
+
+    assert(Buffer_stats(buffer, &stats) == OK);
+    assert(stats.count == 2 && stats.high_water == 2 && stats.drops == 1);
+    printf("SPSC drop counter test success...\n");
+
+    Buffer_destroy(buffer);
+}
+
+/*
+    METHOD: test_buffer_reserver
+    ARGUMENTS:
+        args - a buffer to reserve a slot in
+    PURPOSE: thread keeping a reserved slot for a while before its commit
+    RETURN: nothing
+*/
+static void* test_buffer_reserver(
+    void* const args
+) {
+    static int result;
+    void* slot;
+
+    result = Buffer_reserve((Buffer*) args, &slot);
+
+    if (result == OK) {
+        *(int*) slot = 1;
+        usleep(30000);
+        result = Buffer_commit((Buffer*) args);
+    }
+
+    return &result;
+}
+
+/*
+    METHOD: test_buffer_contended
+    ARGUMENTS: none
+    PURPOSE: testing that a push which must not wait is dropped 
+        only when buffer is full and not when another producer holds it
+    RETURN: nothing
+*/
+static void test_buffer_contended(
+    void
+) {
+    Buffer* buffer;
+    BufferStats stats;
+    pthread_t thread;
+    void* result;
+    int element;
+
+    buffer = Buffer_init(sizeof(int), 2, BUFFER_MPMC);
+    assert(buffer != NULL);
+
+    assert(pthread_create(&thread, NULL, test_buffer_reserver, buffer) == 0);
+
+    usleep(10000);
+    element = 2;
+
+    assert(Buffer_tryPush(buffer, &element) == OK);
+    assert(pthread_join(thread, &result) == 0 && *(int*) result == OK);
+    assert(Buffer_tryPush(buffer, &element) == ERR_TIMEOUT);
+
+    assert(Buffer_stats(buffer, &stats) == OK);
+    assert(stats.count == 2 && stats.drops == 1);
+    printf("MPMC contended push not dropped test success...\n");
+
+    Buffer_destroy(buffer);
+}
+
+/*
+    METHOD: test_buffer
+    ARGUMENTS: none
+    PURPOSE: testing buffer timed waits and close for all buffer types
+    RETURN: nothing
+*/
+void test_buffer(
+    void
+) {
+    printf("Starting buffer test...\n");
+
+    test_buffer_type(BUFFER_MPMC, "MPMC");
+    test_buffer_type(BUFFER_SPSC, "SPSC");
+    test_buffer_overwrite();
+    test_buffer_contended();
+
+    printf("Buffer test finished !\n");
+}
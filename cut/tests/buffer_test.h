@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: buffer_test.h                       
+    PURPOSE: interface for buffer test module 
+*/
+
+#ifndef BUFFER_TEST
+#define BUFFER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_buffer(void);
+
+#endif 
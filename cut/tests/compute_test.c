@@ -0,0 +1,193 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute_test.c                       
+    PURPOSE: testing compute module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <string.h>      
+#include <assert.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "compute_test.h"
+#include "../inc/compute.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION, ODD ROW COUNT SO VECTOR KERNELS ALSO RUN THEIR SCALAR TAIL
+#define ROWS 67
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static uint64_t test_compute_random(uint64_t* const);
+static float test_compute_reference(uint64_t const* const, uint64_t const* const, size_t const, uint64_t* const, uint64_t* const, float* const);
+static void test_compute_kernel(int const, char const* const);
+
+/*
+    METHOD: test_compute_random
+    ARGUMENTS:
+        state - state of a generator
+    PURPOSE: xorshift generator, so every run uses the same samples
+    RETURN: next pseudo random number
+*/
+static uint64_t test_compute_random(
+    uint64_t* const state
+) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+/*
+    METHOD: test_compute_reference
+    ARGUMENTS:
+        columns - first row of a given row's columns
+        previous - first row of a given row's columns of previous sample
+        stride - distance between columns
+        total_prev - previous total of a given row
+        idle_prev - previous idle time of a given row
+        categories - first row of percentages of every counter 
+            of a given row, with the same stride
+    PURPOSE: usage percentage counted the way analyzer did it one core 
+        structure at a time, with every counter's share of total delta
+    RETURN: float percentage
+*/
+static float test_compute_reference(
+    uint64_t const* const columns,
+    uint64_t const* const previous,
+    size_t const stride,
+    uint64_t* const total_prev,
+    uint64_t* const idle_prev,
+    float* const categories
+) {
+    uint64_t idle;
+    uint64_t non_idle;
+    uint64_t total;
+    uint64_t idled;
+    float percentage;
+
+    idle = columns[COLUMN_IDLE * stride] + columns[COLUMN_IOWAIT * stride];
+    non_idle = columns[COLUMN_USER * stride] 
+        + columns[COLUMN_NICE * stride] 
+        + columns[COLUMN_SYSTEM * stride] 
+        + columns[COLUMN_IRQ * stride] 
+        + columns[COLUMN_SOFTIRQ * stride] 
+        + columns[COLUMN_STEAL * stride];
+
+    total = idle + non_idle - *total_prev;
+    idled = idle - *idle_prev;
+
+    percentage = 0.0f;
+
+    if (total != 0) { percentage = (float) (total - idled) / (float) total * 100.0f; }
+
+    for (int column = 0; column < COLUMNS; column++) {
+        categories[column * (int) stride] = total != 0 
+            ? (float) (columns[column * (int) stride] - previous[column * (int) stride]) / (float) total * 100.0f
+            : 0.0f;
+    }
+
+    *total_prev = idle + non_idle;
+    *idle_prev = idle;
+
+    return percentage;
+}
+
+/*
+    METHOD: test_compute_kernel
+    ARGUMENTS:
+        type - kernel to be tested
+        name - name of a tested kernel
+    PURPOSE: comparison of a given kernel's usage and per counter percentages 
+        with reference results bit for bit, including idle rows, huge deltas 
+        and counters going backwards
+    RETURN: nothing
+*/
+static void test_compute_kernel(
+    int const type,
+    char const* const name
+) {
+    ComputeKernel kernel;
+    uint64_t columns[COLUMNS * ROWS];
+    uint64_t previous[COLUMNS * ROWS];
+    uint64_t prev[COMPUTE_PREV_BLOCKS * ROWS];
+    uint64_t reference_total[ROWS];
+    uint64_t reference_idle[ROWS];
+    float percentages[COMPUTE_OUT_BLOCKS * ROWS];
+    float reference[COMPUTE_OUT_BLOCKS * ROWS];
+    uint64_t state;
+
+    kernel = Compute_kernel(type);
+
+    if (kernel == NULL) {
+        printf("%s kernel not supported, skipped...\n", name);
+        return;
+    }
+
+    state = 88172645463325252u;
+
+    for (size_t i = 0; i < COLUMNS * ROWS; i++) { 
+        columns[i] = test_compute_random(&state) % 100000000u; 
+    }
+
+    Compute_baseline(columns, ROWS, ROWS, prev);
+
+    for (size_t row = 0; row < ROWS; row++) {
+        test_compute_reference(&columns[row], &columns[row], ROWS, &reference_total[row], &reference_idle[row], &reference[ROWS + row]);
+    }
+
+    for (int sample = 0; sample < 100; sample++) {
+        memcpy(previous, columns, sizeof(columns));
+
+        // EVERY TENTH SAMPLE HAS DELTAS ABOVE 2^31, WHICH VECTOR KERNELS CONVERT IN SCALAR
+        for (size_t i = 0; i < COLUMNS * ROWS; i++) { 
+            // ROW 3 DOES NOT MOVE IN SAMPLE 5, SO ITS TOTAL DELTA IS ZERO
+            if (sample == 5 && i % ROWS == 3) { continue; }
+
+            columns[i] += test_compute_random(&state) % (sample % 10 == 9 ? 4000000000u : 1000u); 
+        }
+
+        // IDLE COUNTER GOING BACKWARDS MAKES DELTAS WRAP AROUND
+        if (sample == 7) { columns[COLUMN_IDLE * ROWS + 10] /= 2; }
+
+        kernel(columns, ROWS, ROWS, prev, percentages);
+
+        for (size_t row = 0; row < ROWS; row++) {
+            reference[row] = test_compute_reference(
+                &columns[row], &previous[row], ROWS, 
+                &reference_total[row], &reference_idle[row], &reference[ROWS + row]
+            );
+        }
+
+        assert(memcmp(percentages, reference, sizeof(percentages)) == 0);
+    }
+
+    kernel(columns, ROWS, ROWS, prev, percentages);
+
+    for (size_t i = 0; i < COMPUTE_OUT_BLOCKS * ROWS; i++) { assert(percentages[i] == 0.0f); }
+
+    printf("%s kernel bit-exact test success...\n", name);
+}
+
+/*
+    METHOD: test_compute
+    ARGUMENTS: none
+    PURPOSE: testing every percentage kernel this cpu supports
+    RETURN: nothing
+*/
+void test_compute(
+    void
+) {
+    printf("Starting compute test...\n");
+
+    assert(Compute_kernel(COMPUTE_AUTO) != NULL);
+    assert(Compute_kernel(-1) == NULL);
+
+    test_compute_kernel(COMPUTE_SCALAR, "SCALAR");
+    test_compute_kernel(COMPUTE_SSE2, "SSE2");
+    test_compute_kernel(COMPUTE_AVX2, "AVX2");
+
+    printf("Compute test finished !\n");
+}
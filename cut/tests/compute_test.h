@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: compute_test.h                       
+    PURPOSE: interface for compute test module 
+*/
+
+#ifndef COMPUTE_TEST
+#define COMPUTE_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_compute(void);
+
+#endif
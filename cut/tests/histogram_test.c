@@ -0,0 +1,59 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: histogram_test.c                       
+    PURPOSE: testing histogram module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <assert.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "histogram_test.h"
+#include "../inc/histogram.h"
+
+/*
+    METHOD: test_histogram
+    ARGUMENTS: none
+    PURPOSE: testing percentiles of recorded values and their error bound
+    RETURN: nothing
+*/
+void test_histogram(
+    void
+) {
+    Histogram* histogram;
+    uint64_t percentile;
+
+    printf("Starting histogram test...\n");
+
+    histogram = Histogram_init();
+    assert(histogram != NULL);
+    assert(Histogram_percentile(histogram, 50.0) == 0);
+
+    for (uint64_t value = 1; value <= 1000; value++) {
+        Histogram_record(histogram, value * 1000u);
+    }
+
+    assert(Histogram_count(histogram) == 1000);
+    assert(Histogram_max(histogram) == 1000000u);
+
+    percentile = Histogram_percentile(histogram, 50.0);
+    assert(percentile >= 500000u && percentile < 625000u);
+
+    percentile = Histogram_percentile(histogram, 99.0);
+    assert(percentile >= 990000u && percentile <= 1000000u);
+
+    assert(Histogram_percentile(histogram, 100.0) == 1000000u);
+    printf("Percentiles within bucket error test success...\n");
+
+    Histogram_record(histogram, 0);
+    Histogram_record(histogram, UINT64_MAX);
+    assert(Histogram_max(histogram) == UINT64_MAX);
+    assert(Histogram_percentile(histogram, 0.0) == 0);
+    printf("Extreme values test success...\n");
+
+    Histogram_destroy(histogram);
+
+    printf("Histogram test finished !\n");
+}
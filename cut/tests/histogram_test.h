@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: histogram_test.h                       
+    PURPOSE: interface for histogram test module 
+*/
+
+#ifndef HISTOGRAM_TEST
+#define HISTOGRAM_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_histogram(void);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: logger_test.c                       
+    PURPOSE: testing logger module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <inttypes.h>      
+#include <string.h>      
+#include <assert.h>     
+#include <unistd.h>     
+#include <sys/stat.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "logger_test.h"
+#include "../inc/logger.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITIONS
+#define PATH "logs/log.txt"
+#define RECORDS 4096
+#define SEGMENT_SIZE 1024
+#define SEGMENTS 3
+#define ROTATED 200
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void test_logger_drops(void);
+static void test_logger_rotation(void);
+
+/*
+    METHOD: test_logger
+    ARGUMENTS: none
+    PURPOSE: testing that records are formatted only from their 
+        format and 64 bit arguments, whatever length modifiers say,
+        and that logs are refused before logger exists
+    RETURN: nothing
+*/
+void test_logger(
+    void
+) {
+    LogRecord record;
+    char line[64];
+    size_t length;
+
+    printf("Starting logger test...\n");
+
+    record = (LogRecord) {
+        .timestamp = 12000000042u,
+        .name = "TEST",
+        .message = LOG_MESSAGE("%s HAS %zu/%" PRIu64 " AT %3d%%", "BUFFER", (size_t) 7, (uint64_t) 32, -5),
+        .thread = 42,
+        .level = LOG_LEVEL_WARN
+    };
+
+    length = Logger_format(&record, line, sizeof(line));
+
+    assert(length == strlen(line));
+    assert(strcmp(line, "12.000000042 42 WARN [TEST]: BUFFER HAS 7/32 AT  -5%\n") == 0);
+    printf("Deferred arguments formatted test success...\n");
+
+    record.message = (LogMessage) LOG_MESSAGE("%s %s %s %s %s", "LONG", "LONG", "LONG", "LONG");
+    length = Logger_format(&record, line, 40);
+
+    assert(length == 39 && line[38] == '\n');
+    assert(strncmp(line, "12.000000042 42 WARN [TEST]: LONG LONG", 38) == 0);
+    printf("Too long line cut short test success...\n");
+
+    assert(Logger_write(LOG_LEVEL_ERROR, "TEST", &record.message) == ERR_INIT);
+
+    test_logger_drops();
+    test_logger_rotation();
+
+    printf("Logger test finished !\n");
+}
+
+/*
+    METHOD: test_logger_drops
+    ARGUMENTS: none
+    PURPOSE: testing that a burst larger than a queue never waits 
+        for logger, every record is either written or counted as dropped
+    RETURN: nothing
+*/
+static void test_logger_drops(
+    void
+) {
+    char line[256];
+    FILE* file;
+    uint64_t written;
+    uint64_t accepted;
+
+    assert(Logger_init() == OK);
+    assert(Logger_start() == OK);
+
+    accepted = 0;
+
+    for (int i = 0; i < RECORDS; i++) {
+        if (Logger_write(LOG_LEVEL_ERROR, "TEST", &(LogMessage const) LOG_MESSAGE("BURST %d", i)) == OK) { accepted++; }
+    }
+
+    Logger_terminate();
+    assert(Logger_join() == OK);
+
+    file = fopen(PATH, "r");
+    assert(file != NULL);
+
+    written = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strstr(line, "[TEST]: BURST") != NULL) { written++; }
+    }
+
+    fclose(file);
+
+    assert(Logger_dropped() > 0);
+    assert(written == accepted);
+    assert(written + Logger_dropped() == RECORDS);
+
+    Logger_destroy();
+
+    printf("Full queue drops instead of waiting test success...\n");
+}
+
+/*
+    METHOD: test_logger_rotation
+    ARGUMENTS: none
+    PURPOSE: testing that a segment left by a crash keeps only its whole 
+        lines, and that segments rotate at their size with only 
+        a given count of them kept
+    RETURN: nothing
+*/
+static void test_logger_rotation(
+    void
+) {
+    char path[64];
+    char line[256];
+    struct stat info;
+    FILE* file;
+
+    // SEGMENT OF A CRASHED RUN, PREALLOCATED TAIL OF ZEROS AFTER A LINE CUT SHORT
+    file = fopen(PATH, "w");
+    assert(file != NULL);
+    fputs("WHOLE LINE\nCUT SHO", file);
+    for (int i = 0; i < SEGMENT_SIZE - 18; i++) { fputc('\0', file); }
+    fclose(file);
+
+    for (int i = 1; i <= SEGMENTS; i++) {
+        snprintf(path, sizeof(path), "%s.%d", PATH, i);
+        unlink(path);
+    }
+
+    assert(Logger_setRotation(SEGMENT_SIZE, SEGMENTS) == OK);
+    assert(Logger_init() == OK);
+    assert(Logger_setRotation(SEGMENT_SIZE, SEGMENTS) == ERR_INIT);
+
+    file = fopen(PATH ".1", "r");
+    assert(file != NULL);
+    assert(fread(line, 1, sizeof(line), file) == 11 && strncmp(line, "WHOLE LINE\n", 11) == 0);
+    fclose(file);
+    printf("Crashed segment recovered test success...\n");
+
+    for (int i = 0; i < ROTATED; i++) {
+        assert(Logger_write(LOG_LEVEL_ERROR, "TEST", &(LogMessage const) LOG_MESSAGE("ROTATION %d", i)) == OK);
+    }
+
+    assert(Logger_join() == OK);
+
+    for (int i = 0; i < SEGMENTS; i++) {
+        if (i == 0) { snprintf(path, sizeof(path), "%s", PATH); }
+        else { snprintf(path, sizeof(path), "%s.%d", PATH, i); }
+
+        assert(stat(path, &info) == 0);
+        assert(info.st_size > 0 && info.st_size <= SEGMENT_SIZE);
+    }
+
+    snprintf(path, sizeof(path), "%s.%d", PATH, SEGMENTS);
+    assert(stat(path, &info) != 0);
+
+    file = fopen(PATH, "r");
+    assert(file != NULL);
+    while (fgets(line, sizeof(line), file) != NULL) { assert(line[strlen(line) - 1] == '\n'); }
+    assert(strstr(line, "ROTATION 199\n") != NULL);
+    fclose(file);
+
+    Logger_destroy();
+
+    assert(Logger_setRotation(4u << 20, 4) == OK);
+
+    printf("Segments rotated at their size test success...\n");
+}
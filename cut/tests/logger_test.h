@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: logger_test.h                       
+    PURPOSE: interface for logger test module 
+*/
+
+#ifndef LOGGER_TEST
+#define LOGGER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_logger(void);
+
+#endif 
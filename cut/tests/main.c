@@ -9,11 +9,24 @@
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "notifier_test.h"
+#include "logger_test.h"
+#include "buffer_test.h"
+#include "pool_test.h"
+#include "compute_test.h"
+#include "scheduler_test.h"
+#include "supervisor_test.h"
+#include "histogram_test.h"
+#include "reader_test.h"
+#include "tracker_test.h"
+#include "screen_test.h"
+#include "printer_test.h"
+#include "sink_test.h"
+#include "metrics_test.h"
 
 /*
     METHOD: main
     ARGUMENTS: none
-    PURPOSE: invocation of behaviour expected from Notifier tests
+    PURPOSE: invocation of behaviour expected from all tests
     RETURN: an integer number describing correction 
         of this function's execution
 */
@@ -22,6 +35,20 @@ int main(
 ) {
 
     test_notifier();
+    test_logger();
+    test_buffer();
+    test_pool();
+    test_compute();
+    test_scheduler();
+    test_supervisor();
+    test_supervisor_policies();
+    test_histogram();
+    test_reader();
+    test_screen();
+    test_printer();
+    test_sink();
+    test_metrics();
+    test_tracker();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics_test.c                       
+    PURPOSE: testing metrics module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <string.h>      
+#include <stdatomic.h>      
+#include <stdbool.h>      
+#include <assert.h>     
+#include <errno.h>     
+#include <unistd.h>     
+#include <pthread.h> 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "metrics_test.h"
+#include "alloc_hook.h"
+#include "../inc/metrics.h"
+#include "../inc/buffer.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define PROC 2
+#define WIDE 64
+#define ROUNDS 200
+#define RESPONSE_SIZE (64u << 10)
+#define SERVES 1000
+#define GET "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n"
+
+// STRUCTURE FOR HOLDING PARAMS PASSED TO PUBLISHER THREAD
+typedef struct PublisherParams {
+    Metrics* metrics;
+    ConvertedStats* stats;
+    atomic_bool stop;
+    char padding[7];
+} PublisherParams;
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void test_metrics_fill(ConvertedStats* const, uint16_t const, float const);
+static size_t test_metrics_scrape(Metrics* const, char const* const, char* const, bool const);
+static void* test_metrics_publisher(void* const);
+static bool test_metrics_consistent(char const* const);
+
+/*
+    METHOD: test_metrics_fill
+    ARGUMENTS:
+        stats - a record to be filled
+        proc - number of its cores, the last one is offline
+        value - every percentage of aggregate cpu and of online cores
+    PURPOSE: filling of a record with aggregate cpu, online cores,
+        row N + 1 is core N + 2, and an offline one
+    RETURN: nothing
+*/
+static void test_metrics_fill(
+    ConvertedStats* const stats,
+    uint16_t const proc,
+    float const value
+) {
+    uint16_t* ids;
+
+    memset(stats, 0, CONVERTED_SIZE(proc));
+
+    stats -> timestamp = 0;
+    stats -> count = proc;
+
+    ids = CONVERTED_IDS(stats);
+    ids[0] = 0;
+    ids[proc] = STATS_OFFLINE;
+
+    for (uint16_t row = 1; row < proc; row++) { ids[row] = (uint16_t) (row + 2); }
+
+    for (size_t row = 0; row < proc; row++) {
+        stats -> percentages[row] = value;
+
+        for (int column = 0; column < COLUMNS; column++) { CONVERTED_COLUMN(stats, column)[row] = value; }
+    }
+}
+
+/*
+    METHOD: test_metrics_scrape
+    ARGUMENTS:
+        metrics - a Metrics object to be scraped
+        request - a request sent as it is
+        output - where a response is saved, RESPONSE_SIZE bytes long
+        serve - true to serve it on a calling thread between reads,
+            false when a thread of its own serves it
+    PURPOSE: sending of a request over a loopback connection and reading
+        of a response until the server closes it
+    RETURN: length of a response
+*/
+static size_t test_metrics_scrape(
+    Metrics* const metrics,
+    char const* const request,
+    char* const output,
+    bool const serve
+) {
+    struct sockaddr_in server;
+    ssize_t received;
+    size_t length;
+    int fd;
+
+    server = (struct sockaddr_in) { .sin_family = AF_INET, .sin_port = htons(Metrics_port(metrics)) };
+    assert(inet_pton(AF_INET, "127.0.0.1", &(server.sin_addr)) == 1);
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    assert(fd >= 0);
+    assert(connect(fd, (struct sockaddr*) &server, sizeof(server)) == 0);
+    assert(send(fd, request, strlen(request), MSG_NOSIGNAL) == (ssize_t) strlen(request));
+
+    length = 0;
+
+    for (int i = 0; i < SERVES; i++) {
+        received = recv(fd, output + length, RESPONSE_SIZE - 1 - length, serve ? MSG_DONTWAIT : 0);
+
+        if (received == 0) { break; }
+
+        if (received > 0) {
+            length += (size_t) received;
+            continue;
+        }
+
+        assert(serve && (errno == EAGAIN || errno == EWOULDBLOCK));
+        assert(Metrics_serve(metrics, 10) == OK);
+    }
+
+    close(fd);
+
+    output[length] = '\0';
+
+    return length;
+}
+
+/*
+    METHOD: test_metrics_publisher
+    ARGUMENTS:
+        args - params shared with scraping thread
+    PURPOSE: thread publishing records of WIDE cores whose every percentage is the same,
+        a different one every time, until it is stopped
+    RETURN: NULL
+*/
+static void* test_metrics_publisher(
+    void* const args
+) {
+    PublisherParams* params;
+    float value;
+
+    params = (PublisherParams*) args;
+    value = 0.0f;
+
+    while (!atomic_load(&(params -> stop))) {
+        test_metrics_fill(params -> stats, WIDE, value);
+        Metrics_publish(params -> metrics, params -> stats);
+
+        value = value < 1000.0f ? value + 1.0f : 0.0f;
+    }
+
+    return NULL;
+}
+
+/*
+    METHOD: test_metrics_consistent
+    ARGUMENTS:
+        response - a response to a scrape
+    PURPOSE: check that every cpu sample of a response has the same value,
+        which holds only when it was rendered from a single record
+    RETURN: true when every value is the same, false otherwise
+*/
+static bool test_metrics_consistent(
+    char const* const response
+) {
+    char const* line;
+    char const* value;
+    char const* first;
+    size_t length;
+
+    first = NULL;
+    length = 0;
+
+    for (line = strstr(response, "\ncut_cpu_"); line != NULL; line = strstr(line + 1, "\ncut_cpu_")) {
+        value = strchr(line, ' ') + 1;
+
+        if (first == NULL) {
+            first = value;
+            length = strcspn(value, "\n");
+        }
+
+        if (strcspn(value, "\n") != length || strncmp(value, first, length) != 0) { return false; }
+    }
+
+    return first != NULL;
+}
+
+/*
+    METHOD: test_metrics
+    ARGUMENTS: none
+    PURPOSE: testing that /metrics serves online rows of the last published
+        record and counters of watched buffers, that other requests are 
+        refused, that no scrape or publish allocates, that every scrape 
+        sees a single record while another thread publishes and that 
+        a serving thread of its own answers too
+    RETURN: nothing
+*/
+void test_metrics(
+    void
+) {
+    char output[RESPONSE_SIZE];
+    PublisherParams params;
+    ConvertedStats* stats;
+    Metrics* metrics;
+    Metrics* wide;
+    Buffer* buffer;
+    pthread_t thread;
+    size_t allocations;
+    size_t length;
+    char* body;
+
+    printf("Starting metrics test...\n");
+
+    assert(Metrics_init(NULL, 0, PROC) == NULL);
+    assert(Metrics_init("localhost", 0, PROC) == NULL);
+    assert(Metrics_init("127.0.0.1", 0, 0) == NULL);
+
+    stats = (ConvertedStats*) malloc(CONVERTED_SIZE(PROC));
+    assert(stats != NULL);
+
+    buffer = Buffer_init(sizeof(int), 4, BUFFER_SPSC);
+    assert(buffer != NULL);
+
+    metrics = Metrics_init("127.0.0.1", 0, PROC);
+    assert(metrics != NULL);
+    assert(Metrics_port(metrics) != 0);
+    assert(Metrics_fd(metrics) >= 0);
+    assert(Metrics_watchBuffer(metrics, "test", buffer) == OK);
+
+    length = test_metrics_scrape(metrics, GET, output, true);
+    assert(strncmp(output, "HTTP/1.1 200 OK\r\n", 17) == 0);
+    assert(strstr(output, "cut_cpu_usage_percent") == NULL);
+    assert(strstr(output, "\ncut_samples_total 0\n") != NULL);
+    assert(strstr(output, "\ncut_buffer_capacity{buffer=\"test\"} 4\n") != NULL);
+    printf("Metrics before any record test success...\n");
+
+    test_metrics_fill(stats, PROC, 12.5f);
+    CONVERTED_COLUMN(stats, COLUMN_NICE)[0] = 2.0f / 3.0f;
+    stats -> percentages[1] = 100.0f;
+    Metrics_publish(metrics, stats);
+
+    length = test_metrics_scrape(metrics, GET, output, true);
+    body = strstr(output, "\r\n\r\n") + 4;
+
+    assert(strstr(output, "Content-Type: text/plain; version=0.0.4") != NULL);
+    assert(strstr(output, "Content-Length: ") != NULL);
+    assert(strtoul(strstr(output, "Content-Length: ") + 16, NULL, 10) == length - (size_t) (body - output));
+    assert(strstr(body, "\ncut_cpu_usage_percent{cpu=\"all\"} 12.50\n") != NULL);
+    assert(strstr(body, "\ncut_cpu_usage_percent{cpu=\"3\"} 100.00\n") != NULL);
+    assert(strstr(body, "\ncut_cpu_mode_percent{cpu=\"all\",mode=\"nice\"} 0.67\n") != NULL);
+    assert(strstr(body, "\ncut_cpu_mode_percent{cpu=\"3\",mode=\"guest_nice\"} 12.50\n") != NULL);
+    assert(strstr(body, "cpu=\"65535\"") == NULL);
+    assert(strstr(body, "\ncut_samples_total 1\n") != NULL);
+    assert(strstr(body, "\ncut_scrapes_total 2\n") != NULL);
+    printf("Metrics of online rows test success...\n");
+
+    length = test_metrics_scrape(metrics, "HEAD /metrics?x=1 HTTP/1.0\n\n", output, true);
+    assert(strncmp(output, "HTTP/1.1 200 OK\r\n", 17) == 0);
+    assert(strcmp(output + length - 4, "\r\n\r\n") == 0);
+
+    test_metrics_scrape(metrics, "GET /other HTTP/1.1\r\n\r\n", output, true);
+    assert(strncmp(output, "HTTP/1.1 404 ", 13) == 0);
+
+    test_metrics_scrape(metrics, "POST /metrics HTTP/1.1\r\nContent-Length: 0\r\n\r\n", output, true);
+    assert(strncmp(output, "HTTP/1.1 405 ", 13) == 0);
+
+    test_metrics_scrape(metrics, "GET\r\n\r\n", output, true);
+    assert(strncmp(output, "HTTP/1.1 400 ", 13) == 0);
+    printf("Metrics refusing other requests test success...\n");
+
+    allocations = test_allocations();
+
+    for (int i = 0; i < ROUNDS; i++) {
+        Metrics_publish(metrics, stats);
+        assert(test_metrics_scrape(metrics, GET, output, true) > 0);
+    }
+
+    assert(test_allocations() == allocations);
+    printf("Metrics without allocations test success...\n");
+
+    // RECORDS OF MANY CORES TAKE LONG ENOUGH TO COPY FOR A SCRAPE TO OVERLAP A PUBLISH
+    wide = Metrics_init("127.0.0.1", 0, WIDE);
+    assert(wide != NULL);
+
+    params = (PublisherParams) { 
+        .metrics = wide, 
+        .stats = (ConvertedStats*) malloc(CONVERTED_SIZE(WIDE)), 
+        .stop = ATOMIC_VAR_INIT(false) 
+    };
+    assert(params.stats != NULL);
+
+    // EVERY RECORD PUBLISHED FROM NOW ON HAS THE SAME VALUE IN EVERY ROW
+    test_metrics_fill(params.stats, WIDE, 0.0f);
+    Metrics_publish(wide, params.stats);
+
+    assert(pthread_create(&thread, NULL, test_metrics_publisher, &params) == 0);
+
+    for (int i = 0; i < ROUNDS; i++) {
+        test_metrics_scrape(wide, GET, output, true);
+        assert(test_metrics_consistent(output));
+    }
+
+    atomic_store(&(params.stop), true);
+    assert(pthread_join(thread, NULL) == 0);
+
+    Metrics_destroy(wide);
+    free(params.stats);
+    printf("Metrics of a single record while publishing test success...\n");
+
+    assert(Metrics_start(metrics) == OK);
+    assert(Metrics_start(metrics) == ERR_RUN);
+    assert(Metrics_watchBuffer(metrics, "late", buffer) == ERR_RUN);
+
+    test_metrics_scrape(metrics, GET, output, false);
+    assert(strncmp(output, "HTTP/1.1 200 OK\r\n", 17) == 0);
+    assert(strstr(output, "\ncut_cpu_usage_percent{cpu=\"all\"} 12.50\n") != NULL);
+
+    assert(Metrics_join(metrics) == OK);
+    printf("Metrics served by a thread test success...\n");
+
+    Metrics_destroy(metrics);
+    Buffer_destroy(buffer);
+    free(stats);
+
+    printf("Metrics test finished !\n");
+}
@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: metrics_test.h                       
+    PURPOSE: interface for metrics test module 
+*/
+
+#ifndef METRICS_TEST
+#define METRICS_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_metrics(void);
+
+#endif 
@@ -8,6 +8,7 @@
 #include <stdio.h>      
 #include <assert.h>     
 #include <stdbool.h> 
+#include <stdint.h> 
 
 // INCLUDES OF INSIDE LIBRARIES
 #include "notifier_test.h"
@@ -39,6 +40,13 @@ void test_notifier(
     assert(result == false);
     printf("Check variable set test success...\n");
 
+    uint64_t last = Notifier_last(notifier);
+
+    Notifier_notify(notifier);
+
+    assert(last > 0 && Notifier_last(notifier) >= last);
+    printf("Heartbeat timestamp test success...\n");
+
     printf("Notifier test finished !\n");
 
     Notifier_destroy(notifier);
@@ -0,0 +1,125 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: pool_test.c                       
+    PURPOSE: testing pool module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <assert.h>     
+#include <pthread.h> 
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "pool_test.h"
+#include "alloc_hook.h"
+#include "../inc/buffer.h"
+#include "../inc/enums.h"
+#include "../inc/pool.h"
+
+// MACRO DEFINITION
+#define ROUNDS 100000
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* test_pool_releaser(void* const);
+
+// STRUCTURE FOR HOLDING PARAMS PASSED TO RELEASER THREAD
+typedef struct ReleaserParams {
+    Pool* pool;
+    Buffer* buffer;
+} ReleaserParams;
+
+/*
+    METHOD: test_pool_releaser
+    ARGUMENTS:
+        args - pool and buffer shared with acquiring thread
+    PURPOSE: thread releasing blocks acquired by another thread
+    RETURN: NULL
+*/
+static void* test_pool_releaser(
+    void* const args
+) {
+    ReleaserParams* params;
+    uint64_t* block;
+    uint64_t expected;
+
+    params = (ReleaserParams*) args;
+    expected = 0;
+
+    while (Buffer_pop(params -> buffer, &block) == OK) {
+        assert(*block == expected++);
+        assert(Pool_release(params -> pool, block) == OK);
+    }
+
+    assert(expected == ROUNDS);
+
+    return NULL;
+}
+
+/*
+    METHOD: test_pool
+    ARGUMENTS: none
+    PURPOSE: testing exhaustion and reuse of pool blocks, cross-thread 
+        release and lack of heap allocation once a pool exists
+    RETURN: nothing
+*/
+void test_pool(
+    void
+) {
+    Pool* pool;
+    Buffer* buffer;
+    ReleaserParams params;
+    pthread_t thread;
+    uint64_t* blocks[4];
+    uint64_t* block;
+    size_t allocations;
+    uint64_t i;
+
+    printf("Starting pool test...\n");
+
+    pool = Pool_init(sizeof(uint64_t), 4);
+    assert(pool != NULL);
+
+    for (i = 0; i < 4; i++) {
+        blocks[i] = (uint64_t*) Pool_acquire(pool);
+        assert(blocks[i] != NULL && (uintptr_t) blocks[i] % 64 == 0);
+    }
+
+    assert(Pool_acquire(pool) == NULL && Pool_available(pool) == 0);
+    assert(Pool_release(pool, blocks[2]) == OK);
+    assert(Pool_acquire(pool) == blocks[2]);
+    assert(Pool_release(pool, (uint8_t*) blocks[1] + 1) == ERR_PARAMS);
+    printf("Exhaustion and reuse test success...\n");
+
+    for (i = 0; i < 4; i++) {
+        assert(Pool_release(pool, blocks[i]) == OK);
+    }
+
+    buffer = Buffer_init(sizeof(uint64_t*), 2, BUFFER_SPSC);
+    assert(buffer != NULL);
+
+    params = (ReleaserParams) { .pool = pool, .buffer = buffer };
+
+    assert(pthread_create(&thread, NULL, test_pool_releaser, &params) == 0);
+
+    allocations = test_allocations();
+
+    for (i = 0; i < ROUNDS; i++) {
+        while ((block = (uint64_t*) Pool_acquire(pool)) == NULL) {}
+
+        *block = i;
+        assert(Buffer_push(buffer, &block) == OK);
+    }
+
+    assert(test_allocations() == allocations);
+
+    Buffer_close(buffer);
+    assert(pthread_join(thread, NULL) == 0);
+    assert(Pool_available(pool) == 4);
+    printf("Cross-thread release without allocation test success...\n");
+
+    Buffer_destroy(buffer);
+    Pool_destroy(pool);
+
+    printf("Pool test finished !\n");
+}
@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: pool_test.h                       
+    PURPOSE: interface for pool test module 
+*/
+
+#ifndef POOL_TEST
+#define POOL_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_pool(void);
+
+#endif
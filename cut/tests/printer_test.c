@@ -0,0 +1,106 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: printer_test.c                       
+    PURPOSE: testing printer module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <string.h>      
+#include <assert.h>     
+#include <fcntl.h>     
+#include <unistd.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "printer_test.h"
+#include "../inc/printer.h"
+#include "../inc/buffer.h"
+#include "../inc/pool.h"
+#include "../inc/histogram.h"
+#include "../inc/scheduler.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define PROC 16
+
+/*
+    METHOD: test_printer
+    ARGUMENTS: none
+    PURPOSE: testing that bars of more cores than terminal has rows 
+        are cut to its height, with cores left out counted in a row
+    RETURN: nothing
+*/
+void test_printer(
+    void
+) {
+    char output[4096];
+    ConvertedStats* converted;
+    Histogram* latency;
+    Printer* printer;
+    Buffer* buffer;
+    Pool* pool;
+    ssize_t length;
+    int fds[2];
+    int saved;
+
+    printf("Starting printer test...\n");
+
+    buffer = Buffer_init(sizeof(ConvertedStats*), 1, BUFFER_MPMC);
+    pool = Pool_init(CONVERTED_SIZE(PROC), 1);
+    latency = Histogram_init();
+    assert(buffer != NULL && pool != NULL && latency != NULL);
+
+    printer = Printer_init(buffer, pool, latency, PROC);
+    assert(printer != NULL);
+
+    converted = (ConvertedStats*) Pool_acquire(pool);
+    assert(converted != NULL);
+
+    memset(converted, 0, CONVERTED_SIZE(PROC));
+    converted -> count = PROC;
+    converted -> timestamp = Scheduler_now();
+
+    for (uint16_t row = 0; row <= PROC; row++) { CONVERTED_IDS(converted)[row] = row == 0 ? 0 : (uint16_t) (row - 1); }
+
+    assert(Buffer_push(buffer, &converted) == OK);
+
+    // A PIPE IS NOT A TERMINAL, SO ITS SIZE IS TAKEN FROM ENVIRONMENT, FRAME IS WRITTEN TO STANDARD OUTPUT
+    setenv("LINES", "10", 1);
+    setenv("COLUMNS", "60", 1);
+
+    assert(pipe(fds) == 0);
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    assert(saved >= 0 && dup2(fds[1], STDOUT_FILENO) == STDOUT_FILENO);
+
+    assert(Printer_step(printer, false) == OK);
+
+    assert(dup2(saved, STDOUT_FILENO) == STDOUT_FILENO);
+    close(saved);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    // TWO CORES, A COUNT OF FOURTEEN OTHERS AND A FOOTER ON THE LAST ROW
+    assert(strstr(output, "\033[6;1Hcpu0:") != NULL && strstr(output, "\033[7;1Hcpu1:") != NULL);
+    assert(strstr(output, "cpu2:") == NULL);
+    assert(strstr(output, "\033[8;1H+14 more") != NULL);
+    assert(strstr(output, "\033[10;1H================ TRACKER") != NULL);
+    assert(strstr(output, "\033[11;1H================") == NULL);
+    printf("Bars cut to terminal height test success...\n");
+
+    unsetenv("LINES");
+    unsetenv("COLUMNS");
+
+    Printer_destroy(printer);
+    Histogram_destroy(latency);
+    Pool_destroy(pool);
+    Buffer_destroy(buffer);
+    close(fds[0]);
+    close(fds[1]);
+
+    printf("Printer test finished !\n");
+}
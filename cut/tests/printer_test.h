@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: printer_test.h                       
+    PURPOSE: interface for printer test module 
+*/
+
+#ifndef PRINTER_TEST
+#define PRINTER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_printer(void);
+
+#endif 
@@ -0,0 +1,354 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: reader_test.c                       
+    PURPOSE: testing reader module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <stdint.h>      
+#include <assert.h>     
+#include <signal.h>     
+#include <unistd.h>     
+#include <fcntl.h>     
+#include <sys/stat.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "reader_test.h"
+#include "../inc/reader.h"
+#include "../inc/buffer.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+#include "../inc/scheduler.h"
+#include "../inc/status.h"
+
+// MACRO DEFINITION
+#define STAT_PATH "/tmp/cut_test_reader_stat"
+#define FIFO_PATH "/tmp/cut_test_reader_fifo"
+#define PROC 5
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void test_reader_write(unsigned const* const, size_t const);
+static void test_reader_hotplug(int const);
+static void test_reader_restart(void);
+static void test_reader_stuck(void);
+static void test_reader_abandoned(void);
+
+/*
+    METHOD: test_reader_write
+    ARGUMENTS:
+        ids - ids of cpus to be listed, in a given order
+        count - number of given ids
+    PURPOSE: creation of a stat file whose cpuN line has user time 
+        of 100 * (N + 1) and which is followed by other lines
+    RETURN: nothing
+*/
+static void test_reader_write(
+    unsigned const* const ids,
+    size_t const count
+) {
+    FILE* file;
+
+    file = fopen(STAT_PATH, "w");
+    assert(file != NULL);
+
+    fprintf(file, "cpu  1000 0 500 9000 0 0 0 0 0 0\n");
+
+    for (size_t i = 0; i < count; i++) {
+        fprintf(file, "cpu%u %u 0 50 900 0 0 0 0 0 0\n", ids[i], 100 * (ids[i] + 1));
+    }
+
+    fprintf(file, "intr 1234 0 9\nctxt 98765\n");
+
+    fclose(file);
+}
+
+/*
+    METHOD: test_reader_hotplug
+    ARGUMENTS:
+        mode - reader mode to be tested
+    PURPOSE: testing that cpus going offline, coming back and showing up 
+        with sparse ids keep rows of other cpus and do not fail a read
+    RETURN: nothing
+*/
+static void test_reader_hotplug(
+    int const mode
+) {
+    unsigned const all[] = { 0, 1, 2, 3 };
+    unsigned const without[] = { 0, 1, 3 };
+    unsigned const sparse[] = { 0, 1, 2, 3, 7, 9 };
+    Buffer* buffer;
+    Reader* reader;
+    ProcessorStats* stats;
+    uint16_t const* ids;
+
+    stats = malloc(STATS_SIZE(PROC));
+    assert(stats != NULL);
+
+    test_reader_write(all, 4);
+
+    buffer = Buffer_init(sizeof(ProcessorStats), 1, BUFFER_MPMC);
+    reader = Reader_init(buffer, NULL, PROC, STAT_PATH, mode);
+    assert(buffer != NULL && reader != NULL);
+
+    assert(Reader_read(reader, stats) == OK);
+    assert(stats -> count == PROC);
+
+    ids = STATS_IDS(stats);
+    assert(ids[0] == 0 && ids[1] == 0 && ids[2] == 1 && ids[3] == 2 && ids[4] == 3);
+    assert(ids[5] == STATS_OFFLINE);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[0] == 1000);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[4] == 400);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[5] == 0);
+
+    test_reader_write(without, 3);
+
+    assert(Reader_read(reader, stats) == OK);
+    assert(ids[1] == 0 && ids[2] == 1 && ids[3] == STATS_OFFLINE && ids[4] == 3);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[3] == 0);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[4] == 400);
+    printf("Offline cpu keeps other rows test success...\n");
+
+    test_reader_write(sparse, 6);
+
+    assert(Reader_read(reader, stats) == OK);
+    assert(ids[3] == 2 && ids[4] == 3 && ids[5] == 7);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[3] == 300);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[5] == 800);
+    printf("Returning and sparse cpus mapped test success...\n");
+
+    test_reader_write(without, 3);
+
+    assert(Reader_read(reader, stats) == OK);
+    assert(ids[3] == STATS_OFFLINE && ids[5] == STATS_OFFLINE && ids[4] == 3);
+
+    test_reader_write(sparse, 6);
+
+    assert(Reader_read(reader, stats) == OK);
+    assert(ids[5] == 7 && STATS_COLUMN(stats, COLUMN_USER)[5] == 800);
+    printf("Cpu without free row skipped test success...\n");
+
+    Reader_destroy(reader);
+    Buffer_destroy(buffer);
+    free(stats);
+    remove(STAT_PATH);
+}
+
+/*
+    METHOD: test_reader_restart
+    ARGUMENTS: none
+    PURPOSE: testing that a restarted reader's thread goes on reading 
+        into the same buffer and that it can only be restarted once started
+    RETURN: nothing
+*/
+static void test_reader_restart(
+    void
+) {
+    unsigned const all[] = { 0, 1, 2, 3 };
+    Buffer* buffer;
+    Scheduler* scheduler;
+    Reader* reader;
+    ProcessorStats* stats;
+    volatile sig_atomic_t status;
+    uint64_t before;
+
+    stats = malloc(STATS_SIZE(PROC));
+    assert(stats != NULL);
+
+    test_reader_write(all, 4);
+
+    buffer = Buffer_init(STATS_SIZE(PROC), 4, BUFFER_SPSC);
+    scheduler = Scheduler_init(10);
+    reader = Reader_init(buffer, scheduler, PROC, STAT_PATH, READER_PERSISTENT);
+    assert(buffer != NULL && scheduler != NULL && reader != NULL);
+
+    status = RUNNING;
+
+    assert(Reader_restart(reader) == ERR_PARAMS);
+    assert(Reader_start(reader, &status) == OK);
+    assert(Reader_start(reader, &status) == ERR_PARAMS);
+
+    assert(Buffer_pop(buffer, stats) == OK);
+    before = stats -> timestamp;
+
+    assert(Reader_restart(reader) == OK);
+
+    // SAMPLES TAKEN BEFORE RESTART MAY STILL BE WAITING IN BUFFER
+    for (int i = 0; i < 5; i++) { assert(Buffer_pop(buffer, stats) == OK); }
+
+    assert(stats -> timestamp > before);
+    assert(STATS_COLUMN(stats, COLUMN_USER)[4] == 400);
+    assert(status == RUNNING);
+    printf("Restarted reader goes on reading test success...\n");
+
+    Status_set(&status, TERMINATED);
+    Buffer_close(buffer);
+
+    assert(Reader_join(reader, 1000) == OK);
+    assert(Reader_join(reader, 1000) == ERR_PARAMS);
+
+    Reader_destroy(reader);
+    Scheduler_destroy(scheduler);
+    Buffer_destroy(buffer);
+    free(stats);
+    remove(STAT_PATH);
+}
+
+/*
+    METHOD: test_reader_stuck
+    ARGUMENTS: none
+    PURPOSE: testing that a reader's thread stuck in a read is replaced 
+        without waiting for it, that a new one goes on reading while 
+        the old one is still stuck, and that the old one ends quietly
+    RETURN: nothing
+*/
+static void test_reader_stuck(
+    void
+) {
+    unsigned const all[] = { 0, 1, 2, 3 };
+    struct timespec deadline;
+    Buffer* buffer;
+    Scheduler* scheduler;
+    Reader* reader;
+    ProcessorStats* stats;
+    volatile sig_atomic_t status;
+    uint64_t start;
+    int writer;
+
+    stats = malloc(STATS_SIZE(PROC));
+    assert(stats != NULL);
+
+    remove(FIFO_PATH);
+    assert(mkfifo(FIFO_PATH, 0600) == 0);
+
+    // WITH A WRITER WHICH NEVER WRITES, READER'S OPEN GOES THROUGH AND ITS READ WAITS FOREVER
+    writer = open(FIFO_PATH, O_RDWR);
+    assert(writer >= 0);
+
+    buffer = Buffer_init(STATS_SIZE(PROC), 4, BUFFER_SPSC);
+    scheduler = Scheduler_init(10);
+    reader = Reader_init(buffer, scheduler, PROC, FIFO_PATH, READER_STREAM);
+    assert(buffer != NULL && scheduler != NULL && reader != NULL);
+
+    status = RUNNING;
+
+    assert(Reader_start(reader, &status) == OK);
+
+    usleep(100000);
+    assert(Buffer_isEmpty(buffer));
+
+    // OLD THREAD KEEPS WAITING ON A FIFO, WHILE ITS PATH NOW LEADS TO A REGULAR FILE
+    test_reader_write(all, 4);
+    assert(rename(STAT_PATH, FIFO_PATH) == 0);
+
+    start = Scheduler_now();
+    assert(Reader_restart(reader) == OK);
+    assert(Scheduler_now() - start < 50000000u);
+    printf("Stuck reader replaced without waiting for it test success...\n");
+
+    for (int i = 0; i < 3; i++) {
+        Status_deadline(&deadline, 1000);
+        assert(Buffer_popTimed(buffer, stats, &deadline) == OK);
+    }
+
+    assert(STATS_COLUMN(stats, COLUMN_USER)[4] == 400);
+    printf("New reader reads while old one is stuck test success...\n");
+
+    // OLD THREAD'S READ ENDS WITH NOTHING READ, WHICH IT DROPS WITHOUT ENDING THE PIPELINE
+    close(writer);
+    usleep(50000);
+
+    Status_deadline(&deadline, 1000);
+    assert(Buffer_popTimed(buffer, stats, &deadline) == OK);
+    assert(status == RUNNING);
+    printf("Stuck reader ends quietly test success...\n");
+
+    Status_set(&status, TERMINATED);
+    Buffer_close(buffer);
+
+    assert(Reader_join(reader, 1000) == OK);
+
+    Reader_destroy(reader);
+    Scheduler_destroy(scheduler);
+    Buffer_destroy(buffer);
+    free(stats);
+    remove(FIFO_PATH);
+}
+
+/*
+    METHOD: test_reader_abandoned
+    ARGUMENTS: none
+    PURPOSE: testing that a join gives up on a replaced thread stuck 
+        past its timeout, leaving reader to it instead of hanging
+    RETURN: nothing
+*/
+static void test_reader_abandoned(
+    void
+) {
+    unsigned const all[] = { 0, 1, 2, 3 };
+    Buffer* buffer;
+    Scheduler* scheduler;
+    Reader* reader;
+    volatile sig_atomic_t status;
+    uint64_t start;
+    int writer;
+
+    remove(FIFO_PATH);
+    assert(mkfifo(FIFO_PATH, 0600) == 0);
+
+    writer = open(FIFO_PATH, O_RDWR);
+    assert(writer >= 0);
+
+    buffer = Buffer_init(STATS_SIZE(PROC), 4, BUFFER_SPSC);
+    scheduler = Scheduler_init(10);
+    reader = Reader_init(buffer, scheduler, PROC, FIFO_PATH, READER_STREAM);
+    assert(buffer != NULL && scheduler != NULL && reader != NULL);
+
+    status = RUNNING;
+
+    assert(Reader_start(reader, &status) == OK);
+    usleep(50000);
+
+    test_reader_write(all, 4);
+    assert(rename(STAT_PATH, FIFO_PATH) == 0);
+    assert(Reader_restart(reader) == OK);
+
+    Status_set(&status, TERMINATED);
+    Buffer_close(buffer);
+
+    start = Scheduler_now();
+    assert(Reader_join(reader, 50) == ERR_TIMEOUT);
+    assert(Scheduler_now() - start < 500000000u);
+    printf("Join gives up on a stuck replaced reader test success...\n");
+
+    // READER IS LEAKED TO OLD THREAD, WHICH ENDS ONCE ITS READ RETURNS
+    Reader_destroy(reader);
+    Scheduler_destroy(scheduler);
+    Buffer_destroy(buffer);
+
+    close(writer);
+    usleep(50000);
+    remove(FIFO_PATH);
+}
+
+/*
+    METHOD: test_reader
+    ARGUMENTS: none
+    PURPOSE: testing reader's handling of cpu hotplug in both modes
+        and restart of its thread, healthy and stuck
+    RETURN: nothing
+*/
+void test_reader(
+    void
+) {
+    printf("Starting reader test...\n");
+
+    test_reader_hotplug(READER_STREAM);
+    test_reader_hotplug(READER_PERSISTENT);
+    test_reader_restart();
+    test_reader_stuck();
+    test_reader_abandoned();
+
+    printf("Reader test finished !\n");
+}
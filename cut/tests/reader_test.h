@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: reader_test.h                       
+    PURPOSE: interface for reader test module 
+*/
+
+#ifndef READER_TEST
+#define READER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_reader(void);
+
+#endif
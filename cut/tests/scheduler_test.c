@@ -0,0 +1,71 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scheduler_test.c                       
+    PURPOSE: testing scheduler module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <assert.h>     
+#include <signal.h> 
+#include <unistd.h> 
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "scheduler_test.h"
+#include "../inc/scheduler.h"
+#include "../inc/status.h"
+#include "../inc/enums.h"
+
+/*
+    METHOD: test_scheduler
+    ARGUMENTS: none
+    PURPOSE: testing that work time does not shift ticks, that late 
+        ticks are counted as missed and that status change ends a wait
+    RETURN: nothing
+*/
+void test_scheduler(
+    void
+) {
+    Scheduler* scheduler;
+    volatile sig_atomic_t status;
+    uint64_t start;
+    uint64_t elapsed;
+
+    printf("Starting scheduler test...\n");
+
+    assert(Scheduler_init(SCHEDULER_MIN_INTERVAL - 1) == NULL);
+    assert(Scheduler_init(SCHEDULER_MAX_INTERVAL + 1) == NULL);
+
+    scheduler = Scheduler_init(10);
+    assert(scheduler != NULL);
+
+    status = RUNNING;
+
+    assert(Scheduler_wait(scheduler, &status) == OK);
+    start = Scheduler_now();
+
+    for (int tick = 0; tick < 20; tick++) {
+        usleep(5000);
+        assert(Scheduler_wait(scheduler, &status) == OK);
+    }
+
+    elapsed = (Scheduler_now() - start) / 1000000u;
+
+    assert(elapsed >= 199 && elapsed < 260);
+    assert(Scheduler_missed(scheduler) == 0);
+    printf("20 ticks with work in %lu ms test success...\n", (unsigned long) elapsed);
+
+    usleep(35000);
+    assert(Scheduler_wait(scheduler, &status) == OK);
+    assert(Scheduler_missed(scheduler) == 2 || Scheduler_missed(scheduler) == 3);
+    printf("Missed ticks counted test success...\n");
+
+    Status_set(&status, TERMINATED);
+    assert(Scheduler_wait(scheduler, &status) == ERR_CLOSED);
+    printf("Status change ends wait test success...\n");
+
+    Scheduler_destroy(scheduler);
+
+    printf("Scheduler test finished !\n");
+}
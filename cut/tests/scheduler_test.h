@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: scheduler_test.h                       
+    PURPOSE: interface for scheduler test module 
+*/
+
+#ifndef SCHEDULER_TEST
+#define SCHEDULER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_scheduler(void);
+
+#endif
@@ -0,0 +1,132 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: screen_test.c                       
+    PURPOSE: testing screen module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <string.h>      
+#include <assert.h>     
+#include <fcntl.h>     
+#include <unistd.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "screen_test.h"
+#include "../inc/screen.h"
+#include "../inc/enums.h"
+
+/*
+    METHOD: test_screen
+    ARGUMENTS: none
+    PURPOSE: testing that a first frame is sent whole after a clear, 
+        an unchanged frame is not sent at all and a changed one 
+        is sent as its changed cells only, with a color escape only
+        where color changes, and that a frame follows terminal's size
+    RETURN: nothing
+*/
+void test_screen(
+    void
+) {
+    char output[256];
+    ScreenStats stats;
+    Screen* screen;
+    ssize_t length;
+    uint16_t rows;
+    uint16_t cols;
+    int fds[2];
+
+    printf("Starting screen test...\n");
+
+    assert(pipe(fds) == 0);
+    assert(fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+
+    assert(Screen_init(0, 10, fds[1]) == NULL);
+
+    screen = Screen_init(3, 10, fds[1]);
+    assert(screen != NULL);
+
+    assert(Screen_line(screen, 0, "cpu: %d%%", 42) == OK);
+    assert(Screen_line(screen, 2, "%s", "TOO LONG FOR A ROW") == OK);
+    assert(Screen_line(screen, 3, "OUT") == ERR_PARAMS);
+    assert(Screen_render(screen) == OK);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    assert(strcmp(output, "\033[H\033[2J\033[1;1Hcpu: 42%\033[3;1HTOO LONG F\033[4;1H") == 0);
+    printf("Whole first frame test success...\n");
+
+    Screen_clear(screen);
+    Screen_line(screen, 0, "cpu: %d%%", 42);
+    Screen_line(screen, 2, "%s", "TOO LONG FOR A ROW");
+    assert(Screen_render(screen) == OK);
+
+    assert(read(fds[0], output, sizeof(output)) < 0);
+    assert(Screen_stats(screen, &stats) == OK && stats.frames == 2 && stats.last == 0);
+    printf("Unchanged frame not sent test success...\n");
+
+    Screen_clear(screen);
+    Screen_line(screen, 0, "cpu: %d%%", 47);
+    Screen_line(screen, 2, "%s", "TOO");
+    assert(Screen_render(screen) == OK);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    assert(strcmp(output, "\033[1;7H7\033[3;5H      \033[4;1H") == 0);
+    assert(Screen_stats(screen, &stats) == OK && stats.last == (size_t) length);
+    printf("Changed cells only test success...\n");
+
+    Screen_invalidate(screen);
+    assert(Screen_render(screen) == OK);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    assert(strncmp(output, "\033[H\033[2J\033[1;1Hcpu: 47%", 21) == 0);
+    printf("Invalidated frame sent whole test success...\n");
+
+    assert(Screen_cell(screen, 1, 0, Screen_glyph("\xe2\x96\x88", 196)) == OK);
+    assert(Screen_cell(screen, 1, 1, Screen_glyph("\xe2\x96\x88", 196)) == OK);
+    assert(Screen_cell(screen, 1, 2, Screen_glyph("x", 0)) == OK);
+    assert(Screen_cell(screen, 1, 10, Screen_glyph("x", 0)) == ERR_PARAMS);
+    assert(Screen_render(screen) == OK);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    assert(strcmp(output, "\033[2;1H\033[38;5;196m\xe2\x96\x88\xe2\x96\x88\033[39mx\033[4;1H") == 0);
+    printf("Colored glyphs test success...\n");
+
+    // A PIPE IS NOT A TERMINAL, SO ITS SIZE IS TAKEN FROM ENVIRONMENT
+    setenv("LINES", "5", 1);
+    setenv("COLUMNS", "20", 1);
+
+    assert(Screen_fit(screen) == OK);
+    Screen_size(screen, &rows, &cols);
+    assert(rows == 5 && cols == 20);
+    assert(Screen_line(screen, 4, "%s", "LAST ROW") == OK);
+    assert(Screen_render(screen) == OK);
+
+    length = read(fds[0], output, sizeof(output) - 1);
+    assert(length > 0);
+    output[length] = '\0';
+
+    assert(strcmp(output, "\033[H\033[2J\033[5;1HLAST ROW\033[6;1H") == 0);
+    printf("Frame fitted to terminal test success...\n");
+
+    unsetenv("LINES");
+    unsetenv("COLUMNS");
+
+    Screen_destroy(screen);
+    close(fds[0]);
+    close(fds[1]);
+
+    printf("Screen test finished !\n");
+}
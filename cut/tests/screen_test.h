@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: screen_test.h                       
+    PURPOSE: interface for screen test module 
+*/
+
+#ifndef SCREEN_TEST
+#define SCREEN_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_screen(void);
+
+#endif 
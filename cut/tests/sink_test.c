@@ -0,0 +1,213 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink_test.c                       
+    PURPOSE: testing sink module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdlib.h>      
+#include <string.h>      
+#include <assert.h>     
+#include <fcntl.h>     
+#include <unistd.h>     
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "sink_test.h"
+#include "alloc_hook.h"
+#include "../inc/sink.h"
+#include "../inc/stats.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define SINK_PATH "/tmp/cut_test_sink"
+#define PROC 2
+#define ROUNDS 1000
+
+// RECORD OF TEST_SINK_FILL ENCODED BY EVERY FORMAT
+#define JSON_LINE \
+    "{\"timestamp\":123456789,\"all\":{\"usage\":12.50,\"user\":12.50,\"nice\":0.67,\"system\":0.00," \
+    "\"idle\":87.50,\"iowait\":0.00,\"irq\":0.00,\"softirq\":0.00,\"steal\":0.00,\"guest\":0.00,\"guest_nice\":0.00}," \
+    "\"cores\":[{\"id\":3,\"usage\":100.00,\"user\":100.00,\"nice\":0.00,\"system\":0.00,\"idle\":0.00," \
+    "\"iowait\":0.00,\"irq\":0.00,\"softirq\":0.00,\"steal\":0.00,\"guest\":0.00,\"guest_nice\":0.00}]}\n"
+#define CSV_LINES \
+    "123456789,all,12.50,12.50,0.67,0.00,87.50,0.00,0.00,0.00,0.00,0.00,0.00\n" \
+    "123456789,3,100.00,100.00,0.00,0.00,0.00,0.00,0.00,0.00,0.00,0.00,0.00\n"
+#define CSV_HEAD "timestamp,cpu,usage,user,nice,system,idle,iowait,irq,softirq,steal,guest,guest_nice\n"
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void test_sink_fill(ConvertedStats* const);
+static size_t test_sink_read(char* const, size_t const);
+
+/*
+    METHOD: test_sink_fill
+    ARGUMENTS:
+        stats - a record of PROC cores to be filled
+    PURPOSE: filling of a record with aggregate cpu, an online core 
+        and an offline one, with values rounded up, down and below zero
+    RETURN: nothing
+*/
+static void test_sink_fill(
+    ConvertedStats* const stats
+) {
+    uint16_t* ids;
+
+    memset(stats, 0, CONVERTED_SIZE(PROC));
+
+    stats -> timestamp = 123456789;
+    stats -> count = PROC;
+
+    ids = CONVERTED_IDS(stats);
+
+    stats -> percentages[0] = 12.5f;
+    CONVERTED_COLUMN(stats, COLUMN_USER)[0] = 12.5f;
+    CONVERTED_COLUMN(stats, COLUMN_NICE)[0] = 2.0f / 3.0f;
+    CONVERTED_COLUMN(stats, COLUMN_SYSTEM)[0] = -0.001f;
+    CONVERTED_COLUMN(stats, COLUMN_IDLE)[0] = 87.5f;
+    ids[0] = 0;
+
+    stats -> percentages[1] = 100.0f;
+    CONVERTED_COLUMN(stats, COLUMN_USER)[1] = 100.0f;
+    ids[1] = 3;
+
+    stats -> percentages[2] = 50.0f;
+    ids[2] = STATS_OFFLINE;
+}
+
+/*
+    METHOD: test_sink_read
+    ARGUMENTS:
+        output - where contents of SINK_PATH are saved
+        size - size of a given output
+    PURPOSE: reading of what a sink wrote
+    RETURN: number of bytes read
+*/
+static size_t test_sink_read(
+    char* const output,
+    size_t const size
+) {
+    ssize_t length;
+    int fd;
+
+    fd = open(SINK_PATH, O_RDONLY);
+    assert(fd >= 0);
+
+    length = read(fd, output, size);
+    assert(length >= 0);
+
+    close(fd);
+
+    return (size_t) length;
+}
+
+/*
+    METHOD: test_sink
+    ARGUMENTS: none
+    PURPOSE: testing that every format encodes online rows only, 
+        with percentages rounded to hundredths, that records are 
+        buffered until a flush or close, and that emitting a batch
+        allocates nothing
+    RETURN: nothing
+*/
+void test_sink(
+    void
+) {
+    char output[4096];
+    ConvertedStats* batch[2];
+    ConvertedStats* stats;
+    SinkHeader header;
+    SinkStats counters;
+    SinkRow row;
+    Sink* sink;
+    size_t allocations;
+    size_t length;
+
+    printf("Starting sink test...\n");
+
+    stats = (ConvertedStats*) malloc(CONVERTED_SIZE(PROC));
+    assert(stats != NULL);
+
+    test_sink_fill(stats);
+
+    batch[0] = stats;
+    batch[1] = stats;
+
+    assert(Sink_open(SINK_BINARY + 1, SINK_PATH, PROC) == NULL);
+    assert(Sink_open(SINK_JSON, SINK_PATH, 0) == NULL);
+    assert(Sink_open(SINK_JSON, "/nonexistent/sink", PROC) == NULL);
+
+    sink = Sink_open(SINK_JSON, SINK_PATH, PROC);
+    assert(sink != NULL);
+
+    assert(Sink_emit(sink, batch, 2) == OK);
+    assert(test_sink_read(output, sizeof(output)) == 0);
+    assert(Sink_flush(sink) == OK);
+
+    length = test_sink_read(output, sizeof(output) - 1);
+    output[length] = '\0';
+
+    assert(strcmp(output, JSON_LINE JSON_LINE) == 0);
+    assert(Sink_stats(sink, &counters) == OK && counters.records == 2 && counters.writes == 1);
+    assert(Sink_close(sink) == OK);
+    printf("JSON lines sink test success...\n");
+
+    sink = Sink_open(SINK_CSV, SINK_PATH, PROC);
+    assert(sink != NULL);
+
+    assert(Sink_emit(sink, batch, 1) == OK);
+    assert(Sink_close(sink) == OK);
+
+    length = test_sink_read(output, sizeof(output) - 1);
+    output[length] = '\0';
+
+    assert(strcmp(output, CSV_HEAD CSV_LINES) == 0);
+    printf("CSV sink test success...\n");
+
+    sink = Sink_open(SINK_BINARY, SINK_PATH, PROC);
+    assert(sink != NULL);
+
+    assert(Sink_emit(sink, batch, 1) == OK);
+    assert(Sink_close(sink) == OK);
+
+    assert(test_sink_read(output, sizeof(output)) == sizeof(SinkHeader) + 2 * sizeof(SinkRow));
+
+    memcpy(&header, output, sizeof(SinkHeader));
+    assert(header.magic == SINK_MAGIC && header.rows == 2 && header.columns == COLUMNS + 1);
+    assert(header.timestamp == 123456789);
+
+    memcpy(&row, output + sizeof(SinkHeader), sizeof(SinkRow));
+    assert(row.id == SINK_AGGREGATE && row.percentages[0] == 12.5f);
+    assert(row.percentages[1 + COLUMN_IDLE] == 87.5f);
+
+    memcpy(&row, output + sizeof(SinkHeader) + sizeof(SinkRow), sizeof(SinkRow));
+    assert(row.id == 3 && row.percentages[0] == 100.0f && row.percentages[1 + COLUMN_USER] == 100.0f);
+    printf("Binary sink test success...\n");
+
+    sink = Sink_open(SINK_JSON, "/dev/null", PROC);
+    assert(sink != NULL);
+
+    batch[1] = NULL;
+    assert(Sink_emit(sink, batch, 2) == ERR_PARAMS);
+    batch[1] = stats;
+
+    allocations = test_allocations();
+
+    for (int i = 0; i < ROUNDS; i++) {
+        assert(Sink_emit(sink, batch, 2) == OK);
+    }
+
+    assert(Sink_flush(sink) == OK);
+    assert(test_allocations() == allocations);
+
+    assert(Sink_stats(sink, &counters) == OK);
+    assert(counters.records == 2 * ROUNDS + 1);
+    assert(counters.bytes == (2 * ROUNDS + 1) * (sizeof(JSON_LINE) - 1));
+    assert(counters.writes > 1 && counters.writes < ROUNDS);
+    assert(Sink_close(sink) == OK);
+    printf("Sink batches without allocations test success...\n");
+
+    unlink(SINK_PATH);
+    free(stats);
+
+    printf("Sink test finished !\n");
+}
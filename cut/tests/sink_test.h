@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: sink_test.h                       
+    PURPOSE: interface for sink test module 
+*/
+
+#ifndef SINK_TEST
+#define SINK_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_sink(void);
+
+#endif 
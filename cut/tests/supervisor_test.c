@@ -0,0 +1,223 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: supervisor_test.c                       
+    PURPOSE: testing supervisor module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <stdint.h>      
+#include <string.h>      
+#include <stdbool.h>      
+#include <assert.h>     
+#include <signal.h> 
+#include <unistd.h> 
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "supervisor_test.h"
+#include "../inc/supervisor.h"
+#include "../inc/notifier.h"
+#include "../inc/scheduler.h"
+#include "../inc/enums.h"
+
+// STRUCTURE FOR HOLDING A FAKE STAGE RESTARTED BY SUPERVISOR
+typedef struct Restarted {
+    Notifier* notifier;
+    int calls;
+    int pending;
+} Restarted;
+
+// PROTOTYPE FUNCTIONS FOR INSIDE WORLD
+static int restart(void* const);
+
+/*
+    METHOD: restart
+    ARGUMENTS:
+        context - a fake stage to be restarted
+    PURPOSE: fake restart, which old thread stays stuck 
+        for a given number of first calls
+    RETURN: OK or ERR_TIMEOUT while old thread is stuck
+*/
+static int restart(
+    void* const context
+) {
+    Restarted* restarted;
+
+    restarted = (Restarted*) context;
+    restarted -> calls++;
+
+    if (restarted -> pending > 0) {
+        restarted -> pending--;
+        return ERR_TIMEOUT;
+    }
+
+    return OK;
+}
+
+/*
+    METHOD: test_supervisor
+    ARGUMENTS: none
+    PURPOSE: testing that beating stages are left alone, that a stage 
+        missing its sub-second deadline terminates status soon after
+        and that its stall is reported
+    RETURN: nothing
+*/
+void test_supervisor(
+    void
+) {
+    Supervisor* supervisor;
+    Notifier* fast;
+    Notifier* slow;
+    volatile sig_atomic_t status;
+    SupervisorStats stats;
+    uint64_t start;
+    uint64_t elapsed;
+    int fastStage;
+    int slowStage;
+
+    printf("Starting supervisor test...\n");
+
+    supervisor = Supervisor_init();
+    fast = Notifier_init();
+    slow = Notifier_init();
+    assert(supervisor != NULL && fast != NULL && slow != NULL);
+
+    assert(Supervisor_watch(supervisor, fast, "FAST", 0, SUPERVISOR_TERMINATE) == -1);
+    assert(Supervisor_watch(supervisor, NULL, "FAST", 50, SUPERVISOR_TERMINATE) == -1);
+    assert(Supervisor_watch(supervisor, fast, "FAST", 50, -1) == -1);
+
+    fastStage = Supervisor_watch(supervisor, fast, "FAST", 50, SUPERVISOR_TERMINATE);
+    slowStage = Supervisor_watch(supervisor, slow, "SLOW", 200, SUPERVISOR_TERMINATE);
+    assert(fastStage == 0 && slowStage == 1);
+
+    status = RUNNING;
+
+    assert(Supervisor_start(supervisor, &status) == OK);
+    assert(Supervisor_watch(supervisor, fast, "LATE", 50, SUPERVISOR_TERMINATE) == -1);
+
+    for (int i = 0; i < 30; i++) {
+        Notifier_notify(fast);
+        Notifier_notify(slow);
+        usleep(10000);
+    }
+
+    assert(status == RUNNING);
+    printf("Beating stages left alone test success...\n");
+
+    start = Scheduler_now();
+
+    while (status == RUNNING && Scheduler_now() - start < 1000000000u) {
+        Notifier_notify(fast);
+        usleep(10000);
+    }
+
+    elapsed = (Scheduler_now() - start) / 1000000u;
+
+    assert(status == TERMINATED);
+    assert(elapsed >= 180 && elapsed < 300);
+    assert(Supervisor_join(supervisor) == OK);
+
+    assert(Supervisor_stats(supervisor, fastStage, &stats) == OK);
+    assert(stats.stalls == 0 && stats.stalled == 0);
+    assert(Supervisor_stats(supervisor, slowStage, &stats) == OK);
+    assert(stats.stalls == 1 && stats.restarts == 0);
+    assert(stats.stalled >= 200000000u && stats.stalled < 300000000u);
+    printf("Stalled stage fired in %lu ms test success...\n", (unsigned long) elapsed);
+
+    Supervisor_destroy(supervisor);
+    Notifier_destroy(fast);
+    Notifier_destroy(slow);
+
+    printf("Supervisor test finished !\n");
+}
+
+/*
+    METHOD: test_supervisor_policies
+    ARGUMENTS: none
+    PURPOSE: testing that an ignored stage has every stall counted once 
+        without terminating status, and that a restarted stage is retried
+        while its old thread is stuck and terminates status once it 
+        runs out of restart attempts
+    RETURN: nothing
+*/
+void test_supervisor_policies(
+    void
+) {
+    Supervisor* supervisor;
+    SupervisorStats stats;
+    Restarted restarted;
+    Notifier* ignored;
+    volatile sig_atomic_t status;
+    char line[128];
+    uint64_t start;
+    FILE* console;
+    bool exhausted;
+    int ignoredStage;
+    int restartedStage;
+
+    printf("Starting supervisor policies test...\n");
+
+    supervisor = Supervisor_init();
+    ignored = Notifier_init();
+    restarted = (Restarted) { .notifier = Notifier_init(), .calls = 0, .pending = 1 };
+    console = tmpfile();
+    assert(supervisor != NULL && ignored != NULL && restarted.notifier != NULL && console != NULL);
+
+    ignoredStage = Supervisor_watch(supervisor, ignored, "IGNORED", 50, SUPERVISOR_IGNORE);
+    restartedStage = Supervisor_watch(supervisor, restarted.notifier, "RESTARTED", 150, SUPERVISOR_RESTART);
+    assert(ignoredStage == 0 && restartedStage == 1);
+
+    status = RUNNING;
+
+    assert(Supervisor_onRestart(supervisor, ignoredStage, restart, &restarted, 20, 3) == ERR_PARAMS);
+    assert(Supervisor_start(supervisor, &status) == ERR_PARAMS);
+    assert(Supervisor_onRestart(supervisor, restartedStage, restart, &restarted, 20, 3) == OK);
+    assert(Supervisor_setConsole(supervisor, console) == OK);
+    assert(Supervisor_start(supervisor, &status) == OK);
+    assert(Supervisor_setConsole(supervisor, NULL) == ERR_RUN);
+
+    // IGNORED STAGE STALLS, BEATS FOR A WHILE AND STALLS AGAIN
+    usleep(150000);
+    assert(status == RUNNING);
+    assert(Supervisor_stats(supervisor, ignoredStage, &stats) == OK);
+    assert(stats.stalls == 1 && stats.stalled >= 50000000u);
+
+    for (int i = 0; i < 10; i++) {
+        Notifier_notify(ignored);
+        usleep(10000);
+    }
+
+    start = Scheduler_now();
+
+    // STUCK ATTEMPT, TWO RESTARTS AND A STALL WITH NO ATTEMPTS LEFT
+    while (status == RUNNING && Scheduler_now() - start < 2000000000u) { usleep(10000); }
+
+    assert(status == TERMINATED);
+    assert(Supervisor_join(supervisor) == OK);
+
+    assert(Supervisor_stats(supervisor, ignoredStage, &stats) == OK);
+    assert(stats.stalls == 2 && stats.restarts == 0);
+    printf("Ignored stage counted twice test success...\n");
+
+    assert(Supervisor_stats(supervisor, restartedStage, &stats) == OK);
+    assert(restarted.calls == 3);
+    assert(stats.restarts == 2 && stats.stalls == 3);
+    printf("Restarted stage ran out of attempts test success...\n");
+
+    exhausted = false;
+    rewind(console);
+
+    while (fgets(line, sizeof(line), console) != NULL) {
+        if (strcmp(line, "[SUPERVISOR]: RESTARTED RESTARTS EXHAUSTED\n") == 0) { exhausted = true; }
+    }
+
+    assert(exhausted);
+    fclose(console);
+    printf("Reports shown on console test success...\n");
+
+    Supervisor_destroy(supervisor);
+    Notifier_destroy(ignored);
+    Notifier_destroy(restarted.notifier);
+
+    printf("Supervisor policies test finished !\n");
+}
@@ -0,0 +1,14 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: supervisor_test.h                       
+    PURPOSE: interface for supervisor test module 
+*/
+
+#ifndef SUPERVISOR_TEST
+#define SUPERVISOR_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_supervisor(void);
+void test_supervisor_policies(void);
+
+#endif
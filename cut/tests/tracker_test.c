@@ -0,0 +1,157 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: tracker_test.c                       
+    PURPOSE: testing tracker module 
+*/
+
+// INCLUDES OF OUTSIDE LIBRARIES
+#include <stdio.h>      
+#include <string.h>      
+#include <assert.h>     
+#include <pthread.h> 
+#include <unistd.h> 
+#include <fcntl.h> 
+#include <time.h> 
+
+// INCLUDES OF INSIDE LIBRARIES
+#include "tracker_test.h"
+#include "alloc_hook.h"
+#include "../inc/tracker.h"
+#include "../inc/enums.h"
+
+// MACRO DEFINITION
+#define SINK_PATH "/tmp/cut_test_tracker_sink"
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+static void* test_tracker_runner(void* const);
+static void test_tracker_mode(int const);
+
+/*
+    METHOD: test_tracker_runner
+    ARGUMENTS:
+        args - a tracker to be run
+    PURPOSE: thread running a tracker until it gets terminated
+    RETURN: nothing
+*/
+static void* test_tracker_runner(
+    void* const args
+) {
+    static int result;
+
+    result = Tracker_start((Tracker*) args);
+
+    return &result;
+}
+
+/*
+    METHOD: test_tracker_mode
+    ARGUMENTS:
+        mode - tracker mode to be tested
+    PURPOSE: testing that a running tracker does not allocate after 
+        warm-up and shuts down within milliseconds, and that a headless 
+        one has no printer, but writes every record to its sink
+    RETURN: nothing
+*/
+static void test_tracker_mode(
+    int const mode
+) {
+    Tracker* tracker;
+    pthread_t thread;
+    struct timespec start;
+    struct timespec end;
+    char lines[4096];
+    void* result;
+    size_t allocations;
+    ssize_t length;
+    long elapsed;
+    int records;
+    int out;
+    int null;
+    int fd;
+
+    tracker = Tracker_init(100, mode);
+    assert(tracker != NULL);
+    assert(test_allocations() > 0);
+
+    if (mode == TRACKER_HEADLESS) {
+        assert(Tracker_setLayout(tracker, PRINTER_BARS) == ERR_PARAMS);
+        assert(Tracker_addSink(tracker, SINK_CSV, SINK_PATH) == OK);
+    }
+
+    fflush(stdout);
+    out = dup(STDOUT_FILENO);
+    null = open("/dev/null", O_WRONLY);
+    dup2(null, STDOUT_FILENO);
+
+    assert(pthread_create(&thread, NULL, test_tracker_runner, tracker) == 0);
+
+    // FIRST SAMPLE IS A BASELINE, SECOND ONE WARMS UP ANALYZER AND PRINTER
+    usleep(300000);
+    allocations = test_allocations();
+    usleep(500000);
+
+    assert(test_allocations() == allocations);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    assert(Tracker_terminate(tracker) == OK);
+    assert(pthread_join(thread, &result) == 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+    close(null);
+
+    elapsed = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+
+    assert(*(int*) result == OK);
+    assert(elapsed < 100);
+    printf("No allocation after warm-up test success...\n");
+    printf("Shutdown in %ld ms test success...\n", elapsed);
+
+    Tracker_destroy(tracker);
+
+    if (mode == TRACKER_HEADLESS) {
+        fd = open(SINK_PATH, O_RDONLY);
+        assert(fd >= 0);
+
+        length = read(fd, lines, sizeof(lines) - 1);
+        assert(length > 0);
+        lines[length] = '\0';
+
+        close(fd);
+        unlink(SINK_PATH);
+
+        // FIRST SAMPLE IS A BASELINE, EVERY LATER ONE OF 800 MS IS A RECORD
+        assert(strncmp(lines, "timestamp,cpu,", 14) == 0);
+
+        records = 0;
+
+        for (char const* line = strstr(lines, ",all,"); line != NULL; line = strstr(line + 1, ",all,")) { records++; }
+
+        assert(records >= 5);
+        printf("Headless records written to sink test success...\n");
+    }
+}
+
+/*
+    METHOD: test_tracker
+    ARGUMENTS: none
+    PURPOSE: testing tracker in threaded, event loop and headless mode
+    RETURN: nothing
+*/
+void test_tracker(
+    void
+) {
+    printf("Starting tracker test...\n");
+
+    assert(Tracker_init(100, TRACKER_HEADLESS + 1) == NULL);
+
+    test_tracker_mode(TRACKER_THREADED);
+    test_tracker_mode(TRACKER_EVENT);
+    test_tracker_mode(TRACKER_HEADLESS);
+
+    printf("Tracker test finished !\n");
+}
@@ -0,0 +1,13 @@
+/*
+    AUTHOR: DENIS STOCKI                  
+    FILE: tracker_test.h                       
+    PURPOSE: interface for tracker test module 
+*/
+
+#ifndef TRACKER_TEST
+#define TRACKER_TEST
+
+// DECLARATIONS OF PROTOTYPE FUNCTIONS
+void test_tracker(void);
+
+#endif 